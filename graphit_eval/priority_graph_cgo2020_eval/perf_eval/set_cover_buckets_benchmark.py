@@ -0,0 +1,48 @@
+#!/usr/bin/python
+# Compares set cover with exact degree buckets against (1+eps) geometric buckets on rMat graphs.
+# Build the binaries first with "make set_cover_buckets_graphit set_cover_buckets".
+# Larger rMat inputs in the Ligra adjacency format can be generated with Ligra's rMatGraph utility,
+# e.g. "rMatGraph -j 1000000 rMatGraph_J_5_1M" (symmetric, as set cover reads the elements of a set as its neighbors)
+import argparse
+import subprocess
+
+BINARIES = [("exact", "./bin/set_cover_exact_buckets"),
+            ("approximate", "./bin/set_cover_approximate_buckets")]
+
+
+def parse_output(output):
+    """ returns the elapsed time, the number of rounds and the cover size printed by apps/set_cover_degree.gt """
+    lines = output.split("\n")
+    values = {}
+    for i in range(len(lines) - 1):
+        if lines[i].strip() in ["elapsed time", "rounds", "cover size"]:
+            values[lines[i].strip()] = lines[i + 1].strip()
+    return float(values["elapsed time"]), int(values["rounds"]), int(values["cover size"])
+
+
+def main():
+    parser = argparse.ArgumentParser(formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+    parser.add_argument('-g', '--graphs', nargs='+', default=["../../../test/graphs/rMatGraph_J_5_100"],
+                        help="rMat graphs in the Ligra adjacency format")
+    parser.add_argument('-t', '--trials', type=int, default=3, help="runs per graph and mode, the fastest is reported")
+    args = parser.parse_args()
+
+    print("graph, mode, time (s), rounds, cover size")
+    for graph in args.graphs:
+        exact_time = None
+        for mode, binary in BINARIES:
+            results = []
+            for trial in range(args.trials):
+                output = subprocess.check_output([binary, graph]).decode()
+                results.append(parse_output(output))
+            time, rounds, cover_size = min(results)
+            line = "{}, {}, {:.6f}, {}, {}".format(graph, mode, time, rounds, cover_size)
+            if exact_time is None:
+                exact_time = time
+            elif time > 0:
+                line += ", speedup {:.2f}x".format(exact_time / time)
+            print(line)
+
+
+if __name__ == "__main__":
+    main()
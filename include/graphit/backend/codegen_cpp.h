@@ -146,6 +146,24 @@ namespace graphit {
         // creates the lambda function to apply the edgeMapCount operator
 	    void get_edge_count_lambda(mir::UpdatePriorityEdgeCountEdgeSetApplyExpr::Ptr call);
         void genTypesRequiringTypeDefs();
+
+        // generates the typedef for a fixed size vector, padded and aligned for SIMD loops when possible
+        void genVectorTypeDef(mir::VectorType::Ptr vector_type);
+
+        // alignment (in bytes) of the rows of a fixed size vector, 0 if the rows are not padded
+        int getVectorTypeAlignment(mir::VectorType::Ptr vector_type);
+
+        int getScalarTypeSize(mir::Type::Ptr type);
+
+        // the OrderedProcessingOperator of the constant sum priority updates, and its edge function
+        void genConstSumOrderedProcessingOperator(mir::OrderedProcessingOperator::Ptr ordered_op);
+        void genConstSumPriorityFunctor(mir::FuncDecl::Ptr func_decl);
+
+        // prints the lambda deciding whether the OrderedProcessingOperator processes a node of its frontier
+        void genOrderedProcessingSourceFilter(mir::OrderedProcessingOperator::Ptr ordered_op);
+
+        // appends the bucketing structure template argument of julienne::PriorityQueue when it is not the default
+        void genBucketBackendTypeArg(mir::Type::Ptr priority_type);
 	
 	    void generatePyBindWrapper(mir::FuncDecl::Ptr);
 
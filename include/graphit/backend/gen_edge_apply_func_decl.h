@@ -52,6 +52,9 @@ namespace graphit {
         void genEdgeApplyFunctionDeclaration(mir::EdgeSetApplyExpr::Ptr apply);
         void genEdgeApplyFunctionDeclBody(mir::EdgeSetApplyExpr::Ptr apply);
 
+        // memory budget (in MB) of the hub bitmaps used by the intersections of the apply function, -1 if it has none
+        int64_t getHubBitmapBudget(mir::EdgeSetApplyExpr::Ptr apply);
+
         void indent() { ++indentLevel; }
         void dedent() { --indentLevel; }
         void printIndent() { oss_ << std::string(2 * indentLevel, ' '); }
@@ -63,6 +66,7 @@ namespace graphit {
         void genEdgePushApplyFunctionDeclBody(mir::EdgeSetApplyExpr::Ptr apply);
         void genEdgeHybridDenseApplyFunctionDeclBody(mir::EdgeSetApplyExpr::Ptr apply);
         void genEdgeHybridDenseForwardApplyFunctionDeclBody(mir::EdgeSetApplyExpr::Ptr apply);
+        void genEdgeCentricApplyFunctionDeclBody(mir::EdgeSetApplyExpr::Ptr apply);
         void setupGlobalVariables(mir::EdgeSetApplyExpr::Ptr apply,
                                   bool apply_expr_gen_frontier,
                                   bool from_vertexset_specified);
@@ -96,6 +100,11 @@ namespace graphit {
                                                                 bool apply_expr_gen_frontier,
                                                                 std::string dst_type);
 
+        void printEdgeCentricEdgeTraversalReturnFrontier(mir::EdgeSetApplyExpr::Ptr apply,
+                                                         bool from_vertexset_specified,
+                                                         bool apply_expr_gen_frontier,
+                                                         std::string dst_type);
+
         //prints the inner loop on in neighbors for pull based direction
         void printPullEdgeTraversalInnerNeighborLoop(mir::EdgeSetApplyExpr::Ptr apply,
                                                      bool from_vertexset_specified,
@@ -103,7 +112,21 @@ namespace graphit {
                                                      std::string dst_type,
                                                      std::string apply_func_name,
                                                      bool cache,
-                                                     bool numa_aware);
+                                                     bool numa_aware,
+                                                     bool split_in_edges = false);
+
+        //prints the loops on the high in-degree destinations for degree bucketed pull
+        void printPullDegreeBucketedHeavyVertices(mir::EdgeSetApplyExpr::Ptr apply,
+                                                  bool from_vertexset_specified,
+                                                  bool apply_expr_gen_frontier,
+                                                  std::string dst_type,
+                                                  std::string apply_func_name);
+
+        //prints the degree bucketed push traversal, the sources are classified by out-degree
+        void printPushDegreeBucketedTraversal(mir::EdgeSetApplyExpr::Ptr apply);
+
+        //prints the loop adding the partials of the split blocks to the high degree vertices
+        void printDegreeBucketedPartialsCombine(mir::EdgeSetApplyExpr::Ptr apply);
 
         void printNumaMerge(mir::EdgeSetApplyExpr::Ptr apply);
 
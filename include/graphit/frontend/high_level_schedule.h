@@ -37,13 +37,15 @@ namespace graphit {
                             {"SparsePush-DensePull", "hybrid_dense"},
                             {"DensePull-SparsePush", "hybrid_dense"},
                             {"DensePush-SparsePush", "hybrid_dense_forward"},
-                            {"SparsePush-DensePush", "hybrid_dense_forward"}
+                            {"SparsePush-DensePush", "hybrid_dense_forward"},
+                            {"EdgeCentric", "edge_centric"}
                     };
 
                     parallelCompatibilityMap_ = {
                             {"dynamic-vertex-parallel", "parallel"},
                             {"static-vertex-parallel", "parallel"},
-                            {"edge-aware-dynamic-vertex-parallel", "parallel"}
+                            {"edge-aware-dynamic-vertex-parallel", "parallel"},
+                            {"degree-bucketed-dynamic-vertex-parallel", "parallel"}
                     };
 
                 }
@@ -93,21 +95,36 @@ namespace graphit {
                 configApplyDirection(std::string apply_label, std::string apply_direction);
 
                 // High level API for specifying which intersection method to use
-                // Currently it supports five intersection methods:
+                // Currently it supports six intersection methods:
                 //   1. MultiSkipIntersection
                 //   2. HiroshiIntersection
                 //   3. NaiveIntersection
                 //   4. BinarySearch
                 //   5. Combination of MultiSkip and Hiroshi
+                //   6. SIMDIntersection (AVX-512 or AVX2 block compare, picked at runtime)
+                //   7. HubBitmapIntersection (bitmap probes for the neighborhoods of the highest degree vertices,
+                //      combined intersection for the others)
                 // If nothing is provided, it uses naive intersection by default
                 high_level_schedule::ProgramScheduleNode::Ptr
                 configIntersection(std::string apply_label, std::string intersection_option);
 
+                // Thresholds for choosing between Hiroshi and MultiSkip in CombinedIntersection and HubBitmapIntersection
+                // (1000 and 0.1 by default)
+                high_level_schedule::ProgramScheduleNode::Ptr
+                configIntersectionCombinedThresholds(std::string apply_label, int size_threshold, double ratio_threshold);
+
+                // Memory budget in MB for the neighbor bitmaps of HubBitmapIntersection and their per vertex lookup (64 by default),
+                // the highest degree vertices get a bitmap as long as they fit
+                high_level_schedule::ProgramScheduleNode::Ptr
+                configIntersectionHubBitmapBudget(std::string apply_label, int budget_mb);
+
 
 
                 // High lvel API for speicifying parallelization scheduling options for apply
                 // A wrapper around setApply for now.
                 // Scheduling Options include VertexParallel, EdgeAwareVertexParallel
+                // degree-bucketed-dynamic-vertex-parallel splits the edges of the vertices with more than grain_size
+                // edges across tasks, in edges for pull and out edges for push (sums into the source are privatized)
                 high_level_schedule::ProgramScheduleNode::Ptr
                 configApplyParallelization(std::string apply_label, std::string apply_schedule, int grain_size=1024, std::string direction = "all");
 
@@ -119,6 +136,14 @@ namespace graphit {
                     return setApply(apply_label, apply_schedule);
                 }
 
+                // High lvel API for fusing the vertexset apply that follows a pull edgeset apply into it
+                // A wrapper around setApply, set on the label of the edgeset apply.
+                // Scheduling Options include enable_apply_fusion (default) and disable_apply_fusion
+                high_level_schedule::ProgramScheduleNode::Ptr
+                configApplyFusion(std::string apply_label, std::string apply_schedule){
+                    return setApply(apply_label, apply_schedule);
+                }
+
 
                 // High lvel API for speicifying Data Structure scheduling options for apply
                 // A wrapper around setApply for now.
@@ -171,6 +196,7 @@ namespace graphit {
                 configApplyPriorityUpdateDelta(std::string apply_label, int delta);
 
                 //configures the delta parameter for delta-stepping
+                // either "argv[i]" or "auto", which picks the delta from the graph and adapts it between rounds
                 high_level_schedule::ProgramScheduleNode::Ptr
                 configApplyPriorityUpdateDelta(std::string apply_label, string delta_argv);
 
@@ -190,8 +216,42 @@ namespace graphit {
                 high_level_schedule::ProgramScheduleNode::Ptr
                 configBucketMergeThreshold(std::string apply_label, string threshold);
 
+                //configures the number of queues per thread used by the relaxed multiqueue priority update
+                // a larger factor lowers contention, but processes nodes further from the priority order
+                high_level_schedule::ProgramScheduleNode::Ptr
+                configRelaxationFactor(std::string apply_label, int relaxation_factor);
+
+                high_level_schedule::ProgramScheduleNode::Ptr
+                configRelaxationFactor(std::string apply_label, string relaxation_factor_argv);
+
+                //configures the bucketing structure of the lazy priority queue
+                // "open_buckets" (default), "radix_heap_buckets" or "two_level_buckets"
+                // the latter two skip empty buckets instead of scanning them, for widely spread priorities
+                high_level_schedule::ProgramScheduleNode::Ptr
+                configBucketBackend(std::string apply_label, std::string bucket_backend);
+
+                //configures the lazy priority queue to bucket priorities in (1+epsilon) geometric buckets
+                // a priority then only moves when it changes by a factor of (1+epsilon), which bounds the
+                // approximation of greedy algorithms such as set cover. 0 (the default) keeps exact buckets.
+                // Selects the open buckets backend, the only one with approximate buckets
+                high_level_schedule::ProgramScheduleNode::Ptr
+                configApplyPriorityUpdateEpsilon(std::string apply_label, float epsilon);
+
+                //configures a vertexset apply that restores per-query vertex properties (e.g. distances to infinity)
+                // to only visit the vertices written since it last ran, and all of them once more than
+                // dense_fraction of the vertices were written
+                high_level_schedule::ProgramScheduleNode::Ptr
+                configApplySparseReset(std::string apply_label, float dense_fraction = 0.05);
+
+                //configures the eager ordered processing to only process the nodes of the frontier that
+                // filter_func (a function from Vertex to bool) selects, e.g. the nodes not peeled yet for k-core.
+                // By default, the nodes moved to a bucket that was processed already are skipped
+                high_level_schedule::ProgramScheduleNode::Ptr
+                configApplySourceFilter(std::string apply_label, std::string filter_func);
+
                 // High lvel API for speicifying scheduling options for apply
-                // Scheduling Options include push, pull, hybrid, enable_deduplication, disable_deduplication, parallel, serial
+                // Scheduling Options include push, pull, hybrid, enable_deduplication, disable_deduplication, parallel, serial,
+                // enable_apply_fusion, disable_apply_fusion
                 high_level_schedule::ProgramScheduleNode::Ptr
                 setApply(std::string apply_label, std::string apply_schedule);
 
@@ -220,6 +280,8 @@ namespace graphit {
                 std::map<string, string> parallelCompatibilityMap_;
 
                 void initGraphIterationSpaceIfNeeded(string label);
+                // creates the default apply schedule of the label if it has none
+                void initApplyScheduleIfNeeded(string apply_label);
                 int extractIntegerFromString(string input_string);
                 int extractArgvNumFromStringArg(string argv_str);
                 ApplySchedule createDefaultSchedule(string apply_label);
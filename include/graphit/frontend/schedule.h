@@ -51,7 +51,9 @@ namespace graphit {
             // partitioning the graph with a fixed number of vertices
                     FixedVertexCount,
             //partitioning the graph with a flexible number of vertices, but similar number of edges
-                    EdgeAwareVertexCount
+                    EdgeAwareVertexCount,
+            //grouping low degree vertices into coarse chunks and splitting the edges of high degree vertices
+                    DegreeBucketedVertexCount
         };
         enum class FT_Tag {
             //Dense Bitvector
@@ -77,8 +79,17 @@ namespace graphit {
             COMBINED,
             BINARY,
             NAIVE,
+            SIMD,
+            HUB_BITMAP,
         };
 
+        // The combined intersection (also used by the hub bitmap intersection when neither set is a hub) uses Hiroshi
+        // when both sets are larger than combined_size_threshold and one of them is larger than
+        // combined_ratio_threshold times the other, multiple skip otherwise
+        int64_t combined_size_threshold = 1000;
+        double combined_ratio_threshold = 0.1;
+        // memory (in MB) for the neighbor bitmaps of the highest degree vertices used by the hub bitmap intersection
+        int64_t hub_bitmap_budget_mb = 64;
     };
 
     struct GraphIterationSpace {
@@ -153,7 +164,9 @@ namespace graphit {
                 PUSH,
                 PULL,
                 HYBRID_DENSE,
-                HYBRID_DENSE_FORWARD
+                HYBRID_DENSE_FORWARD,
+                // iterate over a grid ordered coordinate (COO) edge array instead of the CSR
+                EDGE_CENTRIC
             };
 
             enum class ParType {
@@ -183,16 +196,33 @@ namespace graphit {
 
             enum class PullLoadBalance {
                 VERTEX_BASED,
-                EDGE_BASED
+                EDGE_BASED,
+                // destinations are classified by in-degree, the in edges of high degree ones are split across threads
+                // (push applies over all the vertices classify the sources by out-degree and split their out edges)
+                DEGREE_BUCKETED
             };
 
             enum class PriorityUpdateType {
                 EAGER_PRIORITY_UPDATE,
                 EAGER_PRIORITY_UPDATE_WITH_MERGE,
+                // asynchronous processing with a relaxed concurrent priority queue (MultiQueue)
+                RELAXED_MULTIQUEUE,
                 CONST_SUM_REDUCTION_BEFORE_UPDATE,
+                // constant sum updates counted with a histogram on the GAPBS graph, with thread local bins
+                EAGER_CONST_SUM_REDUCTION_BEFORE_UPDATE,
                 REDUCTION_BEFORE_UPDATE
             };
 
+            // bucketing structure of the lazy (julienne) priority queue
+            enum class BucketBackend {
+                // a window of open buckets and an overflow bucket
+                OPEN_BUCKETS,
+                // monotone radix heap, entries move at most once per key bit
+                RADIX_HEAP,
+                // fine buckets, coarse buckets grouping the following keys and an overflow bucket
+                TWO_LEVEL_BUCKETS
+            };
+
             std::string scope_label_name;
             DirectionType direction_type;
             ParType parallel_type;
@@ -207,10 +237,25 @@ namespace graphit {
             // with the default grain size set to 4096
             int pull_load_balance_edge_grain_size;
             int num_segment;
+            // delta of the priority buckets, negative values refer to argv and 0 selects and adapts it at runtime
             int delta;
             bool numa_aware;
             int merge_threshold;
             int num_open_buckets;
+            // number of queues per thread in the relaxed multiqueue
+            int relaxation_factor;
+            BucketBackend bucket_backend;
+            // a vertexset apply that restores vertex properties only visits the vertices written since its last run
+            bool sparse_reset;
+            // fraction of the vertices past which the sparse reset visits all of them
+            float sparse_reset_dense_fraction;
+            // 0 for exact buckets, > 0 for (1+epsilon) geometric buckets of the lazy priority queue
+            float bucket_epsilon;
+            // fuse the vertexset apply right after a pull edgeset apply into its loop over the destinations
+            bool apply_fusion;
+            // user defined function selecting the nodes of the frontier processed by the ordered processing operator,
+            // empty for the default filter that skips the nodes moved to a processed bucket
+            std::string source_filter_func;
         };
 
         /**
@@ -221,6 +266,7 @@ namespace graphit {
             Schedule() {
                 physical_data_layouts = new std::map<std::string, FieldVectorPhysicalDataLayout>();
                 intersection_schedules = new std::map<std::string, IntersectionSchedule::IntersectionType >();
+                intersection_params = new std::map<std::string, IntersectionSchedule>();
                 apply_schedules = new std::map<std::string, ApplySchedule>();
                 vertexset_data_layout = std::map<std::string, VertexsetPhysicalLayout>();
                 graph_iter_spaces = new std::map<std::string, std::vector<GraphIterationSpace> *>();
@@ -243,6 +289,8 @@ namespace graphit {
             std::map<std::string, VertexsetPhysicalLayout> vertexset_data_layout;
 
             std::map<std::string, IntersectionSchedule::IntersectionType> *intersection_schedules;
+            // thresholds and memory budgets of the intersections, the default ones if a label is not in the map
+            std::map<std::string, IntersectionSchedule> *intersection_params;
 
 
         };
@@ -8,6 +8,7 @@
 #include <graphit/midend/mir_context.h>
 #include <graphit/frontend/schedule.h>
 #include <graphit/midend/mir_rewriter.h>
+#include <set>
 
 namespace graphit {
     class ApplyExprLower {
@@ -37,11 +38,79 @@ namespace graphit {
             virtual void visit(mir::EdgeSetApplyExpr::Ptr edgeset_apply_expr);
             virtual void visit(mir::VertexSetApplyExpr::Ptr vertexset_apply_expr);
 
+            // degree bucketed push over all the sources, with the out edges of high degree sources split if possible
+            void lowerPushDegreeBucketed(mir::PushEdgeSetApplyExpr::Ptr push_apply, ApplySchedule &apply_schedule);
+
+            // adds the copy of the apply function that sums into a partial of the split vertex instead of the
+            // reduce target, returns false if the sums can't be privatized
+            bool addSplitPartialApplyFunc(mir::EdgeSetApplyExpr::Ptr apply, mir::FuncDecl::Ptr apply_func_decl,
+                                          std::string split_vertex_name);
+
 
             Schedule * schedule_;
             MIRContext* mir_context_;
         };
 
+        // checks if the apply function of a degree bucketed pull can process the in edges of a destination in parallel
+        // with atomic updates, used when the updates of the destination can't be summed into partials
+        struct SplitApplyFuncChecker : public mir::MIRVisitor {
+            using mir::MIRVisitor::visit;
+
+            virtual void visit(mir::ReduceStmt::Ptr reduce_stmt);
+            virtual void visit(mir::CompareAndSwapStmt::Ptr cas_stmt);
+            virtual void visit(mir::Call::Ptr call);
+            virtual void visit(mir::PriorityUpdateOperatorMin::Ptr op);
+            virtual void visit(mir::PriorityUpdateOperatorSum::Ptr op);
+
+            bool splittable = true;
+        };
+
+        // checks if the edges of a high degree vertex (the out edges of a source for push, the in edges of a
+        // destination for pull) can be split into blocks that sum into their own partial: the apply function can only
+        // update the split vertex with sums into a single vector, and not write anything else that is not local
+        struct SplitPartialApplyFuncChecker : public mir::MIRVisitor {
+            using mir::MIRVisitor::visit;
+
+            SplitPartialApplyFuncChecker(std::string vertex_name) : vertex_name_(vertex_name) {};
+
+            virtual void visit(mir::VarDecl::Ptr var_decl);
+            virtual void visit(mir::AssignStmt::Ptr assign_stmt);
+            virtual void visit(mir::ReduceStmt::Ptr reduce_stmt);
+            virtual void visit(mir::CompareAndSwapStmt::Ptr cas_stmt);
+            virtual void visit(mir::Call::Ptr call);
+            virtual void visit(mir::PriorityUpdateOperatorMin::Ptr op);
+            virtual void visit(mir::PriorityUpdateOperatorSum::Ptr op);
+            virtual void visit(mir::TensorReadExpr::Ptr tensor_read);
+
+            // the reduce target can't be read other than by the sums, the blocks only see their own partial
+            bool splittable() {
+                return splittable_ && reduce_target != "" && tensor_reads_[reduce_target] == reduce_target_sums_;
+            }
+
+            // the vector indexed by the split vertex and its element type
+            std::string reduce_target = "";
+            mir::Type::Ptr reduce_type = nullptr;
+
+        private:
+            bool splittable_ = true;
+            std::string vertex_name_;
+            std::set<std::string> local_vars_;
+            std::map<std::string, int> tensor_reads_;
+            int reduce_target_sums_ = 0;
+        };
+
+        // replaces the sums into reduce_target[vertex] with sums into the partial
+        struct SplitPartialRewriter : public mir::MIRVisitor {
+            using mir::MIRVisitor::visit;
+
+            SplitPartialRewriter(mir::Var partial) : partial_(partial) {};
+
+            virtual void visit(mir::ReduceStmt::Ptr reduce_stmt);
+
+        private:
+            mir::Var partial_;
+        };
+
     private:
         Schedule *schedule_ = nullptr;
         MIRContext *mir_context_ = nullptr;
@@ -0,0 +1,92 @@
+#ifndef GRAPHIT_APPLY_FUSION_LOWER_H
+#define GRAPHIT_APPLY_FUSION_LOWER_H
+
+#include <graphit/midend/mir_context.h>
+#include <graphit/frontend/schedule.h>
+#include <graphit/midend/mir_visitor.h>
+#include <map>
+#include <set>
+
+namespace graphit {
+
+    /**
+     * Fuses a pull direction edgeset apply with the vertexset apply over all vertices that immediately follows it.
+     * The vertex apply function is called for each destination right after the loop over its in neighbors,
+     * removing one sweep over the vertices and one barrier.
+     * The fusion is only done when the vertex function accesses fields at its own vertex, and the edge function
+     * does not read through the source (or write through the source) any field that the vertex function writes.
+     * The fusion can be turned off with the apply_fusion option of the schedule of the edgeset apply.
+     * A vertexset apply with its own apply schedule is not fused, its statement (and the schedule) would be removed.
+     */
+    class ApplyFusionLower {
+    public:
+        ApplyFusionLower(MIRContext *mir_context, Schedule *schedule)
+                : mir_context_(mir_context), schedule_(schedule) {}
+
+        void lower();
+
+        // Records how every field is accessed in a function, classified by the index used for the access
+        struct FieldAccessCollector : public mir::MIRVisitor {
+            enum IndexRole {
+                SRC,
+                DST,
+                OTHER
+            };
+
+            FieldAccessCollector(MIRContext *mir_context, std::map<std::string, IndexRole> arg_roles)
+                    : mir_context_(mir_context), arg_roles_(arg_roles) {}
+
+            virtual void visit(mir::FuncDecl::Ptr func_decl);
+            virtual void visit(mir::TensorReadExpr::Ptr tensor_read);
+            virtual void visit(mir::TensorArrayReadExpr::Ptr tensor_read);
+            virtual void visit(mir::TensorStructReadExpr::Ptr tensor_read);
+            virtual void visit(mir::AssignStmt::Ptr assign_stmt);
+            virtual void visit(mir::ReduceStmt::Ptr reduce_stmt);
+            virtual void visit(mir::CompareAndSwapStmt::Ptr cas_stmt);
+            virtual void visit(mir::VarDecl::Ptr var_decl);
+            virtual void visit(mir::Call::Ptr call);
+
+            // field name -> roles of the indices it is accessed with
+            std::map<std::string, std::set<IndexRole>> accessed_fields;
+            std::map<std::string, std::set<IndexRole>> written_fields;
+            // writes to variables that are not local to the function
+            bool writes_global_var = false;
+            // calls to user defined or extern functions that are not analyzed
+            bool has_opaque_call = false;
+
+        private:
+            MIRContext *mir_context_;
+            std::map<std::string, IndexRole> arg_roles_;
+            std::set<std::string> local_vars_;
+
+            void recordAccess(mir::TensorReadExpr::Ptr tensor_read);
+            void recordWrite(mir::Expr::Ptr lhs);
+            mir::TensorReadExpr::Ptr getFieldAccess(mir::Expr::Ptr expr);
+            std::string getFieldName(mir::TensorReadExpr::Ptr tensor_read);
+            IndexRole getIndexRole(mir::Expr::Ptr index);
+        };
+
+        struct StmtBlockVisitor : public mir::MIRVisitor {
+            StmtBlockVisitor(MIRContext *mir_context, Schedule *schedule)
+                    : mir_context_(mir_context), schedule_(schedule) {}
+
+            virtual void visit(mir::StmtBlock::Ptr stmt_block);
+
+        private:
+            MIRContext *mir_context_;
+            Schedule *schedule_;
+
+            bool isFusible(mir::PullEdgeSetApplyExpr::Ptr edge_apply, std::string edge_apply_label,
+                           mir::VertexSetApplyExpr::Ptr vertex_apply, std::string vertex_apply_label);
+            bool collectFieldAccesses(std::string func_name,
+                                      std::vector<FieldAccessCollector::IndexRole> roles,
+                                      FieldAccessCollector &collector);
+        };
+
+    private:
+        MIRContext *mir_context_ = nullptr;
+        Schedule *schedule_ = nullptr;
+    };
+}
+
+#endif //GRAPHIT_APPLY_FUSION_LOWER_H
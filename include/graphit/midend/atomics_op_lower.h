@@ -57,6 +57,23 @@ namespace graphit {
 
         };
 
+        // checks that every update on the destination in an apply function is atomic
+        struct DstWritesAtomicChecker : public mir::MIRVisitor {
+            DstWritesAtomicChecker(std::string dst_name) : dst_name_(dst_name) {
+            }
+
+            virtual void visit(mir::AssignStmt::Ptr assign_stmt);
+            virtual void visit(mir::ReduceStmt::Ptr reduce_stmt);
+            virtual void visit(mir::CompareAndSwapStmt::Ptr cas_stmt);
+
+            bool all_atomic = true;
+
+        private:
+            std::string dst_name_;
+
+            bool isIndexedByDst(mir::Expr::Ptr expr);
+        };
+
         void lower();
 
 
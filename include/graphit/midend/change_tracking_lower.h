@@ -8,6 +8,7 @@
 #include <graphit/midend/mir_context.h>
 #include <graphit/frontend/schedule.h>
 #include <graphit/midend/mir_rewriter.h>
+#include <set>
 
 namespace graphit {
 
@@ -66,10 +67,57 @@ namespace graphit {
                                                             std::string tracking_field);
         };
 
+        // Finds the vertexset applies scheduled as sparse resets
+        struct SparseResetApplyVisitor : public mir::MIRVisitor {
+            virtual void visit(mir::VertexSetApplyExpr::Ptr apply_expr);
+
+            std::vector<mir::VertexSetApplyExpr::Ptr> sparse_reset_applies;
+        };
+
+        // Finds the fields that are written in ways that do not name the written vertex
+        // (whole vector assignments, vectors passed to functions, priority updates done by the runtime)
+        struct UntrackedWriteVisitor : public mir::MIRVisitor {
+            UntrackedWriteVisitor(MIRContext *mir_context) : mir_context_(mir_context) {}
+
+            virtual void visit(mir::TensorArrayReadExpr::Ptr tensor_read);
+            virtual void visit(mir::TensorStructReadExpr::Ptr tensor_read);
+            virtual void visit(mir::VarExpr::Ptr var_expr);
+            virtual void visit(mir::ExprStmt::Ptr expr_stmt);
+            virtual void visit(mir::AssignStmt::Ptr assign_stmt);
+            virtual void visit(mir::VarDecl::Ptr var_decl);
+
+            std::set<std::string> untracked_fields;
+
+        private:
+            MIRContext *mir_context_ = nullptr;
+        };
+
+        // Inserts a call recording the written vertex after every write to a field restored by a sparse reset
+        struct TouchedVertexRecordVisitor : public mir::MIRVisitor {
+            TouchedVertexRecordVisitor(MIRContext *mir_context,
+                                       std::map<std::string, std::vector<std::string>> field_to_touched_sets)
+                    : mir_context_(mir_context), field_to_touched_sets_(field_to_touched_sets) {}
+
+            virtual void visit(mir::StmtBlock::Ptr stmt_block);
+
+        private:
+            MIRContext *mir_context_ = nullptr;
+            // the touched vertices sets that record the writes to each field
+            std::map<std::string, std::vector<std::string>> field_to_touched_sets_;
+
+            // (field, written vertex) pairs of the writes done by the stmt itself (not its nested stmt blocks)
+            std::vector<std::pair<std::string, mir::Expr::Ptr>> getWrites(mir::Stmt::Ptr stmt);
+        };
+
     private:
         Schedule *schedule_ = nullptr;
         MIRContext *mir_context_ = nullptr;
 
+        void lowerSparseResets();
+
+        // fields restored by a reset function made of field[v] = constant assignments, empty if it is not one
+        std::vector<std::string> getResetFields(mir::FuncDecl::Ptr reset_func_decl);
+
     };
 }
 
@@ -39,6 +39,23 @@ namespace graphit {
             MIRContext* mir_context_;
         };
 
+        // finds the getNgh results that are only used as operands of intersections,
+        // those can be non-owning views of the neighbor arrays instead of allocated vertexsets
+        struct NeighborViewFinder : public mir::MIRVisitor {
+            using mir::MIRVisitor::visit;
+
+            virtual void visit(mir::VarDecl::Ptr var_decl);
+            virtual void visit(mir::VarExpr::Ptr var_expr);
+            virtual void visit(mir::IntersectionExpr::Ptr intersection_expr);
+
+            // declarations initialized with getNgh on an unweighted edgeset
+            std::map<std::string, mir::VarDecl::Ptr> ngh_decls;
+            std::map<std::string, int> uses;
+            std::map<std::string, int> intersection_uses;
+            // getNgh calls passed directly to intersections
+            std::vector<mir::Call::Ptr> intersection_calls;
+        };
+
 
     private:
         Schedule *schedule_ = nullptr;
@@ -298,10 +298,19 @@ namespace graphit {
             NoPriorityUpdate, //default type
             EagerPriorityUpdate, // GAPBS refactored runtime lib
             EagerPriorityUpdateWithMerge, // GAPBS refactored runtime lib
+            RelaxedMultiQueuePriorityUpdate, // GAPBS refactored runtime lib with a relaxed concurrent priority queue
             ConstSumReduceBeforePriorityUpdate, //Julienne refactored runtime lib
+            EagerConstSumReduceBeforePriorityUpdate, // GAPBS refactored runtime lib, histogram of the constant sums
             ReduceBeforePriorityUpdate, //Julienne refactored runtime lib
 	        ExternPriorityUpdate, // Julienne refactored runtime lib
         };
+
+        // bucketing structure of the Julienne priority queue
+        enum BucketBackendType {
+            OpenBuckets, // default julienne::buckets
+            RadixHeapBuckets,
+            TwoLevelBuckets
+        };
         struct VertexSetType : public Type {
             ElementType::Ptr element;
 
@@ -391,6 +400,10 @@ namespace graphit {
             std::string loopVar;
             ForDomain::Ptr domain;
             StmtBlock::Ptr body;
+            // set by SimdLoopLower when the loop has a constant trip count and independent iterations
+            bool simd_vectorizable = false;
+            // scalar variables summed into across the iterations of a vectorizable loop
+            std::vector<std::string> simd_reduction_vars;
 
             typedef std::shared_ptr<ForStmt> Ptr;
 
@@ -545,6 +558,8 @@ namespace graphit {
             Expr::Ptr initVal;
             //field to keep track of whether the variable needs allocation. Used only for vectors
             bool needs_allocation = true;
+            // getNgh result that is only passed to intersections, declared as a non-owning NeighborView
+            bool neighbor_view = false;
             typedef std::shared_ptr<VarDecl> Ptr;
 
             virtual void accept(MIRVisitor *visitor) {
@@ -806,6 +821,8 @@ namespace graphit {
             Expr::Ptr numB;
             Expr::Ptr reference;
             IntersectionSchedule::IntersectionType intersectionType;
+            // thresholds of the combined intersection and hub bitmap budget
+            IntersectionSchedule intersectionParams;
 
             typedef std::shared_ptr<IntersectionExpr> Ptr;
 
@@ -855,6 +872,11 @@ namespace graphit {
             typedef std::shared_ptr<VertexSetApplyExpr> Ptr;
             //default to parallel
             bool is_parallel = true;
+            // set by the sparse reset schedule
+            bool sparse_reset = false;
+            float sparse_reset_dense_fraction = 0.05;
+            // the set of written vertices the apply iterates over, empty if the apply visits every vertex
+            std::string touched_vertices_name = "";
 
             virtual void accept(MIRVisitor *visitor) {
                 visitor->visit(self<VertexSetApplyExpr>());
@@ -888,6 +910,15 @@ namespace graphit {
             typedef std::shared_ptr<MergeReduceField> Ptr;
         };
 
+        // the vertices written since the last run of a sparse reset vertexset apply
+        struct TouchedVerticesSet {
+            std::string name;
+            ElementType::Ptr element_type;
+            float dense_fraction;
+
+            typedef std::shared_ptr<TouchedVerticesSet> Ptr;
+        };
+
         struct EdgeSetApplyExpr : public ApplyExpr {
             std::string from_func = "";
             std::string to_func = "";
@@ -899,6 +930,19 @@ namespace graphit {
             bool use_pull_edge_based_load_balance = false;
             //hard coded default value for grain size
             int pull_edge_based_load_balance_grain_size = 4096;
+            // classify the destinations by in-degree, vertices with more than the grain size in edges are processed by several threads
+            bool use_pull_degree_bucketed_load_balance = false;
+            // copy of the apply function used on the split edges of high degree vertices: it sums into a partial instead of
+            // split_reduce_target[vertex], or (pull only) updates the destination atomically if split_reduce_target is empty
+            std::string split_apply_func = "";
+            // classify the sources by out-degree, the out edges of sources with more than the grain size are split
+            bool use_push_degree_bucketed_load_balance = false;
+            // vector the partials of the split edges of a high degree vertex are added to
+            std::string split_reduce_target = "";
+            // traverse a grid ordered COO edge array (only used with push edgeset apply)
+            bool use_edge_centric_traversal = false;
+            // vertex apply function called on each destination once its in edges are processed (pull only)
+            std::string fused_vertex_apply_func = "";
             std::string scope_label_name;
             MergeReduceField::Ptr merge_reduce;
 
@@ -1498,6 +1542,16 @@ namespace graphit {
             //the threshold used for merging buckets
             int merge_threshold = 0;
 
+            //number of queues per thread for the relaxed multiqueue (negative values index argv)
+            int relaxation_factor = 2;
+
+            //statements of the loop that accumulate the size of the frontier, the size is read from frontier_size_var
+            std::vector<Stmt::Ptr> frontier_size_stmts;
+            std::string frontier_size_var;
+
+            //user defined function deciding whether a node of the frontier is processed, empty for the default filter
+            std::string source_filter_func;
+
             typedef std::shared_ptr<OrderedProcessingOperator> Ptr;
 
             OrderedProcessingOperator() {}
@@ -402,15 +402,26 @@ namespace graphit {
 
         int delta_ = 1;
         int bucket_merge_threshold_ = 0;
+        int relaxation_factor_ = 2;
         int num_open_buckets = 128;
+        mir::BucketBackendType bucket_backend_type = mir::BucketBackendType::OpenBuckets;
+        // > 0 for (1+epsilon) geometric buckets
+        float bucket_epsilon_ = 0;
         bool nodes_init_in_buckets = false; // wether the nodes are initialized with values and inserted in buckets
         mir::Expr::Ptr optional_starting_source_node = nullptr;
         std::string eager_priority_update_edge_function_name = "";
+        // user defined filter of the nodes of the frontier of the OrderedProcessingOperator, empty for the default one
+        std::string ordered_processing_source_filter_func = "";
+        // partial sum argument (passed by reference) of the split apply functions of degree bucketed applies
+        std::map<std::string, mir::Var> split_partial_args;
 
 
         // used by numa optimization
         std::map<std::string, std::map<std::string, mir::MergeReduceField::Ptr>> edgeset_to_label_to_merge_reduce;
 
+        // used by the sparse reset of vertex properties, one set for each sparse reset vertexset apply
+        std::vector<mir::TouchedVerticesSet::Ptr> touched_vertices_sets;
+
         std::set<std::string> defined_types;
 
         std::vector<mir::Type::Ptr> types_requiring_typedef;
@@ -119,6 +119,9 @@ namespace graphit {
 
             bool checkWhileStmtPattern(mir::WhileStmt::Ptr while_stmt);
 
+            // statements following the frontier declaration that add up the frontier size (constant sum only)
+            std::vector<mir::Stmt::Ptr> getFrontierSizeStmts(mir::WhileStmt::Ptr while_stmt);
+
             Schedule *schedule_;
             MIRContext *mir_context_;
 
@@ -0,0 +1,44 @@
+#ifndef GRAPHIT_SIMD_LOOP_LOWER_H
+#define GRAPHIT_SIMD_LOOP_LOWER_H
+
+#include <graphit/midend/mir_context.h>
+#include <graphit/midend/mir_visitor.h>
+#include <set>
+
+namespace graphit {
+
+    /**
+     * Marks the for loops over the elements of fixed size vector properties (e.g. latent_vec[v][i] for i in 0:K)
+     * that can be generated as SIMD loops.
+     * A loop is marked when its bounds are compile time constants, its body only contains assignments and
+     * sum reductions of arithmetic expressions, every field it writes is only accessed at the loop index,
+     * and the only scalars it writes are sum reduction variables (e.g. a dot product).
+     */
+    class SimdLoopLower {
+    public:
+        SimdLoopLower(MIRContext *mir_context) : mir_context_(mir_context) {}
+
+        void lower();
+
+        struct ForStmtVisitor : public mir::MIRVisitor {
+            ForStmtVisitor(MIRContext *mir_context) : mir_context_(mir_context) {}
+
+            virtual void visit(mir::ForStmt::Ptr for_stmt);
+
+        private:
+            MIRContext *mir_context_;
+
+            bool isConstantBound(mir::Expr::Ptr bound);
+            bool isArithmeticExpr(mir::Expr::Ptr expr);
+            bool isIndexedByLoopVar(mir::Expr::Ptr expr, std::string loop_var);
+            std::string getFieldName(mir::Expr::Ptr expr);
+            void collectReads(mir::Expr::Ptr expr, std::vector<mir::Expr::Ptr> &tensor_reads,
+                              std::set<std::string> &scalar_reads);
+        };
+
+    private:
+        MIRContext *mir_context_ = nullptr;
+    };
+}
+
+#endif //GRAPHIT_SIMD_LOOP_LOWER_H
@@ -49,6 +49,11 @@ namespace graphit {
             }
         }
 
+        // Generate global declarations for the vertices written since the last run of each sparse reset
+        for (auto touched_vertices_set : mir_context_->touched_vertices_sets) {
+            oss << "TouchedVertices * " << touched_vertices_set->name << ";" << std::endl;
+        }
+
         //Generates function declarations for various edgeset apply operations with different schedules
         // TODO: actually complete the generation, fow now we will use libraries to test a few schedules
         auto gen_edge_apply_function_visitor = EdgesetApplyFunctionDeclGenerator(mir_context_, oss);
@@ -109,6 +114,18 @@ namespace graphit {
         printIndent();
         auto for_domain = for_stmt->domain;
         auto loop_var = for_stmt->loopVar;
+        if (for_stmt->simd_vectorizable) {
+            oss << "#pragma omp simd";
+            if (!for_stmt->simd_reduction_vars.empty()) {
+                oss << " reduction(+:";
+                for (size_t i = 0; i < for_stmt->simd_reduction_vars.size(); i++) {
+                    oss << (i == 0 ? "" : ", ") << for_stmt->simd_reduction_vars[i];
+                }
+                oss << ")";
+            }
+            oss << std::endl;
+            printIndent();
+        }
         oss << "for ( int " << loop_var << " = ";
         for_domain->lower->accept(this);
         oss << "; " << loop_var << " < ";
@@ -413,7 +430,10 @@ namespace graphit {
             //we probably don't need the modifiers now
             //oss << var_decl->modifier << ' ';
 
-            var_decl->type->accept(this);
+            if (var_decl->neighbor_view)
+                oss << "NeighborView ";
+            else
+                var_decl->type->accept(this);
             oss << var_decl->name << " ";
             if (var_decl->initVal != nullptr) {
                 oss << "= ";
@@ -451,6 +471,12 @@ namespace graphit {
             return;
         }
 
+        if (mir_context_->priority_update_type == mir::PriorityUpdateType::EagerConstSumReduceBeforePriorityUpdate
+            && mir_context_->eager_priority_update_edge_function_name == func_decl->name) {
+            genConstSumPriorityFunctor(func_decl);
+            return;
+        }
+
         // Generate function signature
         if (func_decl->name == "main") {
             func_decl->isFunctor = false;
@@ -486,7 +512,19 @@ namespace graphit {
 
                 // if this is a priority update edge function for EagerPriorityUpdate with and without merge
                 // Then we need to insert an extra argument local bins
-                oss << "vector<vector<NodeID>>& local_bins, ";
+                if (mir_context_->priority_update_type == mir::PriorityUpdateType::RelaxedMultiQueuePriorityUpdate) {
+                    // the relaxed multiqueue collects (bin, node) pairs in a flat buffer
+                    oss << "vector<pair<size_t, NodeID> >& local_bins, ";
+                } else {
+                    oss << "ThreadLocalBins& local_bins, ";
+                }
+            }
+
+            if (mir_context_->split_partial_args.find(func_decl->name) != mir_context_->split_partial_args.end()) {
+                // the split version of an apply function sums into a partial of the split vertex passed by reference
+                auto partial = mir_context_->split_partial_args[func_decl->name];
+                partial.getType()->accept(this);
+                oss << "& " << partial.getName() << ", ";
             }
 
             bool printDelimiter = false;
@@ -570,6 +608,13 @@ namespace graphit {
                 }
             }
 
+            // every vertex is touched until the first sparse reset, the initial values are not the restored ones
+            for (auto touched_vertices_set : mir_context_->touched_vertices_sets) {
+                oss << "  " << touched_vertices_set->name << " = new TouchedVertices(";
+                mir_context_->getElementCount(touched_vertices_set->element_type)->accept(this);
+                oss << ", " << touched_vertices_set->dense_fraction << ", true);" << std::endl;
+            }
+
             // the stmts that initializes the field vectors
             for (auto stmt : mir_context_->field_vector_init_stmts) {
                 stmt->accept(this);
@@ -667,6 +712,63 @@ namespace graphit {
 		generatePyBindWrapper(func_decl);
 	}
     };
+    // the edge function of the constant sum operator gives the new priority of dst once count sources were processed
+    void CodeGenCPP::genConstSumPriorityFunctor(mir::FuncDecl::Ptr func_decl) {
+        auto priority_type = mir::to<mir::PriorityQueueType>(mir_context_->getPriorityQueueDecl()->type)->priority_type;
+        auto stmts = func_decl->body->stmts;
+        mir::Call::Ptr update_call = nullptr;
+        if (stmts != nullptr && !stmts->empty() && func_decl->args.size() == 2 && mir::isa<mir::ExprStmt>(stmts->back())
+            && mir::isa<mir::Call>(mir::to<mir::ExprStmt>(stmts->back())->expr)) {
+            update_call = mir::to<mir::Call>(mir::to<mir::ExprStmt>(stmts->back())->expr);
+        }
+        if (update_call == nullptr || update_call->name != "updatePrioritySum" || update_call->args.size() < 3) {
+            std::cout << "Error: the constant sum priority update needs to end with updatePrioritySum" << std::endl;
+            exit(0);
+        }
+
+        func_decl->isFunctor = true;
+        oss << "struct " << func_decl->name << std::endl;
+        printBeginIndent();
+        indent();
+        printIndent();
+        priority_type->accept(this);
+        oss << "operator() (NodeID " << func_decl->args[1].getName() << ", ";
+        priority_type->accept(this);
+        oss << "__count) " << std::endl;
+        printBeginIndent();
+        indent();
+        for (auto stmt = stmts->begin(); stmt != stmts->end() - 1; stmt++) {
+            (*stmt)->accept(this);
+        }
+        printIndent();
+        oss << "return ";
+        if (update_call->args.size() > 3) {
+            oss << "std::max((";
+            priority_type->accept(this);
+            oss << ")(";
+        }
+        update_call->args[0]->accept(this);
+        oss << "->priorities_[";
+        update_call->args[1]->accept(this);
+        oss << "] + ";
+        update_call->args[2]->accept(this);
+        oss << " * __count";
+        if (update_call->args.size() > 3) {
+            oss << "), (";
+            priority_type->accept(this);
+            oss << ")(";
+            update_call->args[3]->accept(this);
+            oss << "))";
+        }
+        oss << ";" << std::endl;
+        dedent();
+        printEndIndent();
+        oss << ";" << std::endl;
+        dedent();
+        printEndIndent();
+        oss << ";" << std::endl;
+    }
+
     void CodeGenCPP::generatePyBindWrapper(mir::FuncDecl::Ptr func_decl) {
 	    oss << "#ifdef GEN_PYBIND_WRAPPERS" << std::endl;
 	    oss << "//PyBind Wrappers for function" << func_decl->name << std::endl;
@@ -1235,16 +1337,9 @@ namespace graphit {
 
 
             //std::string typedef_name = "defined_type_" + mir_context_->getUniqueNameCounterString();
+            //first generates a typedef for the vector type
+            genVectorTypeDef(vector_vector_element_type);
             std::string typedef_name = vector_vector_element_type->toString();
-            if (mir_context_->defined_types.find(typedef_name) == mir_context_->defined_types.end()){
-                mir_context_->defined_types.insert(typedef_name);
-                //first generates a typedef for the vector type
-                oss << "typedef ";
-                vector_vector_element_type->vector_element_type->accept(this);
-                oss << typedef_name <<  " ";
-                oss << "[ " << range << "]; " << std::endl;
-            }
-
             vector_vector_element_type->typedef_name_ = typedef_name;
 
 
@@ -1278,6 +1373,19 @@ namespace graphit {
         oss << " ); " << std::endl;
          **/
 
+        if (mir::isa<mir::VectorType>(vector_element_type)
+            && getVectorTypeAlignment(mir::to<mir::VectorType>(vector_element_type)) != 0) {
+            // operator new does not honor the alignment of the padded rows
+            auto vector_type_vector_element_type = mir::to<mir::VectorType>(vector_element_type);
+            assert(vector_type_vector_element_type->typedef_name_ != "");
+            auto typedef_name = vector_type_vector_element_type->typedef_name_;
+            oss << " = (" << typedef_name << " *) aligned_alloc("
+                << getVectorTypeAlignment(vector_type_vector_element_type) << ", sizeof(" << typedef_name << ") * (";
+            size_expr->accept(this);
+            oss << "));" << std::endl;
+            return;
+        }
+
         oss << " = new ";
 
         if (mir::isa<mir::VectorType>(vector_element_type)) {
@@ -1376,6 +1484,13 @@ namespace graphit {
             assert(associated_element_type);
             auto associated_element_type_size = mir_context_->getElementCount(associated_element_type);
             assert(associated_element_type_size);
+            if (apply_expr->touched_vertices_name != "") {
+                // sparse reset, only visits the vertices written since the last reset
+                // (the reset functions are never extern functions)
+                oss << "builtin_touchedVertexSetApply(" << apply_expr->touched_vertices_name << ", ";
+                oss << apply_expr->input_function_name << "())";
+                return;
+            }
             if (apply_expr->is_parallel) {
                 oss << "ligra::parallel_for_lambda((int)0, (int)";
                 associated_element_type_size->accept(this);
@@ -1615,6 +1730,20 @@ namespace graphit {
             arguments.push_back(genFuncNameAsArgumentString(apply_expr->push_function_));
         }
 
+        // the apply function used on the split edges of high degree vertices
+        if (apply->split_apply_func != "") {
+            arguments.push_back(genFuncNameAsArgumentString(apply->split_apply_func));
+            // the vector the partials of the split edges are added to
+            if (apply->split_reduce_target != "") {
+                arguments.push_back(apply->split_reduce_target);
+            }
+        }
+
+        // the vertex apply function fused into a pull edgeset apply
+        if (apply->fused_vertex_apply_func != "") {
+            arguments.push_back(genFuncNameAsArgumentString(apply->fused_vertex_apply_func));
+        }
+
         // the edgeset that is being applied over (target)
         apply->target->accept(this);
         for (auto &arg : arguments) {
@@ -1643,6 +1772,14 @@ namespace graphit {
             oss << "binarySearchIntersection(";
         }
 
+        else if(intersection_exp->intersectionType == IntersectionSchedule::IntersectionType::SIMD) {
+            oss << "simdVertexIntersection(";
+        }
+
+        else if(intersection_exp->intersectionType == IntersectionSchedule::IntersectionType::HUB_BITMAP) {
+            oss << "hubBitmapVertexIntersection(";
+        }
+
         else {
             oss << "naiveVertexIntersection(";
         }
@@ -1659,6 +1796,14 @@ namespace graphit {
             oss << ", ";
             intersection_exp->reference->accept(this);
         }
+        // the thresholds follow the reference, which then has to be given
+        if (intersection_exp->intersectionType == IntersectionSchedule::IntersectionType::COMBINED
+                || intersection_exp->intersectionType == IntersectionSchedule::IntersectionType::HUB_BITMAP) {
+            if (intersection_exp->reference == nullptr)
+                oss << ", (NodeID)INT32_MAX";
+            oss << ", " << intersection_exp->intersectionParams.combined_size_threshold
+                << ", " << intersection_exp->intersectionParams.combined_ratio_threshold;
+        }
         oss << ") ";
 
     }
@@ -1721,24 +1866,85 @@ namespace graphit {
 
         for (mir::Type::Ptr type : mir_context_->types_requiring_typedef){
             if(mir::isa<mir::VectorType>(type)){
-                auto vector_type = mir::to<mir::VectorType>(type);
-                int range = vector_type->range_indexset;
-                std::string typedef_name = vector_type->toString();
-                if (mir_context_->defined_types.find(typedef_name) == mir_context_->defined_types.end()){
-                    mir_context_->defined_types.insert(typedef_name);
-                    //first generates a typedef for the vector type
-                    oss << "typedef ";
-                    vector_type->vector_element_type->accept(this);
-                    oss << typedef_name <<  " ";
-                    oss << "[ " << range << "]; " << std::endl;
-                }
+                genVectorTypeDef(mir::to<mir::VectorType>(type));
             }
         }
     }
 
+    void CodeGenCPP::genVectorTypeDef(mir::VectorType::Ptr vector_type) {
+        std::string typedef_name = vector_type->toString();
+        if (mir_context_->defined_types.find(typedef_name) != mir_context_->defined_types.end())
+            return;
+        mir_context_->defined_types.insert(typedef_name);
+
+        int alignment = getVectorTypeAlignment(vector_type);
+        oss << "typedef ";
+        vector_type->vector_element_type->accept(this);
+        oss << typedef_name <<  " ";
+        if (alignment == 0) {
+            oss << "[ " << vector_type->range_indexset << "]; " << std::endl;
+        } else {
+            // pads the row to a multiple of the alignment so that consecutive rows stay aligned
+            int element_size = getScalarTypeSize(vector_type->vector_element_type);
+            int row_size = vector_type->range_indexset * element_size;
+            oss << "[ " << (row_size + alignment - 1) / alignment * alignment / element_size << "] ";
+            oss << "__attribute__((aligned(" << alignment << "))); " << std::endl;
+        }
+    }
+
+    int CodeGenCPP::getVectorTypeAlignment(mir::VectorType::Ptr vector_type) {
+        // exported functions receive numpy arrays with densely packed rows
+        for (auto func_decl : mir_context_->getFunctionList()) {
+            if (func_decl->type == mir::FuncDecl::Type::EXPORTED)
+                return 0;
+        }
+
+        // rows too short for a vector register are left as they are
+        int row_size = vector_type->range_indexset * getScalarTypeSize(vector_type->vector_element_type);
+        if (row_size < 16)
+            return 0;
+
+        // a row starts at a cache line, or at a power of two boundary within a cache line for short rows
+        int alignment = 16;
+        while (alignment < row_size && alignment < 64)
+            alignment *= 2;
+        return alignment;
+    }
+
+    int CodeGenCPP::getScalarTypeSize(mir::Type::Ptr type) {
+        if (!mir::isa<mir::ScalarType>(type))
+            return 0;
+        switch (mir::to<mir::ScalarType>(type)->type) {
+            case mir::ScalarType::Type::INT:
+            case mir::ScalarType::Type::UINT:
+            case mir::ScalarType::Type::FLOAT:
+                return 4;
+            case mir::ScalarType::Type::UINT_64:
+            case mir::ScalarType::Type::DOUBLE:
+                return 8;
+            default:
+                return 0;
+        }
+    }
+
+    // the bucketing structure of julienne::PriorityQueue, nothing is printed for the default julienne::buckets
+    void CodeGenCPP::genBucketBackendTypeArg(mir::Type::Ptr priority_type) {
+        if (mir_context_->bucket_backend_type == mir::BucketBackendType::RadixHeapBuckets) {
+            oss << ", julienne::radix_heap_buckets < ";
+        } else if (mir_context_->bucket_backend_type == mir::BucketBackendType::TwoLevelBuckets) {
+            oss << ", julienne::two_level_buckets < ";
+        } else {
+            return;
+        }
+        priority_type->accept(this);
+        oss << " > ";
+    }
+
     void CodeGenCPP::visit(mir::PriorityQueueType::Ptr priority_queue_type) {
         if (priority_queue_type->priority_update_type == mir::PriorityUpdateType::EagerPriorityUpdate
-            || priority_queue_type->priority_update_type == mir::PriorityUpdateType::EagerPriorityUpdateWithMerge) {
+            || priority_queue_type->priority_update_type == mir::PriorityUpdateType::EagerPriorityUpdateWithMerge
+            || priority_queue_type->priority_update_type == mir::PriorityUpdateType::EagerConstSumReduceBeforePriorityUpdate
+            || priority_queue_type->priority_update_type == mir::PriorityUpdateType::RelaxedMultiQueuePriorityUpdate) {
 
             oss << "EagerPriorityQueue < ";
             priority_queue_type->priority_type->accept(this);
@@ -1749,6 +1955,7 @@ namespace graphit {
         || priority_queue_type->priority_update_type == mir::PriorityUpdateType::ReduceBeforePriorityUpdate) { // Add rest of the cases here as required
             oss << "julienne::PriorityQueue < ";
 	    priority_queue_type->priority_type->accept(this);
+            genBucketBackendTypeArg(priority_queue_type->priority_type);
 	    oss << " >* ";
 	} else {
            std::cout << "PriorityQueue type not supported yet" << std::endl;
@@ -1759,7 +1966,11 @@ namespace graphit {
 
         if (priority_queue_alloc_expr->priority_update_type == mir::PriorityUpdateType::EagerPriorityUpdate
             ||
-            priority_queue_alloc_expr->priority_update_type == mir::PriorityUpdateType::EagerPriorityUpdateWithMerge) {
+            priority_queue_alloc_expr->priority_update_type == mir::PriorityUpdateType::EagerPriorityUpdateWithMerge
+            ||
+            priority_queue_alloc_expr->priority_update_type == mir::PriorityUpdateType::EagerConstSumReduceBeforePriorityUpdate
+            ||
+            priority_queue_alloc_expr->priority_update_type == mir::PriorityUpdateType::RelaxedMultiQueuePriorityUpdate) {
 
 
             oss << "new EagerPriorityQueue <";
@@ -1770,9 +1981,24 @@ namespace graphit {
 
             if (priority_queue_alloc_expr->delta < 0 ){
                 oss << ", stoi(argv[" << -1*priority_queue_alloc_expr->delta << "])";
+            } else if (priority_queue_alloc_expr->delta == 0) {
+                // delta is picked from the graph and adapted between rounds
+                oss << ", SelectInitialDelta(" << mir_context_->getEdgeSets()[0]->name << "), true";
             } else {
                 oss << ", " << priority_queue_alloc_expr->delta;
             }
+
+            // number of open thread local bins
+            if (mir_context_->num_open_buckets != 128) {
+                if (priority_queue_alloc_expr->delta != 0) {
+                    oss << ", false";
+                }
+                if (mir_context_->num_open_buckets < 0) {
+                    oss << ", stoi(argv[" << -1*mir_context_->num_open_buckets << "])";
+                } else {
+                    oss << ", " << mir_context_->num_open_buckets;
+                }
+            }
             oss << "); ";
 
         } else if (priority_queue_alloc_expr->priority_update_type == mir::PriorityUpdateType::ExternPriorityUpdate
@@ -1781,6 +2007,7 @@ namespace graphit {
 
             oss << "new julienne::PriorityQueue <";
             priority_queue_alloc_expr->priority_type->accept(this);
+            genBucketBackendTypeArg(priority_queue_alloc_expr->priority_type);
             oss << " > ( ";
 
             oss << mir_context_->getEdgeSets()[0]->name;
@@ -1812,9 +2039,14 @@ namespace graphit {
 
             if (mir_context_->delta_ < 0){
                 oss << ", stoi(argv[" << -1*mir_context_->delta_ << "]) ";
+            } else if (mir_context_->delta_ == 0) {
+                // the buckets are laid out at construction, so only the initial delta is picked from the graph
+                oss << ", SelectInitialDelta(" << mir_context_->getEdgeSets()[0]->name << ")";
             } else {
                 if (mir_context_->delta_ != 1){
                     oss << ", " << mir_context_->delta_;
+                } else if (mir_context_->bucket_epsilon_ > 0) {
+                    oss << ", 1, " << mir_context_->bucket_epsilon_;
                 }
             }
 
@@ -1835,6 +2067,11 @@ namespace graphit {
             oss << "OrderedProcessingOperatorNoMerge(";
         } else if (ordered_op->priority_udpate_type == mir::PriorityUpdateType::EagerPriorityUpdateWithMerge){
             oss << "OrderedProcessingOperatorWithMerge(";
+        } else if (ordered_op->priority_udpate_type == mir::PriorityUpdateType::RelaxedMultiQueuePriorityUpdate){
+            oss << "OrderedProcessingOperatorRelaxedMultiQueue(";
+        } else if (ordered_op->priority_udpate_type == mir::PriorityUpdateType::EagerConstSumReduceBeforePriorityUpdate){
+            genConstSumOrderedProcessingOperator(ordered_op);
+            return;
         } else {
             std::cout << "Error: Unsupported Schedule for OrderedProcessingOperator" << std::endl;
         }
@@ -1851,6 +2088,10 @@ namespace graphit {
         // augmented with local_bins argument,
         oss << ordered_op->edge_update_func  << "(), ";
 
+        //lambda function filtering the nodes of the frontier
+        genOrderedProcessingSourceFilter(ordered_op);
+        oss << ", ";
+
 
         // supply the merge threshold argument for EagerPriorityUpdateWithMerge schedule
         if (ordered_op->priority_udpate_type == mir::PriorityUpdateType::EagerPriorityUpdateWithMerge){
@@ -1862,15 +2103,68 @@ namespace graphit {
             }
         }
 
-        ordered_op->optional_source_node->accept(this);
+        // supply the number of queues per thread for the RelaxedMultiQueuePriorityUpdate schedule
+        if (ordered_op->priority_udpate_type == mir::PriorityUpdateType::RelaxedMultiQueuePriorityUpdate){
+
+            if (ordered_op->relaxation_factor < 0){
+                oss << " stoi(argv[" << -1*ordered_op->relaxation_factor << "]), ";
+            } else {
+                oss << ordered_op->relaxation_factor << ", ";
+            }
+        }
+
+        // without a source node, the operator starts from all the nodes that have a priority
+        if (ordered_op->optional_source_node != nullptr) {
+            ordered_op->optional_source_node->accept(this);
+        } else {
+            oss << "-1";
+        }
 
         oss << ");" << std::endl;
     }
 
+    void CodeGenCPP::genConstSumOrderedProcessingOperator(mir::OrderedProcessingOperator::Ptr ordered_op) {
+        oss << "OrderedProcessingOperatorConstSum(" << ordered_op->priority_queue_name << ", ";
+        ordered_op->graph_name->accept(this);
+        oss << ", [&]()->bool{return (";
+        ordered_op->while_cond_expr->accept(this);
+        oss << ");}, " << ordered_op->edge_update_func << "(), ";
+
+        // the statements counting the frontier run with the number of nodes processed by each step
+        oss << "[&](size_t " << ordered_op->frontier_size_var << "){" << std::endl;
+        indent();
+        for (auto stmt : ordered_op->frontier_size_stmts) {
+            stmt->accept(this);
+        }
+        dedent();
+        printIndent();
+        oss << "}, ";
+
+        if (ordered_op->bucket_merge_threshold < 0){
+            oss << "stoi(argv[" << -1*ordered_op->bucket_merge_threshold << "])";
+        } else {
+            oss << ordered_op->bucket_merge_threshold;
+        }
+        oss << ");" << std::endl;
+    }
+
+    // the user defined filter of the schedule, if any. By default, a node of the frontier is skipped once its
+    // priority was improved into a bucket that was processed already
+    void CodeGenCPP::genOrderedProcessingSourceFilter(mir::OrderedProcessingOperator::Ptr ordered_op) {
+        if (ordered_op->source_filter_func != "") {
+            oss << ordered_op->source_filter_func << "()";
+            return;
+        }
+        const std::string pq = ordered_op->priority_queue_name;
+        oss << "[&](NodeID __u)->bool{return " << pq << "->priorities_[__u] >= "
+            << pq << "->delta_*" << pq << "->get_current_priority();}";
+    }
+
     void CodeGenCPP::visit(mir::PriorityUpdateOperatorMin::Ptr priority_update_op) {
 
         if (mir_context_->priority_update_type == mir::EagerPriorityUpdate
-        || mir_context_->priority_update_type == mir::EagerPriorityUpdateWithMerge){
+        || mir_context_->priority_update_type == mir::EagerPriorityUpdateWithMerge
+        || mir_context_->priority_update_type == mir::RelaxedMultiQueuePriorityUpdate){
             oss << priority_update_op->name;
 
 
@@ -1889,7 +2183,8 @@ namespace graphit {
 
 
             if(mir_context_->priority_update_type == mir::PriorityUpdateType::EagerPriorityUpdateWithMerge ||
-               mir_context_->priority_update_type ==  mir::PriorityUpdateType::EagerPriorityUpdate){
+               mir_context_->priority_update_type ==  mir::PriorityUpdateType::EagerPriorityUpdate ||
+               mir_context_->priority_update_type ==  mir::PriorityUpdateType::RelaxedMultiQueuePriorityUpdate){
                 // if this is a priority update edge function for EagerPriorityUpdate with and without merge
                 // Then we need to insert an extra argument local bins
                 oss << "local_bins, ";
@@ -2004,6 +2299,8 @@ namespace graphit {
             oss << update_call->nodes_init_in_bucket << ", ";
             if (update_call->delta > 0){
                 oss << update_call->delta;
+            } else if (update_call->delta == 0){
+                oss << update_call->priority_queue_name << "->delta_";
             } else {
                 oss << "stoi(argv[" << -1*update_call->delta << "])";
             }
@@ -35,18 +35,46 @@ namespace graphit {
 
         genEdgeApplyFunctionSignature(apply);
         oss_ << "{ " << endl; //the end of the function declaration
+        int64_t hub_bitmap_budget = getHubBitmapBudget(apply);
+        if (hub_bitmap_budget >= 0)
+            oss_ << "    g.SetUpHubBitmaps((int64_t)" << hub_bitmap_budget << " << 20);\n";
         genEdgeApplyFunctionDeclBody(apply);
         oss_ << "} //end of edgeset apply function " << endl; //the end of the function declaration
 
     }
 
+    // largest budget of the hub bitmap intersections in a function
+    struct HubBitmapIntersectionFinder : public mir::MIRVisitor {
+        using mir::MIRVisitor::visit;
+
+        virtual void visit(mir::IntersectionExpr::Ptr intersection_expr) {
+            if (intersection_expr->intersectionType == IntersectionSchedule::IntersectionType::HUB_BITMAP)
+                budget = std::max(budget, intersection_expr->intersectionParams.hub_bitmap_budget_mb);
+            mir::MIRVisitor::visit(intersection_expr);
+        }
+
+        int64_t budget = -1;
+    };
+
+    int64_t EdgesetApplyFunctionDeclGenerator::getHubBitmapBudget(mir::EdgeSetApplyExpr::Ptr apply) {
+        // the neighbors of a weighted edgeset are not intersected through views
+        if (apply->is_weighted)
+            return -1;
+        HubBitmapIntersectionFinder finder;
+        mir_context_->getFunction(apply->input_function_name)->accept(&finder);
+        return finder.budget;
+    }
+
     void EdgesetApplyFunctionDeclGenerator::genEdgeApplyFunctionDeclBody(mir::EdgeSetApplyExpr::Ptr apply) {
         if (mir::isa<mir::PullEdgeSetApplyExpr>(apply)) {
             genEdgePullApplyFunctionDeclBody(apply);
         }
 
         if (mir::isa<mir::PushEdgeSetApplyExpr>(apply)) {
-            genEdgePushApplyFunctionDeclBody(apply);
+            if (apply->use_edge_centric_traversal)
+                genEdgeCentricApplyFunctionDeclBody(apply);
+            else
+                genEdgePushApplyFunctionDeclBody(apply);
         }
 
         if (mir::isa<mir::HybridDenseEdgeSetApplyExpr>(apply)) {
@@ -358,7 +386,8 @@ namespace graphit {
             std::string dst_type,
             std::string apply_func_name,
             bool cache_aware,
-            bool numa_aware) {
+            bool numa_aware,
+            bool split_in_edges) {
 
 
         //filtering on destination
@@ -376,6 +405,14 @@ namespace graphit {
             oss_ << "for (int64_t ngh = sg->vertexArray[localId]; ngh < sg->vertexArray[localId+1]; ngh++) {\n";
             printIndent();
             oss_ << "  " << node_id_type << " s = sg->edgeArray[ngh];" << std::endl;
+        } else if (split_in_edges) {
+            // only the block of in edges assigned to this task
+            oss_ << node_id_type << " * in_neighbors = g.in_neigh(d).begin();" << std::endl;
+            printIndent();
+            oss_ << "for (int64_t ngh = degree_buckets->heavyBlockBegin[block]; "
+                    "ngh < degree_buckets->heavyBlockEnd[block]; ngh++) {" << std::endl;
+            printIndent();
+            oss_ << "  " << node_id_type << " s = in_neighbors[ngh];" << std::endl;
         } else {
             oss_ << "for(" << node_id_type << " s : g.in_neigh(d)){" << std::endl;
         }
@@ -413,11 +450,14 @@ namespace graphit {
             oss_ << "if( ";
         }
 
+        // the split version that sums into partials gets the partial of the block first
+        std::string partial_arg = (split_in_edges && apply->split_reduce_target != "") ? "partial, " : "";
+
         // generating the C++ code for the apply function call
         if (apply->is_weighted) {
-            oss_ << apply_func_name << " ( s.v , d, s.w " << (numa_aware ? ", socketId" : "") << ")";
+            oss_ << apply_func_name << " ( " << partial_arg << "s.v , d, s.w " << (numa_aware ? ", socketId" : "") << ")";
         } else {
-            oss_ << apply_func_name << " ( s , d " << (numa_aware ? ", socketId" : "") << ")";
+            oss_ << apply_func_name << " ( " << partial_arg << "s , d " << (numa_aware ? ", socketId" : "") << ")";
 
         }
 
@@ -461,6 +501,12 @@ namespace graphit {
             printIndent();
             oss_ << "} //end of to filtering " << std::endl;
         }
+
+        // the fused vertex apply runs on every destination once all of its in edges are processed
+        if (apply->fused_vertex_apply_func != "" && !split_in_edges) {
+            printIndent();
+            oss_ << "vertex_apply_func(d);" << std::endl;
+        }
     }
 
     // Iterate through per-socket local buffers and merge the result into the global buffer
@@ -589,8 +635,23 @@ namespace graphit {
             iter = "localId";
         }
 
+        // degree bucketing only replaces the parallel loop over all the destinations
+        bool degree_bucketed = apply->use_pull_degree_bucketed_load_balance && apply->is_parallel
+                               && !cache_aware && !numa_aware;
+
         //genearte the outer for loop
-        if (! apply->use_pull_edge_based_load_balance) {
+        if (degree_bucketed) {
+            // the classification of the destinations is cached on the graph
+            oss_ << "g.SetUpDegreeBuckets(" << apply->pull_edge_based_load_balance_grain_size << ");\n"
+                    "  DegreeBuckets<NodeID> * degree_buckets = g.get_degree_buckets_();\n";
+            // low in-degree destinations are processed in chunks with a similar number of in edges
+            oss_ << "  ligra::parallel_for_lambda((int64_t)0, degree_buckets->numLightChunks, [&] (int64_t chunk) {\n"
+                    "    for (int64_t i = degree_buckets->lightChunkOffsets[chunk]; "
+                    "i < degree_buckets->lightChunkOffsets[chunk+1]; i++) {\n"
+                    "      NodeID d = degree_buckets->lightVertices[i];\n";
+            indent();
+            indent();
+        } else if (! apply->use_pull_edge_based_load_balance) {
             std::string for_type = "for";
             if (numa_aware) {
                 oss_ << "#pragma omp parallel num_threads(omp_get_place_num_procs(socketId)) proc_bind(close)\n{\n";
@@ -618,7 +679,8 @@ namespace graphit {
 
             oss_ << "    std::function<void(int,int,int)> recursive_lambda = \n"
                     "    [" << (apply->to_func != "" ?  "&to_func, " : "")
-                 << "&apply_func, &g,  &recursive_lambda, edge_in_index" << (cache_aware ? ", sg" : "");
+                 << "&apply_func, &g,  &recursive_lambda, edge_in_index" << (cache_aware ? ", sg" : "")
+                 << (apply->fused_vertex_apply_func != "" ? ", &vertex_apply_func" : "");
             // capture bitmap and next frontier if needed
             if (from_vertexset_specified) {
                 if(apply->use_pull_frontier_bitvector) oss_ << ", &bitmap ";
@@ -643,7 +705,14 @@ namespace graphit {
             dst_type, apply_func_name, cache_aware, numa_aware);
 
 
-        if (! apply->use_pull_edge_based_load_balance) {
+        if (degree_bucketed) {
+            dedent();
+            dedent();
+            oss_ << "    }\n"
+                    "  }); //end of loop on low degree destinations" << std::endl;
+            printPullDegreeBucketedHeavyVertices(apply, from_vertexset_specified, apply_expr_gen_frontier, dst_type,
+                                                 apply_func_name);
+        } else if (! apply->use_pull_edge_based_load_balance) {
             //end of outer for loop
             dedent();
             printIndent();
@@ -686,6 +755,122 @@ namespace graphit {
     }
 
 
+    // Print the loops on the high in-degree destinations of a degree bucketed pull traversal
+    void EdgesetApplyFunctionDeclGenerator::printPullDegreeBucketedHeavyVertices(
+            mir::EdgeSetApplyExpr::Ptr apply,
+            bool from_vertexset_specified,
+            bool apply_expr_gen_frontier,
+            std::string dst_type,
+            std::string apply_func_name) {
+
+        if (apply->split_apply_func == "") {
+            // the apply function can't update a destination from several threads, one task per destination
+            oss_ << "  ligra::parallel_for_lambda((int64_t)0, degree_buckets->numHeavyVertices, [&] (int64_t i) {\n"
+                    "    NodeID d = degree_buckets->heavyVertices[i];\n";
+            indent();
+            printPullEdgeTraversalInnerNeighborLoop(apply, from_vertexset_specified, apply_expr_gen_frontier,
+                                                    dst_type, apply_func_name, false, false);
+            dedent();
+            oss_ << "  }); //end of loop on high degree destinations" << std::endl;
+            return;
+        }
+
+        if (apply->split_reduce_target != "") {
+            // the in edges of the destination are split in blocks, each block sums into its own partial
+            oss_ << "  REDUCE_T * partials = new REDUCE_T[degree_buckets->numHeavyBlocks];\n"
+                    "  ligra::parallel_for_lambda((int64_t)0, degree_buckets->numHeavyBlocks, [&] (int64_t block) {\n"
+                    "    NodeID d = degree_buckets->heavyBlockVertex[block];\n"
+                    "    REDUCE_T partial = 0;\n";
+            indent();
+            printPullEdgeTraversalInnerNeighborLoop(apply, from_vertexset_specified, apply_expr_gen_frontier,
+                                                    dst_type, "split_apply_func", false, false, true);
+            dedent();
+            oss_ << "    partials[block] = partial;\n"
+                    "  }); //end of loop on blocks of in edges of high degree destinations" << std::endl;
+            printDegreeBucketedPartialsCombine(apply);
+            return;
+        }
+
+        // the in edges of the destination are split in blocks, the split apply function updates it atomically
+        oss_ << "  ligra::parallel_for_lambda((int64_t)0, degree_buckets->numHeavyBlocks, [&] (int64_t block) {\n"
+                "    NodeID d = degree_buckets->heavyBlockVertex[block];\n";
+        indent();
+        printPullEdgeTraversalInnerNeighborLoop(apply, from_vertexset_specified, apply_expr_gen_frontier,
+                                                dst_type, "split_apply_func", false, false, true);
+        dedent();
+        oss_ << "  }); //end of loop on blocks of in edges of high degree destinations" << std::endl;
+
+        // the vertex apply waits until all the blocks of a destination are combined
+        if (apply->fused_vertex_apply_func != "") {
+            oss_ << "  ligra::parallel_for_lambda((int64_t)0, degree_buckets->numHeavyVertices, [&] (int64_t i) {\n"
+                    "    vertex_apply_func(degree_buckets->heavyVertices[i]);\n"
+                    "  });" << std::endl;
+        }
+    }
+
+    // Print the loop adding the partials of the blocks of each high degree vertex to split_reduce_target, once per
+    // vertex (no atomics). The fused vertex apply (pull) runs once the vertex is complete
+    void EdgesetApplyFunctionDeclGenerator::printDegreeBucketedPartialsCombine(mir::EdgeSetApplyExpr::Ptr apply) {
+        oss_ << "  ligra::parallel_for_lambda((int64_t)0, degree_buckets->numHeavyVertices, [&] (int64_t i) {\n"
+                "    NodeID v = degree_buckets->heavyVertices[i];\n"
+                "    REDUCE_T sum = 0;\n"
+                "    for (int64_t block = degree_buckets->heavyBlockOffsets[i]; "
+                "block < degree_buckets->heavyBlockOffsets[i+1]; block++)\n"
+                "      sum += partials[block];\n"
+                "    split_reduce_target[v] += sum;\n";
+        if (apply->fused_vertex_apply_func != "")
+            oss_ << "    vertex_apply_func(v);\n";
+        oss_ << "  }); //end of loop on the partials of high degree vertices\n"
+                "  delete[] partials;" << std::endl;
+    }
+
+    // Print the code for a degree bucketed push traversal over all the sources (no frontier)
+    void EdgesetApplyFunctionDeclGenerator::printPushDegreeBucketedTraversal(mir::EdgeSetApplyExpr::Ptr apply) {
+        std::string node_id_type = apply->is_weighted ? "WNode" : "NodeID";
+        std::string apply_args = apply->is_weighted ? "s, d.v, d.w" : "s, d";
+
+        // the classification of the sources is cached on the graph
+        oss_ << "    g.SetUpOutDegreeBuckets(" << apply->pull_edge_based_load_balance_grain_size << ");\n"
+                "    DegreeBuckets<NodeID> * degree_buckets = g.get_out_degree_buckets_();\n";
+        // low out-degree sources are processed in chunks with a similar number of out edges
+        oss_ << "    ligra::parallel_for_lambda((int64_t)0, degree_buckets->numLightChunks, [&] (int64_t chunk) {\n"
+                "      for (int64_t i = degree_buckets->lightChunkOffsets[chunk]; "
+                "i < degree_buckets->lightChunkOffsets[chunk+1]; i++) {\n"
+                "        NodeID s = degree_buckets->lightVertices[i];\n"
+                "        for (" << node_id_type << " d : g.out_neigh(s)) {\n"
+                "          apply_func ( " << apply_args << " );\n"
+                "        }\n"
+                "      }\n"
+                "    }); //end of loop on low degree sources" << std::endl;
+
+        if (apply->split_apply_func == "") {
+            // the apply function can't update a source from several threads, one task per source
+            oss_ << "    ligra::parallel_for_lambda((int64_t)0, degree_buckets->numHeavyVertices, [&] (int64_t i) {\n"
+                    "      NodeID s = degree_buckets->heavyVertices[i];\n"
+                    "      for (" << node_id_type << " d : g.out_neigh(s)) {\n"
+                    "        apply_func ( " << apply_args << " );\n"
+                    "      }\n"
+                    "    }); //end of loop on high degree sources" << std::endl;
+            return;
+        }
+
+        // the out edges of the source are split in blocks, each block sums into its own partial and the
+        // partials of a source are added to it once all its blocks are done (no atomics)
+        oss_ << "    REDUCE_T * partials = new REDUCE_T[degree_buckets->numHeavyBlocks];\n"
+                "    ligra::parallel_for_lambda((int64_t)0, degree_buckets->numHeavyBlocks, [&] (int64_t block) {\n"
+                "      NodeID s = degree_buckets->heavyBlockVertex[block];\n"
+                "      " << node_id_type << " * out_neighbors = g.out_neigh(s).begin();\n"
+                "      REDUCE_T partial = 0;\n"
+                "      for (int64_t ngh = degree_buckets->heavyBlockBegin[block]; "
+                "ngh < degree_buckets->heavyBlockEnd[block]; ngh++) {\n"
+                "        " << node_id_type << " d = out_neighbors[ngh];\n"
+                "        split_apply_func ( partial, " << apply_args << " );\n"
+                "      }\n"
+                "      partials[block] = partial;\n"
+                "    }); //end of loop on blocks of out edges of high degree sources" << std::endl;
+        printDegreeBucketedPartialsCombine(apply);
+    }
+
     // Print the code for traversing the edges in the push direction and return the new frontier
     void EdgesetApplyFunctionDeclGenerator::printHybridDenseEdgeTraversalReturnFrontier(
             mir::EdgeSetApplyExpr::Ptr apply,
@@ -874,6 +1059,135 @@ namespace graphit {
 
     }
 
+    // print code for the edge centric direction, streaming through the grid ordered COO edge array
+    // (built lazily and cached on the graph) one cell at a time
+    void EdgesetApplyFunctionDeclGenerator::printEdgeCentricEdgeTraversalReturnFrontier(
+            mir::EdgeSetApplyExpr::Ptr apply, bool from_vertexset_specified, bool apply_expr_gen_frontier,
+            std::string dst_type) {
+
+        if (apply_expr_gen_frontier) {
+            oss_ << "  VertexSubset<NodeID> *next_frontier = new VertexSubset<NodeID>(g.num_nodes(), 0);\n"
+                    "  bool * next = newA(bool, g.num_nodes());\n"
+                    "  ligra::parallel_for_lambda((int)0, (int)numVertices, [&] (int i) { next[i] = 0; });\n";
+        }
+
+        oss_ << "  if (g.get_edge_grid_() == nullptr) g.SetUpEdgeGrid();\n"
+                "  auto grid = g.get_edge_grid_();\n";
+
+        indent();
+
+        if (from_vertexset_specified) {
+            printIndent();
+            oss_ << "from_vertexset->toDense();" << std::endl;
+        }
+
+        printIndent();
+
+        std::string node_id_type = "NodeID";
+        if (apply->is_weighted) node_id_type = "WNode";
+
+        if (apply->is_parallel) {
+            oss_ << "ligra::parallel_for_1_lambda((int64_t)0, (int64_t)grid->num_cells(), [&] (int64_t c) {" << std::endl;
+        } else {
+            oss_ << "for (int64_t c = 0; c < grid->num_cells(); c++) {" << std::endl;
+        }
+        indent();
+        printIndent();
+        oss_ << "for (int64_t e = grid->cellOffsets[c]; e < grid->cellOffsets[c+1]; e++) {" << std::endl;
+        indent();
+        printIndent();
+        oss_ << "NodeID s = grid->srcArray[e];" << std::endl;
+        printIndent();
+        oss_ << node_id_type << " d = grid->dstArray[e];" << std::endl;
+
+        // print the checks on filtering on sources s
+        if (apply->from_func != "") {
+            printIndent();
+            oss_ << "if";
+            if (mir_context_->isFunction(apply->from_func)) {
+                //if the input expression is a function call
+                oss_ << " (from_func(s)";
+            } else {
+                //the input expression is a vertex subset
+                oss_ << " (from_vertexset->bool_map_[s] ";
+            }
+            oss_ << ") { " << std::endl;
+            indent();
+        }
+
+        // print the checks on filtering on destinations d
+        if (apply->to_func != "") {
+            printIndent();
+            oss_ << "if";
+            if (mir_context_->isFunction(apply->to_func)) {
+                //if the input expression is a function call
+                oss_ << " (to_func(" << dst_type << ")";
+            } else {
+                //the input expression is a vertex subset
+                oss_ << " (to_vertexset->bool_map_[" << dst_type << "] ";
+            }
+            oss_ << ") { " << std::endl;
+            indent();
+        }
+
+        printIndent();
+        if (apply_expr_gen_frontier) {
+            oss_ << "if( ";
+        }
+
+        // generating the C++ code for the apply function call
+        if (apply->is_weighted) {
+            oss_ << "apply_func ( s , d.v, d.w )";
+        } else {
+            oss_ << "apply_func ( s , d )";
+        }
+
+        if (!apply_expr_gen_frontier) {
+            oss_ << ";" << std::endl;
+        } else {
+            oss_ << " ) { " << std::endl;
+            indent();
+            printIndent();
+            oss_ << "next[" << dst_type << "] = 1; " << std::endl;
+            dedent();
+            printIndent();
+            oss_ << "} //end of generating the next frontier" << std::endl;
+        }
+
+        if (apply->to_func != "") {
+            dedent();
+            printIndent();
+            oss_ << "} // end of if to_func filtering" << std::endl;
+        }
+
+        if (apply->from_func != "") {
+            dedent();
+            printIndent();
+            oss_ << "} // end of if for from_func or from vertexset" << std::endl;
+        }
+
+        dedent();
+        printIndent();
+        oss_ << "} // end of loop on the edges of a cell" << std::endl;
+
+        dedent();
+        printIndent();
+        if (apply->is_parallel) {
+            oss_ << "}); //end of loop on grid cells" << std::endl;
+        } else {
+            oss_ << "} //end of loop on grid cells" << std::endl;
+        }
+        dedent();
+
+        //return a new vertexset if no subset vertexset is returned
+        if (apply_expr_gen_frontier) {
+            oss_ << "  next_frontier->num_vertices_ = sequence::sum(next, numVertices);\n"
+                    "  next_frontier->bool_map_ = next;\n"
+                    "  next_frontier->is_dense = true;\n"
+                    "  return next_frontier;\n";
+        }
+    }
+
     void EdgesetApplyFunctionDeclGenerator::genEdgePullApplyFunctionDeclBody(mir::EdgeSetApplyExpr::Ptr apply) {
         bool apply_expr_gen_frontier = false;
         bool from_vertexset_specified = false;
@@ -891,7 +1205,23 @@ namespace graphit {
         string dst_type;
         setupFlags(apply, apply_expr_gen_frontier, from_vertexset_specified, dst_type);
         setupGlobalVariables(apply, apply_expr_gen_frontier, from_vertexset_specified);
-        printPushEdgeTraversalReturnFrontier(apply, from_vertexset_specified, apply_expr_gen_frontier, dst_type);
+        if (apply->use_push_degree_bucketed_load_balance)
+            printPushDegreeBucketedTraversal(apply);
+        else
+            printPushEdgeTraversalReturnFrontier(apply, from_vertexset_specified, apply_expr_gen_frontier, dst_type);
+    }
+
+    // Generate the code for edge centric program
+    void EdgesetApplyFunctionDeclGenerator::genEdgeCentricApplyFunctionDeclBody(mir::EdgeSetApplyExpr::Ptr apply) {
+        bool apply_expr_gen_frontier = false;
+        bool from_vertexset_specified = false;
+        string dst_type;
+        setupFlags(apply, apply_expr_gen_frontier, from_vertexset_specified, dst_type);
+        // the edge grid replaces the degrees and the sparse frontier, only the output frontier needs numVertices
+        if (apply_expr_gen_frontier)
+            oss_ << "    int64_t numVertices = g.num_nodes();\n";
+        printEdgeCentricEdgeTraversalReturnFrontier(apply, from_vertexset_specified, apply_expr_gen_frontier,
+                                                    dst_type);
     }
 
     void EdgesetApplyFunctionDeclGenerator::genEdgeHybridDenseApplyFunctionDeclBody(mir::EdgeSetApplyExpr::Ptr apply) {
@@ -969,6 +1299,20 @@ namespace graphit {
             arguments.push_back("PUSH_APPLY_FUNC push_apply_func");
         }
 
+        if (apply->split_apply_func != "") {
+            templates.push_back("typename SPLIT_APPLY_FUNC");
+            arguments.push_back("SPLIT_APPLY_FUNC split_apply_func");
+            if (apply->split_reduce_target != "") {
+                templates.push_back("typename REDUCE_T");
+                arguments.push_back("REDUCE_T * split_reduce_target");
+            }
+        }
+
+        if (apply->fused_vertex_apply_func != "") {
+            templates.push_back("typename VERTEX_APPLY_FUNC");
+            arguments.push_back("VERTEX_APPLY_FUNC vertex_apply_func");
+        }
+
         oss_ << "template <";
 
         bool first = true;
@@ -1001,7 +1345,7 @@ namespace graphit {
     // important for cases where we split the kernel iterations and assign different schedules to different iters
     std::string EdgesetApplyFunctionDeclGenerator::genFunctionName(mir::EdgeSetApplyExpr::Ptr apply) {
         // A total of 48 schedules for the edgeset apply operator for now
-        // Direction first: "push", "pull" or "hybrid_dense"
+        // Direction first: "push", "pull", "hybrid_dense" or "edge_centric"
         // Parallel: "parallel" or "serial"
         // Weighted: "" or "weighted"
         // Deduplicate: "deduplicated" or ""
@@ -1017,7 +1361,10 @@ namespace graphit {
 
         //check direction
         if (mir::isa<mir::PushEdgeSetApplyExpr>(apply)) {
-            output_name += "_push";
+            if (apply->use_edge_centric_traversal)
+                output_name += "_edge_centric";
+            else
+                output_name += "_push";
         } else if (mir::isa<mir::PullEdgeSetApplyExpr>(apply)) {
             output_name += "_pull";
         } else if (mir::isa<mir::HybridDenseForwardEdgeSetApplyExpr>(apply)) {
@@ -1094,6 +1441,28 @@ namespace graphit {
             output_name += "_pull_edge_based_load_balance";
         }
 
+        if (apply->use_pull_degree_bucketed_load_balance){
+            output_name += "_pull_degree_bucketed_load_balance";
+            if (apply->split_apply_func != "")
+                output_name += "_split_in_edges";
+            if (apply->split_reduce_target != "")
+                output_name += "_partials";
+        }
+
+        if (apply->use_push_degree_bucketed_load_balance){
+            output_name += "_push_degree_bucketed_load_balance";
+            if (apply->split_apply_func != "")
+                output_name += "_split_out_edges";
+        }
+
+        if (apply->fused_vertex_apply_func != ""){
+            output_name += "_fused_vertex_apply";
+        }
+
+        if (getHubBitmapBudget(apply) >= 0){
+            output_name += "_hub_bitmaps";
+        }
+
         return output_name;
     }
 
@@ -272,27 +272,16 @@ namespace graphit {
         high_level_schedule::ProgramScheduleNode::setApply(std::string apply_label,
                                                            std::string apply_schedule_str,
                                                            int parameter) {
-            // If no schedule has been constructed, construct a new one
-            if (schedule_ == nullptr) {
-                schedule_ = new Schedule();
-            }
-
-            // If no apply schedule has been constructed, construct a new one
-            if (schedule_->apply_schedules == nullptr) {
-                schedule_->apply_schedules = new std::map<std::string, ApplySchedule>();
-            }
-
-            // If no schedule has been specified for the current label, create a new one
-            if (schedule_->apply_schedules->find(apply_label) == schedule_->apply_schedules->end()) {
-                //Default schedule pull, serial, -100 for number of segments (we use -1 to -10 for argv)
-                (*schedule_->apply_schedules)[apply_label]
-                        = createDefaultSchedule(apply_label);
-            }
+            initApplyScheduleIfNeeded(apply_label);
 
             if (apply_schedule_str == "pull_edge_based_load_balance") {
                 (*schedule_->apply_schedules)[apply_label].pull_load_balance_type
                         = ApplySchedule::PullLoadBalance::EDGE_BASED;
                 (*schedule_->apply_schedules)[apply_label].pull_load_balance_edge_grain_size = parameter;
+            } else if (apply_schedule_str == "pull_degree_bucketed_load_balance") {
+                (*schedule_->apply_schedules)[apply_label].pull_load_balance_type
+                        = ApplySchedule::PullLoadBalance::DEGREE_BUCKETED;
+                (*schedule_->apply_schedules)[apply_label].pull_load_balance_edge_grain_size = parameter;
             } else if (apply_schedule_str == "pull") {
                 (*schedule_->apply_schedules)[apply_label].direction_type = ApplySchedule::DirectionType::PULL;
             } else if (apply_schedule_str == "hybrid_dense") {
@@ -305,6 +294,8 @@ namespace graphit {
                 (*schedule_->apply_schedules)[apply_label].merge_threshold = parameter;
             } else if (apply_schedule_str == "num_open_buckets"){
                 (*schedule_->apply_schedules)[apply_label].num_open_buckets = parameter;
+            } else if (apply_schedule_str == "relaxation_factor"){
+                (*schedule_->apply_schedules)[apply_label].relaxation_factor = parameter;
             } else {
                 std::cout << "unrecognized schedule for apply: " << apply_schedule_str << std::endl;
                 exit(0);
@@ -317,23 +308,7 @@ namespace graphit {
         high_level_schedule::ProgramScheduleNode::Ptr
         high_level_schedule::ProgramScheduleNode::setApply(std::string apply_label, std::string apply_schedule_str) {
 
-            // If no schedule has been constructed, construct a new one
-            if (schedule_ == nullptr) {
-                schedule_ = new Schedule();
-            }
-
-            // If no apply schedule has been constructed, construct a new one
-            if (schedule_->apply_schedules == nullptr) {
-                schedule_->apply_schedules = new std::map<std::string, ApplySchedule>();
-            }
-
-            // If no schedule has been specified for the current label, create a new one
-
-            if (schedule_->apply_schedules->find(apply_label) == schedule_->apply_schedules->end()) {
-                //Default schedule pull, serial, -100 for number of segments (we use -1 to -10 for argv)
-                (*schedule_->apply_schedules)[apply_label]
-                        = createDefaultSchedule(apply_label);
-            }
+            initApplyScheduleIfNeeded(apply_label);
 
 
             if (apply_schedule_str == "push") {
@@ -344,6 +319,8 @@ namespace graphit {
                 (*schedule_->apply_schedules)[apply_label].direction_type = ApplySchedule::DirectionType::HYBRID_DENSE_FORWARD;
             } else if (apply_schedule_str == "hybrid_dense") {
                 (*schedule_->apply_schedules)[apply_label].direction_type = ApplySchedule::DirectionType::HYBRID_DENSE;
+            } else if (apply_schedule_str == "edge_centric") {
+                (*schedule_->apply_schedules)[apply_label].direction_type = ApplySchedule::DirectionType::EDGE_CENTRIC;
             } else if (apply_schedule_str == "serial") {
                 (*schedule_->apply_schedules)[apply_label].parallel_type = ApplySchedule::ParType::Serial;
             } else if (apply_schedule_str == "parallel") {
@@ -352,6 +329,10 @@ namespace graphit {
                 (*schedule_->apply_schedules)[apply_label].deduplication_type = ApplySchedule::DeduplicationType::Enable;
             } else if (apply_schedule_str == "disable_deduplication") {
                 (*schedule_->apply_schedules)[apply_label].deduplication_type = ApplySchedule::DeduplicationType::Disable;
+            } else if (apply_schedule_str == "enable_apply_fusion") {
+                (*schedule_->apply_schedules)[apply_label].apply_fusion = true;
+            } else if (apply_schedule_str == "disable_apply_fusion") {
+                (*schedule_->apply_schedules)[apply_label].apply_fusion = false;
             } else if (apply_schedule_str == "sliding_queue") {
                 (*schedule_->apply_schedules)[apply_label].opt = ApplySchedule::OtherOpt::SLIDING_QUEUE;
             } else if (apply_schedule_str == "pull_frontier_bitvector") {
@@ -359,8 +340,13 @@ namespace graphit {
             } else if (apply_schedule_str == "pull_edge_based_load_balance") {
                 (*schedule_->apply_schedules)[apply_label].pull_load_balance_type
                         = ApplySchedule::PullLoadBalance::EDGE_BASED;
+            } else if (apply_schedule_str == "pull_degree_bucketed_load_balance") {
+                (*schedule_->apply_schedules)[apply_label].pull_load_balance_type
+                        = ApplySchedule::PullLoadBalance::DEGREE_BUCKETED;
             } else if (apply_schedule_str == "numa_aware") {
                 (*schedule_->apply_schedules)[apply_label].numa_aware = true;
+            } else if (apply_schedule_str == "sparse_reset") {
+                (*schedule_->apply_schedules)[apply_label].sparse_reset = true;
             } else if (apply_schedule_str == "lazy_priority_update"){
                 (*schedule_->apply_schedules)[apply_label].priority_update_type
                         = ApplySchedule::PriorityUpdateType::REDUCTION_BEFORE_UPDATE;
@@ -370,9 +356,22 @@ namespace graphit {
             } else if (apply_schedule_str == "eager_priority_update_with_merge") {
                 (*schedule_->apply_schedules)[apply_label].priority_update_type
                         = ApplySchedule::PriorityUpdateType::EAGER_PRIORITY_UPDATE_WITH_MERGE;
+            } else if (apply_schedule_str == "relaxed_multiqueue") {
+                (*schedule_->apply_schedules)[apply_label].priority_update_type
+                        = ApplySchedule::PriorityUpdateType::RELAXED_MULTIQUEUE;
+            } else if (apply_schedule_str == "open_buckets") {
+                (*schedule_->apply_schedules)[apply_label].bucket_backend = ApplySchedule::BucketBackend::OPEN_BUCKETS;
+            } else if (apply_schedule_str == "radix_heap_buckets") {
+                (*schedule_->apply_schedules)[apply_label].bucket_backend = ApplySchedule::BucketBackend::RADIX_HEAP;
+            } else if (apply_schedule_str == "two_level_buckets") {
+                (*schedule_->apply_schedules)[apply_label].bucket_backend
+                        = ApplySchedule::BucketBackend::TWO_LEVEL_BUCKETS;
 	    } else if (apply_schedule_str == "constant_sum_reduce_before_update") {
 	        (*schedule_->apply_schedules)[apply_label].priority_update_type
 		        = ApplySchedule::PriorityUpdateType::CONST_SUM_REDUCTION_BEFORE_UPDATE;
+            } else if (apply_schedule_str == "eager_constant_sum_reduce_before_update") {
+                (*schedule_->apply_schedules)[apply_label].priority_update_type
+                        = ApplySchedule::PriorityUpdateType::EAGER_CONST_SUM_REDUCTION_BEFORE_UPDATE;
             } else {
                 std::cout << "unrecognized schedule for apply: " << apply_schedule_str << std::endl;
                 exit(0);
@@ -566,6 +565,15 @@ namespace graphit {
                 gis_vec->push_back(gis);
 
 
+            } else if (apply_direction == "EdgeCentric") {
+                // edges are streamed from a grid ordered COO array, both endpoints can be shared
+                auto gis = GraphIterationSpace();
+                gis.direction = GraphIterationSpace::Direction::Push;
+                gis.setFTTag(GraphIterationSpace::Dimension::OuterIter, Tags::FT_Tag::BoolArray);
+                gis.setFTTag(GraphIterationSpace::Dimension::InnerITer, Tags::FT_Tag::BoolArray);
+                gis.scheduling_api_direction = "EdgeCentric";
+                gis_vec->push_back(gis);
+
             } else {
                 std::cout << "unsupported direction: " << apply_direction << std::endl;
                 throw "Unsupported Schedule!";
@@ -622,6 +630,14 @@ namespace graphit {
                 (*schedule_->intersection_schedules)[intersection_label] = IntersectionSchedule::IntersectionType::BINARY;
             }
 
+            else if (intersection_option == "SIMDIntersection") {
+                (*schedule_->intersection_schedules)[intersection_label] = IntersectionSchedule::IntersectionType::SIMD;
+            }
+
+            else if (intersection_option == "HubBitmapIntersection") {
+                (*schedule_->intersection_schedules)[intersection_label] = IntersectionSchedule::IntersectionType::HUB_BITMAP;
+            }
+
             else {
                 std::cout << "unsupported intersection: " << intersection_option << std::endl;
                 (*schedule_->intersection_schedules)[intersection_label] = IntersectionSchedule::IntersectionType::NAIVE;
@@ -632,6 +648,38 @@ namespace graphit {
 
         }
 
+        high_level_schedule::ProgramScheduleNode::Ptr
+        high_level_schedule::ProgramScheduleNode::configIntersectionCombinedThresholds(std::string intersection_label,
+                                                                                       int size_threshold,
+                                                                                       double ratio_threshold) {
+            if (schedule_ == nullptr) {
+                schedule_ = new Schedule();
+            }
+
+            if (schedule_->intersection_params == nullptr) {
+                schedule_->intersection_params = new std::map<std::string, IntersectionSchedule>();
+            }
+
+            (*schedule_->intersection_params)[intersection_label].combined_size_threshold = size_threshold;
+            (*schedule_->intersection_params)[intersection_label].combined_ratio_threshold = ratio_threshold;
+            return this->shared_from_this();
+        }
+
+        high_level_schedule::ProgramScheduleNode::Ptr
+        high_level_schedule::ProgramScheduleNode::configIntersectionHubBitmapBudget(std::string intersection_label,
+                                                                                    int budget_mb) {
+            if (schedule_ == nullptr) {
+                schedule_ = new Schedule();
+            }
+
+            if (schedule_->intersection_params == nullptr) {
+                schedule_->intersection_params = new std::map<std::string, IntersectionSchedule>();
+            }
+
+            (*schedule_->intersection_params)[intersection_label].hub_bitmap_budget_mb = budget_mb;
+            return this->shared_from_this();
+        }
+
         high_level_schedule::ProgramScheduleNode::Ptr
         high_level_schedule::ProgramScheduleNode::configApplyParallelization(std::string apply_label,
                                                                              std::string apply_parallel, int grain_size,
@@ -655,6 +703,9 @@ namespace graphit {
                     } else if (apply_parallel == "edge-aware-dynamic-vertex-parallel") {
                         gis.setPTTag(GraphIterationSpace::Dimension::BSG, Tags::PT_Tag::EdgeAwareVertexCount);
                         gis.setPRTag(GraphIterationSpace::Dimension::BSG, Tags::PR_Tag::WorkStealingPar);
+                    } else if (apply_parallel == "degree-bucketed-dynamic-vertex-parallel") {
+                        gis.setPTTag(GraphIterationSpace::Dimension::BSG, Tags::PT_Tag::DegreeBucketedVertexCount);
+                        gis.setPRTag(GraphIterationSpace::Dimension::BSG, Tags::PR_Tag::WorkStealingPar);
                     } else {
                         std::cout << "unsupported parallelization strategy: " << apply_parallel << std::endl;
                         throw "Unsupported Schedule!";
@@ -676,6 +727,13 @@ namespace graphit {
                     //need a separate specification in the old API
                     setApply(apply_label, "pull_edge_based_load_balance");
                     return setApply(apply_label, old_par_schedule);
+                } else if (apply_parallel == "degree-bucketed-dynamic-vertex-parallel") {
+                    //the grain size is the largest in-degree of a vertex that is processed by a single thread
+                    if (grain_size != 1024)
+                        setApply(apply_label, "pull_degree_bucketed_load_balance", grain_size);
+                    else
+                        setApply(apply_label, "pull_degree_bucketed_load_balance");
+                    return setApply(apply_label, old_par_schedule);
                 } else {
                     return setApply(apply_label, old_par_schedule);
                 }
@@ -856,6 +914,25 @@ namespace graphit {
             }
         }
 
+        void high_level_schedule::ProgramScheduleNode::initApplyScheduleIfNeeded(std::string apply_label) {
+            // If no schedule has been constructed, construct a new one
+            if (schedule_ == nullptr) {
+                schedule_ = new Schedule();
+            }
+
+            // If no apply schedule has been constructed, construct a new one
+            if (schedule_->apply_schedules == nullptr) {
+                schedule_->apply_schedules = new std::map<std::string, ApplySchedule>();
+            }
+
+            // If no schedule has been specified for the current label, create a new one
+            if (schedule_->apply_schedules->find(apply_label) == schedule_->apply_schedules->end()) {
+                //Default schedule pull, serial, -100 for number of segments (we use -1 to -10 for argv)
+                (*schedule_->apply_schedules)[apply_label]
+                        = createDefaultSchedule(apply_label);
+            }
+        }
+
         high_level_schedule::ProgramScheduleNode::Ptr
         high_level_schedule::ProgramScheduleNode::configApplyNUMA(std::string apply_label, std::string config,
                                                                   std::string direction) {
@@ -903,6 +980,10 @@ namespace graphit {
         high_level_schedule::ProgramScheduleNode::configApplyPriorityUpdateDelta(std::string apply_label,
                                                                                  std::string delta_argv) {
 
+            if (delta_argv == "auto") {
+                // a delta of 0 is selected by the runtime library
+                return setApply(apply_label, "delta", 0);
+            }
             int argv_num = extractArgvNumFromStringArg(delta_argv);
             return setApply(apply_label, "delta", argv_num);
         }
@@ -913,6 +994,62 @@ namespace graphit {
             return setApply(apply_label, "bucket_merge_threshold", argv_num);
         }
 
+        high_level_schedule::ProgramScheduleNode::Ptr
+        high_level_schedule::ProgramScheduleNode::configRelaxationFactor(std::string apply_label, int relaxation_factor) {
+            return setApply(apply_label, "relaxation_factor", relaxation_factor);
+        }
+
+        high_level_schedule::ProgramScheduleNode::Ptr
+        high_level_schedule::ProgramScheduleNode::configRelaxationFactor(std::string apply_label,
+                                                                         string relaxation_factor_argv) {
+            int argv_num = extractArgvNumFromStringArg(relaxation_factor_argv);
+            return setApply(apply_label, "relaxation_factor", argv_num);
+        }
+
+        high_level_schedule::ProgramScheduleNode::Ptr
+        high_level_schedule::ProgramScheduleNode::configBucketBackend(std::string apply_label,
+                                                                      std::string bucket_backend) {
+            if (bucket_backend == "open_buckets" || bucket_backend == "radix_heap_buckets"
+                || bucket_backend == "two_level_buckets") {
+                return setApply(apply_label, bucket_backend);
+            }
+            std::cout << "unrecognized bucket backend: " << bucket_backend << std::endl;
+            exit(0);
+        }
+
+        high_level_schedule::ProgramScheduleNode::Ptr
+        high_level_schedule::ProgramScheduleNode::configApplySparseReset(std::string apply_label,
+                                                                         float dense_fraction) {
+            if (dense_fraction < 0 || dense_fraction > 1) {
+                std::cout << "sparse reset dense fraction needs to be between 0 and 1: " << dense_fraction << std::endl;
+                exit(0);
+            }
+            setApply(apply_label, "sparse_reset");
+            (*schedule_->apply_schedules)[apply_label].sparse_reset_dense_fraction = dense_fraction;
+            return this->shared_from_this();
+        }
+
+        high_level_schedule::ProgramScheduleNode::Ptr
+        high_level_schedule::ProgramScheduleNode::configApplySourceFilter(std::string apply_label,
+                                                                          std::string filter_func) {
+            initApplyScheduleIfNeeded(apply_label);
+            (*schedule_->apply_schedules)[apply_label].source_filter_func = filter_func;
+            return this->shared_from_this();
+        }
+
+        high_level_schedule::ProgramScheduleNode::Ptr
+        high_level_schedule::ProgramScheduleNode::configApplyPriorityUpdateEpsilon(std::string apply_label,
+                                                                                   float epsilon) {
+            if (epsilon < 0) {
+                std::cout << "bucket epsilon needs to be non negative: " << epsilon << std::endl;
+                exit(0);
+            }
+            // approximate buckets are only implemented by the open buckets backend, which is checked by the lowering
+            initApplyScheduleIfNeeded(apply_label);
+            (*schedule_->apply_schedules)[apply_label].bucket_epsilon = epsilon;
+            return this->shared_from_this();
+        }
+
         // Create a default schedule parameters
         ApplySchedule high_level_schedule::ProgramScheduleNode::createDefaultSchedule(std::string apply_label) {
             return {apply_label, ApplySchedule::DirectionType::PUSH, // default direction is push
@@ -927,7 +1064,14 @@ namespace graphit {
                     1, // default delta
                     false, // enable_numa_aware?
                     1000, // merge threshold for eager prioirty queue
-                    128   // default number of open buckets for lazy priority queue
+                    128,  // default number of open buckets for lazy priority queue
+                    2,    // default number of queues per thread for relaxed multiqueue
+                    ApplySchedule::BucketBackend::OPEN_BUCKETS,
+                    false, // sparse reset
+                    0.05, // dense fraction of the sparse reset
+                    0,    // exact buckets
+                    true, // apply fusion
+                    ""    // default source filter
             };
         }
 
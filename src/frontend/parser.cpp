@@ -2635,6 +2635,7 @@ namespace graphit {
         intrinsics_.push_back("getOutDegree");
         intrinsics_.push_back("getNgh");
         intrinsics_.push_back("relabel");
+        intrinsics_.push_back("orient");
 
         // library functions for vertexset
         intrinsics_.push_back("getVertexSetSize");
@@ -2657,7 +2658,17 @@ namespace graphit {
         decls.insert("writeMin", IdentType::FUNCTION);
 	    decls.insert("getRandomOutNgh", IdentType::FUNCTION);
         decls.insert("getRandomInNgh", IdentType::FUNCTION);
+        decls.insert("setRandomSeed", IdentType::FUNCTION);
+        decls.insert("writeRandomWalks", IdentType::FUNCTION);
         decls.insert("serialMinimumSpanningTree", IdentType::FUNCTION);
+        decls.insert("bidirectionalDeltaStepping", IdentType::FUNCTION);
+        decls.insert("multiSourceBFSDistanceSums", IdentType::FUNCTION);
+        decls.insert("multiSourceSSSPDistanceSums", IdentType::FUNCTION);
+        decls.insert("buildLandmarks", IdentType::FUNCTION);
+        decls.insert("loadLandmarks", IdentType::FUNCTION);
+        decls.insert("saveLandmarks", IdentType::FUNCTION);
+        decls.insert("landmarkLowerBound", IdentType::FUNCTION);
+        decls.insert("servePPSPQueries", IdentType::FUNCTION);
     }
 
     fir::BreakStmt::Ptr Parser::parseBreakStmt() {
@@ -30,6 +30,8 @@ namespace graphit {
                 } else if (apply_schedule->second.parallel_type == ApplySchedule::ParType::Serial) {
                     vertexset_apply->is_parallel = false;
                 }
+                vertexset_apply->sparse_reset = apply_schedule->second.sparse_reset;
+                vertexset_apply->sparse_reset_dense_fraction = apply_schedule->second.sparse_reset_dense_fraction;
             }
         }
 
@@ -71,6 +73,11 @@ namespace graphit {
                            ApplySchedule::DirectionType::HYBRID_DENSE_FORWARD) {
                     //Hybrid dense forward (switching betweeen push and dense forward push)
                     node = std::make_shared<mir::HybridDenseForwardEdgeSetApplyExpr>(edgeset_apply);
+                } else if (apply_schedule->second.direction_type == ApplySchedule::DirectionType::EDGE_CENTRIC) {
+                    //Edge centric traversal, updates the same way as push but both endpoints can be shared
+                    auto edge_centric_apply = std::make_shared<mir::PushEdgeSetApplyExpr>(edgeset_apply);
+                    edge_centric_apply->use_edge_centric_traversal = true;
+                    node = edge_centric_apply;
                 } else if (apply_schedule->second.direction_type == ApplySchedule::DirectionType::HYBRID_DENSE) {
                     //Hybrid dense (switching betweeen push and pull)
                     auto hybrid_dense_edgeset_apply = std::make_shared<mir::HybridDenseEdgeSetApplyExpr>(edgeset_apply);
@@ -117,6 +124,39 @@ namespace graphit {
                     }
                 }
 
+                if (apply_schedule->second.pull_load_balance_type == ApplySchedule::PullLoadBalance::DEGREE_BUCKETED
+                    && mir::isa<mir::PushEdgeSetApplyExpr>(node)) {
+                    // push classifies the sources by out-degree instead
+                    lowerPushDegreeBucketed(mir::to<mir::PushEdgeSetApplyExpr>(node), apply_schedule->second);
+                } else if (apply_schedule->second.pull_load_balance_type == ApplySchedule::PullLoadBalance::DEGREE_BUCKETED){
+                    auto lowered_apply = mir::to<mir::EdgeSetApplyExpr>(node);
+                    lowered_apply->use_pull_degree_bucketed_load_balance = true;
+                    if (apply_schedule->second.pull_load_balance_edge_grain_size > 0){
+                        lowered_apply->pull_edge_based_load_balance_grain_size
+                                = apply_schedule->second.pull_load_balance_edge_grain_size;
+                    }
+                    // the in edges of a high degree destination are split across threads if the apply function only
+                    // updates the destination with sums into a vector, each block of in edges sums into its own partial
+                    // and the partials are added to the destination once (no frontier is tracked on them).
+                    // Otherwise they can still be split if the updates can be made atomic, the split version gets
+                    // the atomics in AtomicsOpLower (hybrid dense keeps high degree vertices whole)
+                    if (mir::isa<mir::PullEdgeSetApplyExpr>(node) && lowered_apply->is_parallel
+                        && !mir_context_->isExternFunction(edgeset_apply->input_function_name)) {
+                        auto pull_apply_func_decl = mir_context_->getFunction(edgeset_apply->input_function_name);
+                        bool split_partials = !pull_apply_func_decl->result.isInitialized()
+                                              && addSplitPartialApplyFunc(lowered_apply, pull_apply_func_decl,
+                                                                          pull_apply_func_decl->args[1].getName());
+                        auto split_checker = SplitApplyFuncChecker();
+                        pull_apply_func_decl->accept(&split_checker);
+                        if (!split_partials && split_checker.splittable) {
+                            mir::FuncDecl::Ptr split_apply_func_decl = pull_apply_func_decl->clone<mir::FuncDecl>();
+                            split_apply_func_decl->name = split_apply_func_decl->name + "_split_ver";
+                            lowered_apply->split_apply_func = split_apply_func_decl->name;
+                            mir_context_->addFunctionFront(split_apply_func_decl);
+                        }
+                    }
+                }
+
                 //if this is applyModified with a tracking field
                 if (edgeset_apply->tracking_field != "") {
                     // only enable deduplication when the argument to ApplyModified is True (disable deduplication), or the user manually set disable
@@ -141,4 +181,156 @@ namespace graphit {
         }
     }
 
+    void ApplyExprLower::LowerApplyExpr::lowerPushDegreeBucketed(mir::PushEdgeSetApplyExpr::Ptr push_apply,
+                                                                 ApplySchedule &apply_schedule) {
+        // only the loop over all the sources is bucketed, frontiers and filters keep the regular push
+        auto apply_func_decl = mir_context_->getFunction(push_apply->input_function_name);
+        if (!push_apply->is_parallel || push_apply->use_edge_centric_traversal
+            || push_apply->from_func != "" || push_apply->to_func != "" || push_apply->tracking_field != ""
+            || mir_context_->isExternFunction(push_apply->input_function_name)
+            || apply_func_decl->result.isInitialized())
+            return;
+        push_apply->use_push_degree_bucketed_load_balance = true;
+        if (apply_schedule.pull_load_balance_edge_grain_size > 0)
+            push_apply->pull_edge_based_load_balance_grain_size = apply_schedule.pull_load_balance_edge_grain_size;
+
+        // the out edges of a high degree source are only split if its updates can be summed into a partial per block,
+        // the partials are added to the source afterwards (without atomics)
+        addSplitPartialApplyFunc(push_apply, apply_func_decl, apply_func_decl->args[0].getName());
+    }
+
+    bool ApplyExprLower::LowerApplyExpr::addSplitPartialApplyFunc(mir::EdgeSetApplyExpr::Ptr apply,
+                                                                  mir::FuncDecl::Ptr apply_func_decl,
+                                                                  std::string split_vertex_name) {
+        auto split_checker = SplitPartialApplyFuncChecker(split_vertex_name);
+        apply_func_decl->accept(&split_checker);
+        // fields fused into an array of structs are not plain vectors
+        if (!split_checker.splittable()
+            || (schedule_->physical_data_layouts != nullptr
+                && schedule_->physical_data_layouts->find(split_checker.reduce_target)
+                   != schedule_->physical_data_layouts->end()))
+            return false;
+        std::string split_apply_func_name = apply_func_decl->name + "_split_ver";
+        std::string partial_name = split_vertex_name + "_partial";
+        // applies sharing the apply function share the split version (if they split the same vertex)
+        if (mir_context_->isFunction(split_apply_func_name)) {
+            auto partial_arg = mir_context_->split_partial_args.find(split_apply_func_name);
+            if (partial_arg == mir_context_->split_partial_args.end() || partial_arg->second.getName() != partial_name)
+                return false;
+        } else {
+            mir::FuncDecl::Ptr split_apply_func_decl = apply_func_decl->clone<mir::FuncDecl>();
+            split_apply_func_decl->name = split_apply_func_name;
+            mir::Var partial = mir::Var(partial_name, split_checker.reduce_type);
+            auto partial_rewriter = SplitPartialRewriter(partial);
+            split_apply_func_decl->accept(&partial_rewriter);
+            mir_context_->split_partial_args[split_apply_func_name] = partial;
+            mir_context_->addFunctionFront(split_apply_func_decl);
+        }
+        apply->split_apply_func = split_apply_func_name;
+        apply->split_reduce_target = split_checker.reduce_target;
+        return true;
+    }
+
+    void ApplyExprLower::SplitApplyFuncChecker::visit(mir::ReduceStmt::Ptr reduce_stmt) {
+        // only sum and min have atomic versions
+        if (reduce_stmt->reduce_op_ != mir::ReduceStmt::ReductionOp::SUM
+            && reduce_stmt->reduce_op_ != mir::ReduceStmt::ReductionOp::MIN)
+            splittable = false;
+        mir::MIRVisitor::visit(reduce_stmt);
+    }
+
+    void ApplyExprLower::SplitApplyFuncChecker::visit(mir::CompareAndSwapStmt::Ptr) {
+        splittable = false;
+    }
+
+    void ApplyExprLower::SplitApplyFuncChecker::visit(mir::Call::Ptr call) {
+        // user defined functions could update the destination
+        if (call->name.find("builtin_") != 0)
+            splittable = false;
+        mir::MIRVisitor::visit(call);
+    }
+
+    void ApplyExprLower::SplitApplyFuncChecker::visit(mir::PriorityUpdateOperatorMin::Ptr) {
+        splittable = false;
+    }
+
+    void ApplyExprLower::SplitApplyFuncChecker::visit(mir::PriorityUpdateOperatorSum::Ptr) {
+        splittable = false;
+    }
+
+    void ApplyExprLower::SplitPartialApplyFuncChecker::visit(mir::VarDecl::Ptr var_decl) {
+        local_vars_.insert(var_decl->name);
+        mir::MIRVisitor::visit(var_decl);
+    }
+
+    void ApplyExprLower::SplitPartialApplyFuncChecker::visit(mir::AssignStmt::Ptr assign_stmt) {
+        if (!mir::isa<mir::VarExpr>(assign_stmt->lhs)
+            || local_vars_.find(mir::to<mir::VarExpr>(assign_stmt->lhs)->var.getName()) == local_vars_.end())
+            splittable_ = false;
+        mir::MIRVisitor::visit(assign_stmt);
+    }
+
+    void ApplyExprLower::SplitPartialApplyFuncChecker::visit(mir::ReduceStmt::Ptr reduce_stmt) {
+        if (mir::isa<mir::VarExpr>(reduce_stmt->lhs)
+            && local_vars_.find(mir::to<mir::VarExpr>(reduce_stmt->lhs)->var.getName()) != local_vars_.end()) {
+            mir::MIRVisitor::visit(reduce_stmt);
+            return;
+        }
+        // otherwise only sums into target[vertex] of a single vector of scalars
+        bool vertex_sum = false;
+        if (reduce_stmt->reduce_op_ == mir::ReduceStmt::ReductionOp::SUM && mir::isa<mir::TensorReadExpr>(reduce_stmt->lhs)) {
+            auto tensor_read = mir::to<mir::TensorReadExpr>(reduce_stmt->lhs);
+            if (mir::isa<mir::VarExpr>(tensor_read->target) && mir::isa<mir::VarExpr>(tensor_read->index)
+                && mir::to<mir::VarExpr>(tensor_read->index)->var.getName() == vertex_name_) {
+                auto target_var = mir::to<mir::VarExpr>(tensor_read->target)->var;
+                auto vector_type = mir::isa<mir::VectorType>(target_var.getType()) ?
+                                   mir::to<mir::VectorType>(target_var.getType()) : nullptr;
+                if (vector_type != nullptr && mir::isa<mir::ScalarType>(vector_type->vector_element_type)
+                    && (reduce_target == "" || reduce_target == target_var.getName())) {
+                    reduce_target = target_var.getName();
+                    reduce_type = vector_type->vector_element_type;
+                    reduce_target_sums_++;
+                    vertex_sum = true;
+                }
+            }
+        }
+        if (!vertex_sum || reduce_stmt->tracking_var_name_ != "")
+            splittable_ = false;
+        mir::MIRVisitor::visit(reduce_stmt);
+    }
+
+    void ApplyExprLower::SplitPartialApplyFuncChecker::visit(mir::CompareAndSwapStmt::Ptr) {
+        splittable_ = false;
+    }
+
+    void ApplyExprLower::SplitPartialApplyFuncChecker::visit(mir::Call::Ptr call) {
+        // user defined functions could update the split vertex
+        if (call->name.find("builtin_") != 0)
+            splittable_ = false;
+        mir::MIRVisitor::visit(call);
+    }
+
+    void ApplyExprLower::SplitPartialApplyFuncChecker::visit(mir::PriorityUpdateOperatorMin::Ptr) {
+        splittable_ = false;
+    }
+
+    void ApplyExprLower::SplitPartialApplyFuncChecker::visit(mir::PriorityUpdateOperatorSum::Ptr) {
+        splittable_ = false;
+    }
+
+    void ApplyExprLower::SplitPartialApplyFuncChecker::visit(mir::TensorReadExpr::Ptr tensor_read) {
+        if (mir::isa<mir::VarExpr>(tensor_read->target))
+            tensor_reads_[mir::to<mir::VarExpr>(tensor_read->target)->var.getName()]++;
+        mir::MIRVisitor::visit(tensor_read);
+    }
+
+    void ApplyExprLower::SplitPartialRewriter::visit(mir::ReduceStmt::Ptr reduce_stmt) {
+        if (mir::isa<mir::TensorReadExpr>(reduce_stmt->lhs)) {
+            auto partial_expr = std::make_shared<mir::VarExpr>();
+            partial_expr->var = partial_;
+            reduce_stmt->lhs = partial_expr;
+        }
+        mir::MIRVisitor::visit(reduce_stmt);
+    }
+
 }
@@ -0,0 +1,237 @@
+#include <graphit/midend/apply_fusion_lower.h>
+
+namespace graphit {
+
+    void ApplyFusionLower::lower() {
+        auto stmt_block_visitor = StmtBlockVisitor(mir_context_, schedule_);
+        std::vector<mir::FuncDecl::Ptr> functions = mir_context_->getFunctionList();
+        for (auto function : functions) {
+            function->accept(&stmt_block_visitor);
+        }
+    }
+
+    void ApplyFusionLower::StmtBlockVisitor::visit(mir::StmtBlock::Ptr stmt_block) {
+        auto stmts = stmt_block->stmts;
+        for (size_t i = 0; i + 1 < stmts->size(); i++) {
+            if (!mir::isa<mir::ExprStmt>((*stmts)[i]) || !mir::isa<mir::ExprStmt>((*stmts)[i + 1]))
+                continue;
+            auto edge_stmt = mir::to<mir::ExprStmt>((*stmts)[i]);
+            auto edge_expr = edge_stmt->expr;
+            auto vertex_stmt = mir::to<mir::ExprStmt>((*stmts)[i + 1]);
+            auto vertex_expr = vertex_stmt->expr;
+            if (!mir::isa<mir::PullEdgeSetApplyExpr>(edge_expr) || !mir::isa<mir::VertexSetApplyExpr>(vertex_expr))
+                continue;
+
+            auto edge_apply = mir::to<mir::PullEdgeSetApplyExpr>(edge_expr);
+            auto vertex_apply = mir::to<mir::VertexSetApplyExpr>(vertex_expr);
+            auto edge_apply_label = edge_stmt->stmt_label == "" ? "" : label_scope_.tryScope(edge_stmt->stmt_label);
+            auto vertex_apply_label = vertex_stmt->stmt_label == "" ? "" : label_scope_.tryScope(vertex_stmt->stmt_label);
+            if (isFusible(edge_apply, edge_apply_label, vertex_apply, vertex_apply_label)) {
+                edge_apply->fused_vertex_apply_func = vertex_apply->input_function_name;
+                stmts->erase(stmts->begin() + i + 1);
+            }
+        }
+
+        mir::MIRVisitor::visit(stmt_block);
+    }
+
+    bool ApplyFusionLower::StmtBlockVisitor::isFusible(mir::PullEdgeSetApplyExpr::Ptr edge_apply,
+                                                       std::string edge_apply_label,
+                                                       mir::VertexSetApplyExpr::Ptr vertex_apply,
+                                                       std::string vertex_apply_label) {
+        typedef FieldAccessCollector::IndexRole IndexRole;
+
+        if (schedule_ != nullptr && schedule_->apply_schedules != nullptr && edge_apply_label != "") {
+            auto apply_schedule = schedule_->apply_schedules->find(edge_apply_label);
+            if (apply_schedule != schedule_->apply_schedules->end() && !apply_schedule->second.apply_fusion)
+                return false;
+        }
+
+        // the statement of the vertex apply is removed by the fusion, keep it if it has its own schedule
+        if (schedule_ != nullptr && schedule_->apply_schedules != nullptr && vertex_apply_label != ""
+            && schedule_->apply_schedules->find(vertex_apply_label) != schedule_->apply_schedules->end())
+            return false;
+
+        if (edge_apply->fused_vertex_apply_func != "" || !mir::isa<mir::VarExpr>(edge_apply->target)
+            || !mir::isa<mir::VarExpr>(vertex_apply->target))
+            return false;
+
+        // the vertex function has to run on every vertex that is a destination of the edgeset
+        auto vertexset_name = mir::to<mir::VarExpr>(vertex_apply->target)->var.getName();
+        auto edgeset_name = mir::to<mir::VarExpr>(edge_apply->target)->var.getName();
+        if (!mir_context_->isConstVertexSet(vertexset_name) || !mir_context_->isEdgeSet(edgeset_name))
+            return false;
+        auto edgeset_type = mir_context_->getEdgesetType(edgeset_name);
+        if (edgeset_type == nullptr || edgeset_type->vertex_element_type_list == nullptr
+            || edgeset_type->vertex_element_type_list->size() < 2)
+            return false;
+        auto dst_element_type = (*edgeset_type->vertex_element_type_list)[1];
+        if (mir_context_->getElementTypeFromVectorOrSetName(vertexset_name)->ident != dst_element_type->ident)
+            return false;
+
+        // cache and NUMA optimized traversals visit a destination once per segment,
+        // so its reduction is only complete after the merge
+        if (edge_apply->merge_reduce != nullptr && edge_apply->merge_reduce->numa_aware)
+            return false;
+        auto segment_map = mir_context_->edgeset_to_label_to_num_segment;
+        if (segment_map.find(edgeset_name) != segment_map.end()
+            && segment_map[edgeset_name].find(edge_apply->scope_label_name) != segment_map[edgeset_name].end())
+            return false;
+
+        FieldAccessCollector edge_collector(mir_context_, {});
+        if (!collectFieldAccesses(edge_apply->input_function_name, {IndexRole::SRC, IndexRole::DST}, edge_collector))
+            return false;
+        if (edge_apply->from_func != "" && mir_context_->isFunction(edge_apply->from_func)
+            && !collectFieldAccesses(edge_apply->from_func, {IndexRole::SRC}, edge_collector))
+            return false;
+        if (edge_apply->to_func != "" && mir_context_->isFunction(edge_apply->to_func)
+            && !collectFieldAccesses(edge_apply->to_func, {IndexRole::DST}, edge_collector))
+            return false;
+
+        FieldAccessCollector vertex_collector(mir_context_, {});
+        if (!collectFieldAccesses(vertex_apply->input_function_name, {IndexRole::DST}, vertex_collector))
+            return false;
+
+        // the vertex function can only touch the fields of its own vertex
+        for (auto &field : vertex_collector.accessed_fields) {
+            if (field.second != std::set<IndexRole>({IndexRole::DST}))
+                return false;
+        }
+
+        // other destinations must not read what the vertex function writes through their sources
+        for (auto &field : vertex_collector.written_fields) {
+            auto edge_access = edge_collector.accessed_fields.find(field.first);
+            if (edge_access != edge_collector.accessed_fields.end()
+                && edge_access->second != std::set<IndexRole>({IndexRole::DST}))
+                return false;
+        }
+
+        // a field updated through the sources is not final when the destination is done
+        for (auto &field : edge_collector.written_fields) {
+            if (field.second != std::set<IndexRole>({IndexRole::DST})
+                && vertex_collector.accessed_fields.find(field.first) != vertex_collector.accessed_fields.end())
+                return false;
+        }
+
+        return true;
+    }
+
+    bool ApplyFusionLower::StmtBlockVisitor::collectFieldAccesses(std::string func_name,
+                                                                  std::vector<FieldAccessCollector::IndexRole> roles,
+                                                                  FieldAccessCollector &collector) {
+        if (mir_context_->isExternFunction(func_name) || !mir_context_->isFunction(func_name))
+            return false;
+
+        auto func_decl = mir_context_->getFunction(func_name);
+        std::map<std::string, FieldAccessCollector::IndexRole> arg_roles;
+        for (size_t i = 0; i < roles.size() && i < func_decl->args.size(); i++) {
+            arg_roles[func_decl->args[i].getName()] = roles[i];
+        }
+
+        FieldAccessCollector func_collector(mir_context_, arg_roles);
+        func_decl->accept(&func_collector);
+        if (func_collector.has_opaque_call || func_collector.writes_global_var)
+            return false;
+
+        for (auto &field : func_collector.accessed_fields)
+            collector.accessed_fields[field.first].insert(field.second.begin(), field.second.end());
+        for (auto &field : func_collector.written_fields)
+            collector.written_fields[field.first].insert(field.second.begin(), field.second.end());
+        return true;
+    }
+
+    void ApplyFusionLower::FieldAccessCollector::visit(mir::FuncDecl::Ptr func_decl) {
+        for (auto &arg : func_decl->args)
+            local_vars_.insert(arg.getName());
+        if (func_decl->result.isInitialized())
+            local_vars_.insert(func_decl->result.getName());
+        mir::MIRVisitor::visit(func_decl);
+    }
+
+    void ApplyFusionLower::FieldAccessCollector::visit(mir::TensorReadExpr::Ptr tensor_read) {
+        recordAccess(tensor_read);
+        mir::MIRVisitor::visit(tensor_read);
+    }
+
+    void ApplyFusionLower::FieldAccessCollector::visit(mir::TensorArrayReadExpr::Ptr tensor_read) {
+        recordAccess(tensor_read);
+        mir::MIRVisitor::visit(tensor_read);
+    }
+
+    void ApplyFusionLower::FieldAccessCollector::visit(mir::TensorStructReadExpr::Ptr tensor_read) {
+        recordAccess(tensor_read);
+        mir::MIRVisitor::visit(tensor_read);
+    }
+
+    void ApplyFusionLower::FieldAccessCollector::visit(mir::AssignStmt::Ptr assign_stmt) {
+        recordWrite(assign_stmt->lhs);
+        mir::MIRVisitor::visit(assign_stmt);
+    }
+
+    void ApplyFusionLower::FieldAccessCollector::visit(mir::ReduceStmt::Ptr reduce_stmt) {
+        recordWrite(reduce_stmt->lhs);
+        mir::MIRVisitor::visit(reduce_stmt);
+    }
+
+    void ApplyFusionLower::FieldAccessCollector::visit(mir::CompareAndSwapStmt::Ptr cas_stmt) {
+        recordWrite(cas_stmt->lhs);
+        mir::MIRVisitor::visit(cas_stmt);
+    }
+
+    void ApplyFusionLower::FieldAccessCollector::visit(mir::VarDecl::Ptr var_decl) {
+        local_vars_.insert(var_decl->name);
+        mir::MIRVisitor::visit(var_decl);
+    }
+
+    void ApplyFusionLower::FieldAccessCollector::visit(mir::Call::Ptr call) {
+        if (mir_context_->isFunction(call->name) || mir_context_->isExternFunction(call->name))
+            has_opaque_call = true;
+        mir::MIRVisitor::visit(call);
+    }
+
+    void ApplyFusionLower::FieldAccessCollector::recordAccess(mir::TensorReadExpr::Ptr tensor_read) {
+        // nested accesses (e.g. vector[k] fields) are keyed by the innermost index
+        if (getFieldAccess(tensor_read) == tensor_read)
+            accessed_fields[getFieldName(tensor_read)].insert(getIndexRole(tensor_read->index));
+    }
+
+    void ApplyFusionLower::FieldAccessCollector::recordWrite(mir::Expr::Ptr lhs) {
+        auto field_access = getFieldAccess(lhs);
+        if (field_access != nullptr) {
+            written_fields[getFieldName(field_access)].insert(getIndexRole(field_access->index));
+        } else if (mir::isa<mir::VarExpr>(lhs)) {
+            auto var_name = mir::to<mir::VarExpr>(lhs)->var.getName();
+            if (local_vars_.find(var_name) == local_vars_.end())
+                writes_global_var = true;
+        } else {
+            writes_global_var = true;
+        }
+    }
+
+    mir::TensorReadExpr::Ptr ApplyFusionLower::FieldAccessCollector::getFieldAccess(mir::Expr::Ptr expr) {
+        while (mir::isa<mir::TensorReadExpr>(expr)) {
+            auto tensor_read = mir::to<mir::TensorReadExpr>(expr);
+            if (mir::isa<mir::TensorStructReadExpr>(tensor_read) || mir::isa<mir::VarExpr>(tensor_read->target))
+                return tensor_read;
+            expr = tensor_read->target;
+        }
+        return nullptr;
+    }
+
+    std::string ApplyFusionLower::FieldAccessCollector::getFieldName(mir::TensorReadExpr::Ptr tensor_read) {
+        // fields fused into an array of structs are still tracked separately
+        if (mir::isa<mir::TensorStructReadExpr>(tensor_read))
+            return mir::to<mir::VarExpr>(mir::to<mir::TensorStructReadExpr>(tensor_read)->field_target)->var.getName();
+        return mir::to<mir::VarExpr>(tensor_read->target)->var.getName();
+    }
+
+    ApplyFusionLower::FieldAccessCollector::IndexRole
+    ApplyFusionLower::FieldAccessCollector::getIndexRole(mir::Expr::Ptr index) {
+        if (mir::isa<mir::VarExpr>(index)) {
+            auto role = arg_roles_.find(mir::to<mir::VarExpr>(index)->var.getName());
+            if (role != arg_roles_.end())
+                return role->second;
+        }
+        return IndexRole::OTHER;
+    }
+}
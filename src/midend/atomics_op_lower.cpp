@@ -6,6 +6,18 @@
 
 void graphit::AtomicsOpLower::ApplyExprVisitor::visit(graphit::mir::PullEdgeSetApplyExpr::Ptr apply_expr) {
     singleFunctionEdgeSetApplyExprAtomicsLower(apply_expr);
+    // the split version that sums into partials has no shared updates
+    if (apply_expr->is_parallel && apply_expr->split_apply_func != "" && apply_expr->split_reduce_target == ""){
+        mir::FuncDecl::Ptr split_func_decl = mir_context_->getFunction(apply_expr->split_apply_func);
+        ReduceStmtLower reduce_stmt_lower = ReduceStmtLower(mir_context_);
+        split_func_decl->accept(&reduce_stmt_lower);
+        // fall back to processing high degree destinations whole if an update on the destination is still not atomic
+        // (e.g. fields fused into an array of structs or vector properties)
+        auto dst_writes_checker = DstWritesAtomicChecker(split_func_decl->args[1].getName());
+        split_func_decl->accept(&dst_writes_checker);
+        if (!dst_writes_checker.all_atomic)
+            apply_expr->split_apply_func = "";
+    }
 }
 
 void graphit::AtomicsOpLower::ApplyExprVisitor::visit(graphit::mir::PushEdgeSetApplyExpr::Ptr apply_expr) {
@@ -249,3 +261,34 @@ void graphit::AtomicsOpLower::ReduceStmtLower::visit(graphit::mir::ReduceStmt::P
     }
 
 }
+
+void graphit::AtomicsOpLower::DstWritesAtomicChecker::visit(graphit::mir::AssignStmt::Ptr assign_stmt) {
+    if (isIndexedByDst(assign_stmt->lhs))
+        all_atomic = false;
+    mir::MIRVisitor::visit(assign_stmt);
+}
+
+void graphit::AtomicsOpLower::DstWritesAtomicChecker::visit(graphit::mir::ReduceStmt::Ptr reduce_stmt) {
+    if (isIndexedByDst(reduce_stmt->lhs) && !reduce_stmt->is_atomic_)
+        all_atomic = false;
+    mir::MIRVisitor::visit(reduce_stmt);
+}
+
+void graphit::AtomicsOpLower::DstWritesAtomicChecker::visit(graphit::mir::CompareAndSwapStmt::Ptr cas_stmt) {
+    if (isIndexedByDst(cas_stmt->lhs))
+        all_atomic = false;
+    mir::MIRVisitor::visit(cas_stmt);
+}
+
+bool graphit::AtomicsOpLower::DstWritesAtomicChecker::isIndexedByDst(graphit::mir::Expr::Ptr expr) {
+    // also covers nested reads (e.g. vec[dst][i])
+    while (mir::isa<mir::TensorReadExpr>(expr)) {
+        auto index = mir::to<mir::TensorReadExpr>(expr)->index;
+        if (mir::isa<mir::VarExpr>(index) && mir::to<mir::VarExpr>(index)->var.getName() == dst_name_)
+            return true;
+        if (mir::isa<mir::TensorStructReadExpr>(expr))
+            return false;
+        expr = mir::to<mir::TensorReadExpr>(expr)->target;
+    }
+    return false;
+}
@@ -12,10 +12,123 @@ namespace graphit {
         for (auto function : functions) {
             function->accept(&apply_expr_visitor);
         }
+        lowerSparseResets();
+    }
+
+    /**
+     * A vertexset apply scheduled as a sparse reset only visits the vertices whose restored fields were written
+     * since it last ran. Every write to those fields records the written vertex in a touched vertices set, which
+     * falls back to visiting every vertex once too many were written (and on the first run, as the values before it
+     * are not known). The reset function has to assign constants to the fields of its vertex, so that a vertex
+     * that was not written already holds the values it would restore. If a field can be written without naming
+     * the vertex, the apply keeps visiting every vertex.
+     */
+    void ChangeTrackingLower::lowerSparseResets() {
+        std::vector<mir::FuncDecl::Ptr> functions = mir_context_->getFunctionList();
+        auto sparse_reset_visitor = SparseResetApplyVisitor();
+        for (auto function : functions) {
+            function->accept(&sparse_reset_visitor);
+        }
+        if (sparse_reset_visitor.sparse_reset_applies.empty())
+            return;
+
+        auto untracked_write_visitor = UntrackedWriteVisitor(mir_context_);
+        for (auto function : functions) {
+            function->accept(&untracked_write_visitor);
+        }
+        // extern functions can write the fields directly
+        bool has_extern_functions = !mir_context_->getExternFunctionList().empty();
+        // the runtime updates the priorities of the constant sum and extern priority updates
+        if (!mir_context_->priority_queue_alloc_list_.empty()
+            && (mir_context_->priority_update_type == mir::PriorityUpdateType::ConstSumReduceBeforePriorityUpdate
+                || mir_context_->priority_update_type == mir::PriorityUpdateType::EagerConstSumReduceBeforePriorityUpdate
+                || mir_context_->priority_update_type == mir::PriorityUpdateType::ExternPriorityUpdate)) {
+            untracked_write_visitor.untracked_fields.insert(mir_context_->getPriorityVectorName());
+        }
+
+        std::map<std::string, std::vector<std::string>> field_to_touched_sets;
+        std::set<std::string> unrecorded_functions;
+        for (auto apply_expr : sparse_reset_visitor.sparse_reset_applies) {
+            auto target_name = mir::to<mir::VarExpr>(apply_expr->target)->var.getName();
+            if (has_extern_functions || !mir_context_->isConstVertexSet(target_name)
+                || mir_context_->isExternFunction(apply_expr->input_function_name))
+                continue;
+            auto reset_fields = getResetFields(mir_context_->getFunction(apply_expr->input_function_name));
+            bool trackable = !reset_fields.empty();
+            for (auto field : reset_fields) {
+                if (untracked_write_visitor.untracked_fields.count(field) != 0)
+                    trackable = false;
+            }
+            if (!trackable)
+                continue;
+
+            auto touched_vertices_set = std::make_shared<mir::TouchedVerticesSet>();
+            touched_vertices_set->name = "touched_vertices" + mir_context_->getUniqueNameCounterString();
+            touched_vertices_set->element_type = mir_context_->getElementTypeFromVectorOrSetName(target_name);
+            touched_vertices_set->dense_fraction = apply_expr->sparse_reset_dense_fraction;
+            mir_context_->touched_vertices_sets.push_back(touched_vertices_set);
+            apply_expr->touched_vertices_name = touched_vertices_set->name;
+            for (auto field : reset_fields) {
+                field_to_touched_sets[field].push_back(touched_vertices_set->name);
+            }
+            unrecorded_functions.insert(apply_expr->input_function_name);
+        }
+
+        // the writes of the reset functions restore the values, and the field vectors are initialized before any
+        // reset (the touched vertices sets start with every vertex), so neither needs to be recorded
+        for (auto stmt : mir_context_->field_vector_init_stmts) {
+            if (mir::isa<mir::ExprStmt>(stmt) && mir::isa<mir::VertexSetApplyExpr>(mir::to<mir::ExprStmt>(stmt)->expr))
+                unrecorded_functions.insert(mir::to<mir::VertexSetApplyExpr>(mir::to<mir::ExprStmt>(stmt)->expr)->input_function_name);
+        }
+        auto touched_vertex_record_visitor = TouchedVertexRecordVisitor(mir_context_, field_to_touched_sets);
+        for (auto function : functions) {
+            if (unrecorded_functions.count(function->name) == 0)
+                function->accept(&touched_vertex_record_visitor);
+        }
+    }
+
+    std::vector<std::string> ChangeTrackingLower::getResetFields(mir::FuncDecl::Ptr reset_func_decl) {
+        std::vector<std::string> reset_fields;
+        if (reset_func_decl->args.size() != 1 || reset_func_decl->result.isInitialized()
+            || reset_func_decl->body == nullptr || reset_func_decl->body->stmts == nullptr)
+            return std::vector<std::string>();
+        auto vertex_name = reset_func_decl->args[0].getName();
+
+        for (auto stmt : *(reset_func_decl->body->stmts)) {
+            // only plain assignments (the reductions and CAS are subclasses)
+            if (!mir::isa<mir::AssignStmt>(stmt) || mir::isa<mir::ReduceStmt>(stmt)
+                || mir::isa<mir::CompareAndSwapStmt>(stmt))
+                return std::vector<std::string>();
+            auto assign_stmt = mir::to<mir::AssignStmt>(stmt);
+
+            mir::Expr::Ptr field_expr = nullptr;
+            if (mir::isa<mir::TensorStructReadExpr>(assign_stmt->lhs)) {
+                field_expr = mir::to<mir::TensorStructReadExpr>(assign_stmt->lhs)->field_target;
+            } else if (mir::isa<mir::TensorReadExpr>(assign_stmt->lhs)) {
+                field_expr = mir::to<mir::TensorReadExpr>(assign_stmt->lhs)->target;
+            }
+            if (field_expr == nullptr || !mir::isa<mir::VarExpr>(field_expr))
+                return std::vector<std::string>();
+            auto index_expr = mir::to<mir::TensorReadExpr>(assign_stmt->lhs)->index;
+            if (!mir::isa<mir::VarExpr>(index_expr) || mir::to<mir::VarExpr>(index_expr)->var.getName() != vertex_name)
+                return std::vector<std::string>();
+
+            auto value_expr = assign_stmt->expr;
+            if (mir::isa<mir::NegExpr>(value_expr))
+                value_expr = mir::to<mir::NegExpr>(value_expr)->operand;
+            if (!mir::isa<mir::IntLiteral>(value_expr) && !mir::isa<mir::FloatLiteral>(value_expr)
+                && !mir::isa<mir::BoolLiteral>(value_expr))
+                return std::vector<std::string>();
+
+            reset_fields.push_back(mir::to<mir::VarExpr>(field_expr)->var.getName());
+        }
+        return reset_fields;
     }
 
     void ChangeTrackingLower::ApplyExprVisitor::visit(mir::PullEdgeSetApplyExpr::Ptr apply_expr) {
         processSingleFunctionApplyExpr(apply_expr->input_function_name, apply_expr->tracking_field);
+        if (apply_expr->split_apply_func != "")
+            processSingleFunctionApplyExpr(apply_expr->split_apply_func, apply_expr->tracking_field);
     }
 
     void ChangeTrackingLower::ApplyExprVisitor::visit(mir::PushEdgeSetApplyExpr::Ptr apply_expr) {
@@ -200,4 +313,134 @@ namespace graphit {
     }
 
 
+
+    void ChangeTrackingLower::SparseResetApplyVisitor::visit(mir::VertexSetApplyExpr::Ptr apply_expr) {
+        if (apply_expr->sparse_reset)
+            sparse_reset_applies.push_back(apply_expr);
+    }
+
+
+    void ChangeTrackingLower::UntrackedWriteVisitor::visit(mir::TensorArrayReadExpr::Ptr tensor_read) {
+        // reading or writing a single element names the vertex
+        if (mir::isa<mir::VarExpr>(tensor_read->target)) {
+            tensor_read->index->accept(this);
+        } else {
+            mir::MIRVisitor::visit(tensor_read);
+        }
+    }
+
+    void ChangeTrackingLower::UntrackedWriteVisitor::visit(mir::TensorStructReadExpr::Ptr tensor_read) {
+        tensor_read->index->accept(this);
+        if (!mir::isa<mir::VarExpr>(tensor_read->field_target))
+            tensor_read->field_target->accept(this);
+    }
+
+    void ChangeTrackingLower::UntrackedWriteVisitor::visit(mir::VarExpr::Ptr var_expr) {
+        untracked_fields.insert(var_expr->var.getName());
+    }
+
+    // returns the writeMin call if the expression is one on a field vector, writeMin(field, vertex, value) is
+    // recorded when it is a whole statement or initializes a variable, other uses of the field are untracked
+    static mir::Call::Ptr getFieldWriteMin(mir::Expr::Ptr expr) {
+        if (expr == nullptr || !mir::isa<mir::Call>(expr))
+            return nullptr;
+        auto call_expr = mir::to<mir::Call>(expr);
+        if (call_expr->name != "writeMin" || call_expr->args.size() != 3 || !mir::isa<mir::VarExpr>(call_expr->args[0]))
+            return nullptr;
+        return call_expr;
+    }
+
+    void ChangeTrackingLower::UntrackedWriteVisitor::visit(mir::ExprStmt::Ptr expr_stmt) {
+        auto write_min = getFieldWriteMin(expr_stmt->expr);
+        if (write_min != nullptr) {
+            write_min->args[1]->accept(this);
+            write_min->args[2]->accept(this);
+        } else {
+            mir::MIRVisitor::visit(expr_stmt);
+        }
+    }
+
+    void ChangeTrackingLower::UntrackedWriteVisitor::visit(mir::AssignStmt::Ptr assign_stmt) {
+        auto write_min = getFieldWriteMin(assign_stmt->expr);
+        if (write_min != nullptr) {
+            assign_stmt->lhs->accept(this);
+            write_min->args[1]->accept(this);
+            write_min->args[2]->accept(this);
+        } else {
+            mir::MIRVisitor::visit(assign_stmt);
+        }
+    }
+
+    void ChangeTrackingLower::UntrackedWriteVisitor::visit(mir::VarDecl::Ptr var_decl) {
+        auto write_min = getFieldWriteMin(var_decl->initVal);
+        if (write_min != nullptr) {
+            write_min->args[1]->accept(this);
+            write_min->args[2]->accept(this);
+        } else {
+            mir::MIRVisitor::visit(var_decl);
+        }
+    }
+
+
+    void ChangeTrackingLower::TouchedVertexRecordVisitor::visit(mir::StmtBlock::Ptr stmt_block) {
+        auto stmts = new std::vector<mir::Stmt::Ptr>();
+        for (auto stmt : *(stmt_block->stmts)) {
+            // records the writes in the nested stmt blocks
+            stmt->accept(this);
+            stmts->push_back(stmt);
+            for (auto write : getWrites(stmt)) {
+                if (field_to_touched_sets_.find(write.first) == field_to_touched_sets_.end())
+                    continue;
+                for (auto touched_vertices_name : field_to_touched_sets_[write.first]) {
+                    auto touched_vertices_expr = std::make_shared<mir::VarExpr>();
+                    touched_vertices_expr->var = mir::Var(touched_vertices_name, nullptr);
+                    auto touch_call = std::make_shared<mir::Call>();
+                    touch_call->name = "builtin_touchVertex";
+                    touch_call->args.push_back(touched_vertices_expr);
+                    touch_call->args.push_back(write.second);
+                    auto touch_stmt = std::make_shared<mir::ExprStmt>();
+                    touch_stmt->expr = touch_call;
+                    stmts->push_back(touch_stmt);
+                }
+            }
+        }
+        stmt_block->stmts = stmts;
+    }
+
+    std::vector<std::pair<std::string, mir::Expr::Ptr>>
+    ChangeTrackingLower::TouchedVertexRecordVisitor::getWrites(mir::Stmt::Ptr stmt) {
+        std::vector<std::pair<std::string, mir::Expr::Ptr>> writes;
+        mir::Call::Ptr write_min = nullptr;
+        if (mir::isa<mir::AssignStmt>(stmt)) {
+            // also the reductions and CAS
+            auto assign_stmt = mir::to<mir::AssignStmt>(stmt);
+            if (mir::isa<mir::TensorStructReadExpr>(assign_stmt->lhs)) {
+                auto tensor_read = mir::to<mir::TensorStructReadExpr>(assign_stmt->lhs);
+                if (mir::isa<mir::VarExpr>(tensor_read->field_target))
+                    writes.push_back(std::make_pair(mir::to<mir::VarExpr>(tensor_read->field_target)->var.getName(),
+                                                    tensor_read->index));
+            } else if (mir::isa<mir::TensorReadExpr>(assign_stmt->lhs)) {
+                auto tensor_read = mir::to<mir::TensorReadExpr>(assign_stmt->lhs);
+                if (mir::isa<mir::VarExpr>(tensor_read->target))
+                    writes.push_back(std::make_pair(mir::to<mir::VarExpr>(tensor_read->target)->var.getName(),
+                                                    tensor_read->index));
+            }
+            write_min = getFieldWriteMin(assign_stmt->expr);
+        } else if (mir::isa<mir::ExprStmt>(stmt)) {
+            auto expr = mir::to<mir::ExprStmt>(stmt)->expr;
+            if (mir::isa<mir::PriorityUpdateOperator>(expr) && !mir_context_->priority_queue_alloc_list_.empty()) {
+                // priority updates write the priority vector of the destination node
+                writes.push_back(std::make_pair(mir_context_->getPriorityVectorName(),
+                                                mir::to<mir::PriorityUpdateOperator>(expr)->destination_node_id));
+            }
+            write_min = getFieldWriteMin(expr);
+        } else if (mir::isa<mir::VarDecl>(stmt)) {
+            write_min = getFieldWriteMin(mir::to<mir::VarDecl>(stmt)->initVal);
+        }
+        if (write_min != nullptr)
+            writes.push_back(std::make_pair(mir::to<mir::VarExpr>(write_min->args[0])->var.getName(),
+                                            write_min->args[1]));
+        return writes;
+    }
+
 }
\ No newline at end of file
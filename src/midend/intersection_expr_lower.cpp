@@ -13,6 +13,51 @@ namespace graphit {
             lower_intersection_expr.rewrite(function);
         }
 
+        // getNgh results that only feed intersections do not need a vertexset
+        for (auto function : functions) {
+            NeighborViewFinder finder;
+            function->accept(&finder);
+            for (auto decl : finder.ngh_decls) {
+                if (finder.uses[decl.first] != finder.intersection_uses[decl.first])
+                    continue;
+                decl.second->neighbor_view = true;
+                mir::to<mir::Call>(decl.second->initVal)->name = "builtin_getNghView";
+            }
+            for (auto call : finder.intersection_calls) {
+                call->name = "builtin_getNghView";
+            }
+        }
+    }
+
+    // true for edges.getNgh(v) on an unweighted edgeset (neighbors of a weighted edgeset are not plain vertex ids)
+    static bool isUnweightedGetNgh(mir::Expr::Ptr expr) {
+        if (!mir::isa<mir::Call>(expr))
+            return false;
+        auto call = mir::to<mir::Call>(expr);
+        if (call->name != "builtin_getNgh" || call->args.empty() || !mir::isa<mir::VarExpr>(call->args[0]))
+            return false;
+        auto edgeset_type = mir::to<mir::VarExpr>(call->args[0])->var.getType();
+        return mir::isa<mir::EdgeSetType>(edgeset_type) && mir::to<mir::EdgeSetType>(edgeset_type)->weight_type == nullptr;
+    }
+
+    void IntersectionExprLower::NeighborViewFinder::visit(mir::VarDecl::Ptr var_decl) {
+        if (var_decl->initVal != nullptr && isUnweightedGetNgh(var_decl->initVal))
+            ngh_decls[var_decl->name] = var_decl;
+        mir::MIRVisitor::visit(var_decl);
+    }
+
+    void IntersectionExprLower::NeighborViewFinder::visit(mir::VarExpr::Ptr var_expr) {
+        uses[var_expr->var.getName()]++;
+    }
+
+    void IntersectionExprLower::NeighborViewFinder::visit(mir::IntersectionExpr::Ptr intersection_expr) {
+        for (auto operand : {intersection_expr->vertex_a, intersection_expr->vertex_b}) {
+            if (mir::isa<mir::VarExpr>(operand))
+                intersection_uses[mir::to<mir::VarExpr>(operand)->var.getName()]++;
+            else if (isUnweightedGetNgh(operand))
+                intersection_calls.push_back(mir::to<mir::Call>(operand));
+        }
+        mir::MIRVisitor::visit(intersection_expr);
     }
 
     void IntersectionExprLower::LowerIntersectionExpr::visit(mir::IntersectionExpr::Ptr intersection_expr) {
@@ -26,6 +71,11 @@ namespace graphit {
                 //if a schedule for the statement has been found
                 intersection_expr->intersectionType = intersection_schedule->second;
             }
+            if (schedule_->intersection_params != nullptr) {
+                auto intersection_params = schedule_->intersection_params->find(current_scope_name);
+                if (intersection_params != schedule_->intersection_params->end())
+                    intersection_expr->intersectionParams = intersection_params->second;
+            }
         }
         node = intersection_expr;
 
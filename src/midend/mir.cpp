@@ -152,6 +152,7 @@ namespace graphit {
                 reference = expr->reference->clone<Expr>();
             }
             intersectionType = expr->intersectionType;
+            intersectionParams = expr->intersectionParams;
 
         }
 
@@ -195,6 +196,9 @@ namespace graphit {
         void VertexSetApplyExpr::copy(MIRNode::Ptr node) {
             const auto expr = to<VertexSetApplyExpr>(node);
             ApplyExpr::copy(expr);
+            sparse_reset = expr->sparse_reset;
+            sparse_reset_dense_fraction = expr->sparse_reset_dense_fraction;
+            touched_vertices_name = expr->touched_vertices_name;
         }
 
 
@@ -546,6 +550,8 @@ namespace graphit {
 
         void Stmt::copy(MIRNode::Ptr node) {
             auto stmt = to<mir::Stmt>(node);
+            // the schedules of the statements of a cloned function are found through the labels
+            stmt_label = stmt->stmt_label;
         }
 
 
@@ -671,10 +677,13 @@ namespace graphit {
         }
 
         void ForStmt::copy(MIRNode::Ptr node) {
+            Stmt::copy(node);
             auto for_node = to<mir::ForStmt>(node);
             loopVar = for_node->loopVar;
             domain = for_node->domain->clone<ForDomain>();
             body = for_node->body->clone<StmtBlock>();
+            simd_vectorizable = for_node->simd_vectorizable;
+            simd_reduction_vars = for_node->simd_reduction_vars;
         }
 
 
@@ -685,6 +694,7 @@ namespace graphit {
         }
 
         void WhileStmt::copy(MIRNode::Ptr node) {
+            Stmt::copy(node);
             auto while_stmt = to<mir::WhileStmt>(node);
             cond = while_stmt->cond->clone<Expr>();
             body = while_stmt->body->clone<StmtBlock>();
@@ -698,6 +708,7 @@ namespace graphit {
         }
 
         void ExprStmt::copy(MIRNode::Ptr node) {
+            Stmt::copy(node);
             auto expr_stmt = to<mir::ExprStmt>(node);
             expr = expr_stmt->expr->clone<Expr>();
         }
@@ -710,6 +721,7 @@ namespace graphit {
         }
 
         void AssignStmt::copy(MIRNode::Ptr node) {
+            Stmt::copy(node);
             auto expr_stmt = to<mir::AssignStmt>(node);
             expr = expr_stmt->expr->clone<Expr>();
             lhs = expr_stmt->lhs->clone<Expr>();
@@ -723,6 +735,7 @@ namespace graphit {
         }
 
         void ReduceStmt::copy(MIRNode::Ptr node) {
+            Stmt::copy(node);
             auto stmt = to<mir::ReduceStmt>(node);
             expr = stmt->expr->clone<Expr>();
             lhs = stmt->lhs->clone<Expr>();
@@ -777,6 +790,7 @@ namespace graphit {
 
 
         void IfStmt::copy(MIRNode::Ptr node) {
+            Stmt::copy(node);
             auto stmt = to<mir::IfStmt>(node);
             cond = stmt->cond->clone<Expr>();
             ifBody = stmt->ifBody->clone<Stmt>();
@@ -806,11 +820,13 @@ namespace graphit {
 
 
         void VarDecl::copy(MIRNode::Ptr node) {
+            Stmt::copy(node);
             auto decl = to<VarDecl>(node);
             type = decl->type->clone<Type>();
             initVal = decl->initVal->clone<Expr>();
             modifier = decl->modifier;
             name = decl->name;
+            neighbor_view = decl->neighbor_view;
         }
 
 
@@ -947,6 +963,10 @@ namespace graphit {
             priority_queue_name = op->priority_queue_name;
             priority_udpate_type = op->priority_udpate_type;
             merge_threshold = op->merge_threshold;
+            relaxation_factor = op->relaxation_factor;
+            frontier_size_stmts = op->frontier_size_stmts;
+            frontier_size_var = op->frontier_size_var;
+            source_filter_func = op->source_filter_func;
         }
 
         MIRNode::Ptr OrderedProcessingOperator::cloneNode() {
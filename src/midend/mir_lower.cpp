@@ -13,6 +13,8 @@
 #include <graphit/midend/vertex_edge_set_lower.h>
 #include <graphit/midend/merge_reduce_lower.h>
 #include <graphit/midend/priority_features_lowering.h>
+#include <graphit/midend/apply_fusion_lower.h>
+#include <graphit/midend/simd_loop_lower.h>
 
 namespace graphit {
     /**
@@ -43,7 +45,7 @@ namespace graphit {
         ApplyExprLower(mir_context, schedule).lower();
 
         // This pass sets properties of intersection operations based on scheduling languages.
-        // intersection types: HiroshiIntersection, Naive, Multiskip, Binary, Combined
+        // intersection types: HiroshiIntersection, Naive, Multiskip, Binary, Combined, SIMD, HubBitmap
         // If there is no schedule specified, it just chooses naive intersection.
         IntersectionExprLower(mir_context, schedule).lower();
 
@@ -68,6 +70,15 @@ namespace graphit {
         // This pass extracts the merge field and reduce operator. If numa_aware is set to true in
         // the schedule for the corresponding label, it also adds NUMA optimization
         MergeReduceLower(mir_context, schedule).lower();
+
+        // This pass fuses a pull edgeset apply with the vertexset apply that follows it, so the vertex
+        // function runs on each destination right after its in edges are processed.
+        // It needs the NUMA and cache segmenting decisions made by the passes above
+        ApplyFusionLower(mir_context, schedule).lower();
+
+        // This pass marks the loops over fixed size vector properties (e.g. dot products in collaborative filtering)
+        // that are generated as SIMD loops. It runs last so that it sees the final atomics and tracking variables
+        SimdLoopLower(mir_context).lower();
     }
 }
 
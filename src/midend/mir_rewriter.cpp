@@ -387,6 +387,9 @@ namespace graphit {
         void MIRRewriter::visit(std::shared_ptr<OrderedProcessingOperator> op) {
             assert(op->while_cond_expr != nullptr);
             op->while_cond_expr = rewrite<Expr>(op->while_cond_expr);
+            for (auto &stmt : op->frontier_size_stmts) {
+                stmt = rewrite<Stmt>(stmt);
+            }
             node = op;
         }
 
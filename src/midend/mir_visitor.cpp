@@ -354,6 +354,9 @@ namespace graphit {
 
         void MIRVisitor::visit(std::shared_ptr<OrderedProcessingOperator> op) {
             op->while_cond_expr->accept(this);
+            for (auto stmt : op->frontier_size_stmts) {
+                stmt->accept(this);
+            }
         }
 
         void MIRVisitor::visit(std::shared_ptr<PriorityUpdateOperator> op) {
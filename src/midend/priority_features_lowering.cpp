@@ -61,6 +61,39 @@ namespace graphit {
             lower_priority_update_rewriter.rewrite(function);
         }
 
+        // the updates lowered by the compiler clamp priorities at the current priority, which assumes that a bucket
+        // holds a single priority. Only extern updates, which see the bucket bounds, can use approximate buckets
+        if (mir_context_->bucket_epsilon_ > 0
+            && (mir_context_->priority_update_type != mir::PriorityUpdateType::ExternPriorityUpdate
+                || mir_context_->bucket_backend_type != mir::BucketBackendType::OpenBuckets
+                || mir_context_->delta_ != 1)) {
+            std::cout << "approximate buckets are only supported for extern priority updates "
+                         "with open buckets and a delta of 1" << std::endl;
+            exit(0);
+        }
+
+        // the bucket backends are only implemented by the lazy (julienne) priority queue
+        if (mir_context_->bucket_backend_type != mir::BucketBackendType::OpenBuckets
+            && (mir_context_->priority_update_type == mir::PriorityUpdateType::EagerPriorityUpdate
+                || mir_context_->priority_update_type == mir::PriorityUpdateType::EagerPriorityUpdateWithMerge
+                || mir_context_->priority_update_type == mir::PriorityUpdateType::RelaxedMultiQueuePriorityUpdate
+                || mir_context_->priority_update_type
+                   == mir::PriorityUpdateType::EagerConstSumReduceBeforePriorityUpdate)) {
+            std::cout << "radix_heap_buckets and two_level_buckets are only supported by the lazy priority queue, "
+                         "not by eager priority updates" << std::endl;
+            exit(0);
+        }
+
+        // only the eager OrderedProcessingOperators filter the nodes of their frontier
+        if (mir_context_->ordered_processing_source_filter_func != ""
+            && mir_context_->priority_update_type != mir::PriorityUpdateType::EagerPriorityUpdate
+            && mir_context_->priority_update_type != mir::PriorityUpdateType::EagerPriorityUpdateWithMerge
+            && mir_context_->priority_update_type != mir::PriorityUpdateType::RelaxedMultiQueuePriorityUpdate) {
+            std::cout << "source filters are only supported by eager_priority_update, "
+                         "eager_priority_update_with_merge and relaxed_multiqueue" << std::endl;
+            exit(0);
+        }
+
         //lowers for the ReduceBeforeUpdate default schedule
         if (mir_context_->priority_update_type == mir::PriorityUpdateType::ReduceBeforePriorityUpdate) {
             auto lower_reduce_before_update = LowerReduceBeforePriorityUpdate(schedule_, mir_context_);
@@ -94,6 +127,23 @@ namespace graphit {
                 mir_context_->delta_ = apply_schedule->second.delta;
             }
 
+            if (apply_schedule->second.bucket_backend == ApplySchedule::BucketBackend::RADIX_HEAP) {
+                mir_context_->bucket_backend_type = mir::BucketBackendType::RadixHeapBuckets;
+            } else if (apply_schedule->second.bucket_backend == ApplySchedule::BucketBackend::TWO_LEVEL_BUCKETS) {
+                mir_context_->bucket_backend_type = mir::BucketBackendType::TwoLevelBuckets;
+            }
+
+            mir_context_->bucket_epsilon_ = apply_schedule->second.bucket_epsilon;
+
+            if (apply_schedule->second.source_filter_func != "") {
+                if (!mir_context_->isFunction(apply_schedule->second.source_filter_func)) {
+                    std::cout << "source filter is not a function: "
+                              << apply_schedule->second.source_filter_func << std::endl;
+                    exit(0);
+                }
+                mir_context_->ordered_processing_source_filter_func = apply_schedule->second.source_filter_func;
+            }
+
 
             if (apply_schedule->second.priority_update_type
                 == ApplySchedule::PriorityUpdateType::REDUCTION_BEFORE_UPDATE) {
@@ -102,17 +152,28 @@ namespace graphit {
             } else if (apply_schedule->second.priority_update_type
                        == ApplySchedule::PriorityUpdateType::EAGER_PRIORITY_UPDATE) {
                 mir_context_->priority_update_type = mir::PriorityUpdateType::EagerPriorityUpdate;
+                mir_context_->num_open_buckets = apply_schedule->second.num_open_buckets;
             } else if (apply_schedule->second.priority_update_type
                        == ApplySchedule::PriorityUpdateType::CONST_SUM_REDUCTION_BEFORE_UPDATE) {
                 mir_context_->priority_update_type = mir::PriorityUpdateType::ConstSumReduceBeforePriorityUpdate;
                 mir_context_->num_open_buckets = apply_schedule->second.num_open_buckets;
+            } else if (apply_schedule->second.priority_update_type
+                       == ApplySchedule::PriorityUpdateType::EAGER_CONST_SUM_REDUCTION_BEFORE_UPDATE) {
+                mir_context_->priority_update_type = mir::PriorityUpdateType::EagerConstSumReduceBeforePriorityUpdate;
+                mir_context_->num_open_buckets = apply_schedule->second.num_open_buckets;
+                mir_context_->bucket_merge_threshold_ = apply_schedule->second.merge_threshold;
             } else if (apply_schedule->second.priority_update_type
                        == ApplySchedule::PriorityUpdateType::EAGER_PRIORITY_UPDATE_WITH_MERGE) {
                 mir_context_->priority_update_type = mir::PriorityUpdateType::EagerPriorityUpdateWithMerge;
+                mir_context_->num_open_buckets = apply_schedule->second.num_open_buckets;
 
                 if (apply_schedule->second.merge_threshold != 0) {
                     mir_context_->bucket_merge_threshold_ = apply_schedule->second.merge_threshold;
                 }
+            } else if (apply_schedule->second.priority_update_type
+                       == ApplySchedule::PriorityUpdateType::RELAXED_MULTIQUEUE) {
+                mir_context_->priority_update_type = mir::PriorityUpdateType::RelaxedMultiQueuePriorityUpdate;
+                mir_context_->relaxation_factor_ = apply_schedule->second.relaxation_factor;
             } else {
                 mir_context_->priority_update_type = mir::PriorityUpdateType::NoPriorityUpdate;
             }
@@ -163,9 +224,9 @@ namespace graphit {
             ordered_op->while_cond_expr = while_stmt->cond;
             //get the UpdatePriorityEdgesetApply label, for retrieving the schedule
             auto stmt_blk = while_stmt->body;
-            mir::Stmt::Ptr first_stmt = (*(stmt_blk->stmts))[0];
-            mir::Stmt::Ptr second_stmt = (*(stmt_blk->stmts))[1];
-            mir::ExprStmt::Ptr expr_stmt = mir::to<mir::ExprStmt>(second_stmt);
+            auto frontier_size_stmts = getFrontierSizeStmts(while_stmt);
+            mir::Stmt::Ptr apply_stmt = (*(stmt_blk->stmts))[1 + frontier_size_stmts.size()];
+            mir::ExprStmt::Ptr expr_stmt = mir::to<mir::ExprStmt>(apply_stmt);
             auto update_priority_edgesetapply_expr = mir::to<mir::UpdatePriorityEdgeSetApplyExpr>(expr_stmt->expr);
             auto edge_update_func_name = update_priority_edgesetapply_expr->input_function_name;
 
@@ -178,14 +239,35 @@ namespace graphit {
             //auto priority_queue_name;
             std::string priority_queue_name = mir_context_->getPriorityQueueDecl()->name;
             ordered_op->priority_queue_name = priority_queue_name;
-            ordered_op->optional_source_node = mir_context_->optional_starting_source_node;
+            // nodes initialized in the buckets are all in the first frontier, there is no single source node
+            if (!mir_context_->nodes_init_in_buckets) {
+                ordered_op->optional_source_node = mir_context_->optional_starting_source_node;
+            }
 
             if (mir_context_->priority_update_type == mir::PriorityUpdateType::EagerPriorityUpdateWithMerge) {
                 ordered_op->priority_udpate_type = mir::PriorityUpdateType::EagerPriorityUpdateWithMerge;
                 ordered_op->bucket_merge_threshold = mir_context_->bucket_merge_threshold_;
+            } else if (mir_context_->priority_update_type == mir::PriorityUpdateType::RelaxedMultiQueuePriorityUpdate) {
+                ordered_op->priority_udpate_type = mir::PriorityUpdateType::RelaxedMultiQueuePriorityUpdate;
+                ordered_op->relaxation_factor = mir_context_->relaxation_factor_;
+            } else if (mir_context_->priority_update_type
+                       == mir::PriorityUpdateType::EagerConstSumReduceBeforePriorityUpdate) {
+                ordered_op->priority_udpate_type = mir::PriorityUpdateType::EagerConstSumReduceBeforePriorityUpdate;
+                ordered_op->bucket_merge_threshold = mir_context_->bucket_merge_threshold_;
+                // the operator reports the number of nodes it processes in each step through frontier_size_var
+                ordered_op->frontier_size_var = "__frontier_size";
+                auto size_type = std::make_shared<mir::ScalarType>();
+                size_type->type = mir::ScalarType::Type::INT;
+                for (auto stmt : frontier_size_stmts) {
+                    auto frontier_size_expr = std::make_shared<mir::VarExpr>();
+                    frontier_size_expr->var = mir::Var(ordered_op->frontier_size_var, size_type);
+                    mir::to<mir::AssignStmt>(stmt)->expr = frontier_size_expr;
+                    ordered_op->frontier_size_stmts.push_back(stmt);
+                }
             } else {
                 ordered_op->priority_udpate_type = mir::PriorityUpdateType::EagerPriorityUpdate;
             }
+            ordered_op->source_filter_func = mir_context_->ordered_processing_source_filter_func;
 
 
             //use the schedule to set
@@ -206,14 +288,15 @@ namespace graphit {
             mir::WhileStmt::Ptr while_stmt) {
         auto stmt_blk = while_stmt->body;
         int num_stmts = (*(stmt_blk->stmts)).size();
+        int num_frontier_size_stmts = getFrontierSizeStmts(while_stmt).size();
 
         // for now assuming
-        if (num_stmts < 2 || num_stmts > 3) {
+        if (num_stmts < 2 + num_frontier_size_stmts || num_stmts > 3 + num_frontier_size_stmts) {
             return false;
         }
 
         mir::Stmt::Ptr first_stmt = (*(stmt_blk->stmts))[0];
-        mir::Stmt::Ptr second_stmt = (*(stmt_blk->stmts))[1];
+        mir::Stmt::Ptr second_stmt = (*(stmt_blk->stmts))[1 + num_frontier_size_stmts];
 
 
         if (mir::isa<mir::VarDecl>(first_stmt)) {
@@ -231,6 +314,34 @@ namespace graphit {
         return false;
     }
 
+    // With the constant sum schedule on the GAPBS graph, the frontier can also be counted before the apply
+    //"    finished += frontier.getVertexSetSize(); "
+    // the operator processes the frontier in several steps, and runs these statements with the size of each step
+
+    std::vector<mir::Stmt::Ptr> PriorityFeaturesLower::LowerIntoOrderedProcessingOperatorRewriter::getFrontierSizeStmts(
+            mir::WhileStmt::Ptr while_stmt) {
+        std::vector<mir::Stmt::Ptr> frontier_size_stmts;
+        auto stmts = while_stmt->body->stmts;
+        if (mir_context_->priority_update_type != mir::PriorityUpdateType::EagerConstSumReduceBeforePriorityUpdate
+            || stmts->empty() || !mir::isa<mir::VarDecl>((*stmts)[0])) {
+            return frontier_size_stmts;
+        }
+        std::string frontier_name = mir::to<mir::VarDecl>((*stmts)[0])->name;
+        for (size_t i = 1; i < stmts->size(); i++) {
+            if (!mir::isa<mir::ReduceStmt>((*stmts)[i]))
+                break;
+            auto reduce_stmt = mir::to<mir::ReduceStmt>((*stmts)[i]);
+            if (reduce_stmt->reduce_op_ != mir::ReduceStmt::ReductionOp::SUM || !mir::isa<mir::Call>(reduce_stmt->expr))
+                break;
+            auto call = mir::to<mir::Call>(reduce_stmt->expr);
+            if (call->name != "builtin_getVertexSetSize" || call->args.size() != 1 || !mir::isa<mir::VarExpr>(call->args[0])
+                || mir::to<mir::VarExpr>(call->args[0])->var.getName() != frontier_name)
+                break;
+            frontier_size_stmts.push_back(reduce_stmt);
+        }
+        return frontier_size_stmts;
+    }
+
     void PriorityFeaturesLower::LowerPriorityUpdateOperatorRewriter::visit(mir::Call::Ptr call) {
         auto call_args = call->args;
         if (call->name == "updatePriorityMin") {
@@ -253,8 +364,10 @@ namespace graphit {
             node = priority_update_min;
         } else if (call->name == "updatePrioritySum") {
 
-            if (mir_context_->priority_update_type == mir::PriorityUpdateType::ConstSumReduceBeforePriorityUpdate) {
-                // we don't need to do any specialization for ConstSumReduceBeforePriorityUpdate
+            if (mir_context_->priority_update_type == mir::PriorityUpdateType::ConstSumReduceBeforePriorityUpdate
+                || mir_context_->priority_update_type == mir::PriorityUpdateType::EagerConstSumReduceBeforePriorityUpdate) {
+                // we don't need to do any specialization for the constant sum schedules,
+                // the update is generated from the call arguments
                 node = call;
             } else {
                 mir::PriorityUpdateOperatorSum::Ptr priority_udpate_sum = std::make_shared<mir::PriorityUpdateOperatorSum>();
@@ -0,0 +1,150 @@
+#include <graphit/midend/simd_loop_lower.h>
+
+namespace graphit {
+
+    void SimdLoopLower::lower() {
+        auto for_stmt_visitor = ForStmtVisitor(mir_context_);
+        std::vector<mir::FuncDecl::Ptr> functions = mir_context_->getFunctionList();
+        for (auto function : functions) {
+            function->accept(&for_stmt_visitor);
+        }
+    }
+
+    void SimdLoopLower::ForStmtVisitor::visit(mir::ForStmt::Ptr for_stmt) {
+        // outer loops (e.g. the iterations in main) are never vectorized, but the loops nested in them can be
+        mir::MIRVisitor::visit(for_stmt);
+
+        if (!isConstantBound(for_stmt->domain->lower) || !isConstantBound(for_stmt->domain->upper))
+            return;
+
+        auto loop_var = for_stmt->loopVar;
+        std::set<std::string> written_fields;
+        std::set<std::string> reduction_vars;
+        std::vector<mir::Expr::Ptr> tensor_reads;
+        std::set<std::string> scalar_reads;
+
+        for (auto stmt : *(for_stmt->body->stmts)) {
+            if (mir::isa<mir::CompareAndSwapStmt>(stmt) || !mir::isa<mir::AssignStmt>(stmt))
+                return;
+            auto assign_stmt = mir::to<mir::AssignStmt>(stmt);
+            if (!isArithmeticExpr(assign_stmt->expr))
+                return;
+
+            if (mir::isa<mir::ReduceStmt>(stmt)) {
+                auto reduce_stmt = mir::to<mir::ReduceStmt>(stmt);
+                if (reduce_stmt->reduce_op_ != mir::ReduceStmt::ReductionOp::SUM || reduce_stmt->is_atomic_
+                    || reduce_stmt->tracking_var_name_ != "")
+                    return;
+                // a sum into a scalar is carried across the iterations and becomes a simd reduction
+                if (mir::isa<mir::VarExpr>(reduce_stmt->lhs)) {
+                    auto var_name = mir::to<mir::VarExpr>(reduce_stmt->lhs)->var.getName();
+                    if (var_name == loop_var)
+                        return;
+                    reduction_vars.insert(var_name);
+                    collectReads(assign_stmt->expr, tensor_reads, scalar_reads);
+                    continue;
+                }
+            }
+
+            if (!isIndexedByLoopVar(assign_stmt->lhs, loop_var))
+                return;
+            written_fields.insert(getFieldName(assign_stmt->lhs));
+            collectReads(assign_stmt->lhs, tensor_reads, scalar_reads);
+            collectReads(assign_stmt->expr, tensor_reads, scalar_reads);
+        }
+
+        // reduction variables are only updated by the reduction itself
+        for (auto &var_name : reduction_vars) {
+            if (scalar_reads.find(var_name) != scalar_reads.end())
+                return;
+        }
+
+        // an iteration can only touch its own element of the fields written in the loop
+        for (auto tensor_read : tensor_reads) {
+            if (written_fields.find(getFieldName(tensor_read)) != written_fields.end()
+                && !isIndexedByLoopVar(tensor_read, loop_var))
+                return;
+        }
+
+        for_stmt->simd_vectorizable = true;
+        for_stmt->simd_reduction_vars = std::vector<std::string>(reduction_vars.begin(), reduction_vars.end());
+    }
+
+    bool SimdLoopLower::ForStmtVisitor::isConstantBound(mir::Expr::Ptr bound) {
+        if (mir::isa<mir::IntLiteral>(bound))
+            return true;
+        if (!mir::isa<mir::VarExpr>(bound))
+            return false;
+
+        // a global int constant initialized with a literal (e.g. const K : int = 20)
+        auto var_name = mir::to<mir::VarExpr>(bound)->var.getName();
+        for (auto constant : mir_context_->getLoweredConstants()) {
+            if (constant->name == var_name) {
+                return mir::isa<mir::ScalarType>(constant->type)
+                       && mir::to<mir::ScalarType>(constant->type)->type == mir::ScalarType::Type::INT
+                       && constant->initVal != nullptr && mir::isa<mir::IntLiteral>(constant->initVal);
+            }
+        }
+        return false;
+    }
+
+    bool SimdLoopLower::ForStmtVisitor::isArithmeticExpr(mir::Expr::Ptr expr) {
+        if (mir::isa<mir::IntLiteral>(expr) || mir::isa<mir::FloatLiteral>(expr) || mir::isa<mir::VarExpr>(expr))
+            return true;
+        if (mir::isa<mir::TensorStructReadExpr>(expr))
+            return isArithmeticExpr(mir::to<mir::TensorReadExpr>(expr)->index);
+        if (mir::isa<mir::TensorReadExpr>(expr)) {
+            auto tensor_read = mir::to<mir::TensorReadExpr>(expr);
+            return isArithmeticExpr(tensor_read->target) && isArithmeticExpr(tensor_read->index);
+        }
+        if (mir::isa<mir::NegExpr>(expr))
+            return isArithmeticExpr(mir::to<mir::NegExpr>(expr)->operand);
+        if (mir::isa<mir::AddExpr>(expr) || mir::isa<mir::SubExpr>(expr)
+            || mir::isa<mir::MulExpr>(expr) || mir::isa<mir::DivExpr>(expr)) {
+            auto binary_expr = mir::to<mir::BinaryExpr>(expr);
+            return isArithmeticExpr(binary_expr->lhs) && isArithmeticExpr(binary_expr->rhs);
+        }
+        return false;
+    }
+
+    bool SimdLoopLower::ForStmtVisitor::isIndexedByLoopVar(mir::Expr::Ptr expr, std::string loop_var) {
+        if (!mir::isa<mir::TensorReadExpr>(expr))
+            return false;
+        auto index = mir::to<mir::TensorReadExpr>(expr)->index;
+        return mir::isa<mir::VarExpr>(index) && mir::to<mir::VarExpr>(index)->var.getName() == loop_var;
+    }
+
+    std::string SimdLoopLower::ForStmtVisitor::getFieldName(mir::Expr::Ptr expr) {
+        while (mir::isa<mir::TensorReadExpr>(expr)) {
+            // fields fused into an array of structs are still tracked separately
+            if (mir::isa<mir::TensorStructReadExpr>(expr))
+                return mir::to<mir::VarExpr>(mir::to<mir::TensorStructReadExpr>(expr)->field_target)->var.getName();
+            expr = mir::to<mir::TensorReadExpr>(expr)->target;
+        }
+        return mir::isa<mir::VarExpr>(expr) ? mir::to<mir::VarExpr>(expr)->var.getName() : "";
+    }
+
+    void SimdLoopLower::ForStmtVisitor::collectReads(mir::Expr::Ptr expr,
+                                                     std::vector<mir::Expr::Ptr> &tensor_reads,
+                                                     std::set<std::string> &scalar_reads) {
+        if (mir::isa<mir::VarExpr>(expr)) {
+            scalar_reads.insert(mir::to<mir::VarExpr>(expr)->var.getName());
+        } else if (mir::isa<mir::TensorReadExpr>(expr)) {
+            // a nested read (e.g. latent_vec[v][i]) is one access of the field, only its indices are reads
+            tensor_reads.push_back(expr);
+            while (mir::isa<mir::TensorReadExpr>(expr)) {
+                auto tensor_read = mir::to<mir::TensorReadExpr>(expr);
+                collectReads(tensor_read->index, tensor_reads, scalar_reads);
+                // the target of an array of structs read is the field name
+                if (mir::isa<mir::TensorStructReadExpr>(tensor_read))
+                    break;
+                expr = tensor_read->target;
+            }
+        } else if (mir::isa<mir::NegExpr>(expr)) {
+            collectReads(mir::to<mir::NegExpr>(expr)->operand, tensor_reads, scalar_reads);
+        } else if (mir::isa<mir::BinaryExpr>(expr)) {
+            collectReads(mir::to<mir::BinaryExpr>(expr)->lhs, tensor_reads, scalar_reads);
+            collectReads(mir::to<mir::BinaryExpr>(expr)->rhs, tensor_reads, scalar_reads);
+        }
+    }
+}
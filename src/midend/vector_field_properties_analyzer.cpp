@@ -17,11 +17,17 @@ namespace graphit {
     void VectorFieldPropertiesAnalyzer::ApplyExprVisitor
     ::visit(mir::PullEdgeSetApplyExpr::Ptr apply_expr) {
         analyzeSingleFunctionEdgesetApplyExpr(apply_expr->input_function_name, "pull");
+        // several threads update the same destination when its in edges are split
+        if (apply_expr->split_apply_func != "")
+            analyzeSingleFunctionEdgesetApplyExpr(apply_expr->split_apply_func, "pull_split");
     }
 
     void VectorFieldPropertiesAnalyzer::ApplyExprVisitor
     ::visit(mir::PushEdgeSetApplyExpr::Ptr apply_expr) {
-        analyzeSingleFunctionEdgesetApplyExpr(apply_expr->input_function_name, "push");
+        if (apply_expr->use_edge_centric_traversal)
+            analyzeSingleFunctionEdgesetApplyExpr(apply_expr->input_function_name, "edge_centric");
+        else
+            analyzeSingleFunctionEdgesetApplyExpr(apply_expr->input_function_name, "push");
     }
 
     void VectorFieldPropertiesAnalyzer::ApplyExprVisitor
@@ -40,7 +46,8 @@ namespace graphit {
     void VectorFieldPropertiesAnalyzer::ApplyExprVisitor::visit(
             mir::UpdatePriorityEdgeSetApplyExpr::Ptr priority_update_expr) {
         if (mir_context_->priority_update_type == mir::EagerPriorityUpdate ||
-                mir_context_->priority_update_type == mir::EagerPriorityUpdateWithMerge){
+                mir_context_->priority_update_type == mir::EagerPriorityUpdateWithMerge ||
+                mir_context_->priority_update_type == mir::RelaxedMultiQueuePriorityUpdate){
             analyzeSingleFunctionEdgesetApplyExpr(priority_update_expr->input_function_name, "push");
         } else {
 
@@ -136,8 +143,8 @@ namespace graphit {
 
         if (index == src_var_name) {
             // operating on src
-            if (direction == "pull") {
-                // direction is pull
+            if (direction == "pull" || direction == "pull_split" || direction == "edge_centric") {
+                // direction is pull, split pull or edge centric (sources are processed by multiple threads)
                 if (in_write_phase) {
                     //write operation
                     output = buildSharedWriteFieldProperty();
@@ -171,6 +178,7 @@ namespace graphit {
 
                 }
             } else {
+                // push, split pull (the in edges of a destination are split across threads) or edge centric
                 if (in_write_phase) {
                     // write
                     output = buildSharedWriteFieldProperty();
@@ -0,0 +1,156 @@
+#ifndef BIDIRECTIONAL_DELTA_STEPPING_H_
+#define BIDIRECTIONAL_DELTA_STEPPING_H_
+
+#include <algorithm>
+#include <cinttypes>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "platform_atomics.h"
+#include "delta_selection.h"
+#include "thread_local_bins.h"
+
+
+/**
+ * One direction of the bidirectional search: tentative distances, the bins of the nodes still to be processed
+ * and the frontier of the current bin. priorities_ and delta_ are named as in EagerPriorityQueue so that
+ * ThreadLocalBins can rebin the overflow nodes.
+ **/
+template <typename WeightT_>
+struct BidirectionalSearchSide {
+  WeightT_* priorities_;
+  WeightT_ delta_;
+  ThreadLocalBins bins_;
+  std::vector<NodeID> frontier_;
+  size_t bin_;
+  bool exhausted_;
+
+  BidirectionalSearchSide(int64_t num_nodes, WeightT_ delta, NodeID source)
+      : priorities_(new WeightT_[num_nodes]), delta_(delta), bin_(0), exhausted_(false) {
+    #pragma omp parallel for
+    for (int64_t n = 0; n < num_nodes; n++)
+      priorities_[n] = kDistInf();
+    priorities_[source] = 0;
+    frontier_.push_back(source);
+  }
+
+  ~BidirectionalSearchSide(){
+    delete[] priorities_;
+  }
+
+  static WeightT_ kDistInf(){
+    return std::numeric_limits<WeightT_>::max()/2;
+  }
+
+  // every node that is not settled yet in this direction is at least this far from the source
+  int64_t lower_bound() const {
+    if (exhausted_) return std::numeric_limits<int64_t>::max()/2;
+    return static_cast<int64_t>(bin_) * delta_;
+  }
+
+  // moves the nodes of the next non empty bin into the frontier, marks the side exhausted if there is none
+  void next_frontier(){
+    frontier_.resize(0);
+    size_t next_bin = bins_.next_bin();
+    while (next_bin != ThreadLocalBins::kNoBin) {
+      bins_.advance(next_bin, this);
+      if (!bins_.bin(next_bin).empty()) break;
+      // next_bin was a lower bound coming from the overflow nodes
+      next_bin = bins_.next_bin();
+    }
+    if (next_bin == ThreadLocalBins::kNoBin) {
+      exhausted_ = true;
+      return;
+    }
+    bin_ = next_bin;
+    frontier_.swap(bins_.bin(next_bin));
+  }
+};
+
+
+/**
+ * Relaxes the out edges (in edges for the backward direction) of the frontier of one side once.
+ * Every improved node is checked against the distance of the other side to tighten the best s-t path
+ * length mu. Only one side runs at a time, so the other side's distances do not change during the pass.
+ **/
+template <bool kBackward, class WGraph_, typename WeightT_>
+void RelaxBidirectionalFrontier(const WGraph_ &g, BidirectionalSearchSide<WeightT_>& side,
+                                const BidirectionalSearchSide<WeightT_>& other, int64_t &mu){
+  WeightT_* dist = side.priorities_;
+  const WeightT_* other_dist = other.priorities_;
+  const WeightT_ kDistInf = BidirectionalSearchSide<WeightT_>::kDistInf();
+  const WeightT_ bin_start = side.bin_ * side.delta_;
+  #pragma omp parallel
+  {
+    std::vector<std::pair<size_t, NodeID> > local_updates;
+    int64_t local_mu = mu;
+    #pragma omp for nowait schedule(dynamic, 64)
+    for (size_t i = 0; i < side.frontier_.size(); i++) {
+      NodeID u = side.frontier_[i];
+      // nodes that were improved into an earlier bin have been processed already
+      if (dist[u] < bin_start) continue;
+      for (auto wn : (kBackward ? g.in_neigh(u) : g.out_neigh(u))) {
+        NodeID v = EdgeTarget(wn);
+        WeightT_ new_dist = dist[u] + OutEdgeWeight(wn);
+        WeightT_ old_dist = dist[v];
+        bool changed_dist = false;
+        while (new_dist < old_dist) {
+          if (compare_and_swap(dist[v], old_dist, new_dist)) {
+            changed_dist = true;
+            break;
+          }
+          old_dist = dist[v];
+        }
+        if (!changed_dist) continue;
+        local_updates.push_back(std::make_pair(static_cast<size_t>(new_dist/side.delta_), v));
+        if (other_dist[v] != kDistInf)
+          local_mu = std::min(local_mu, static_cast<int64_t>(new_dist) + other_dist[v]);
+      }
+    }
+    #pragma omp critical
+    {
+      for (auto& update : local_updates)
+        side.bins_.push(update.first, update.second);
+      mu = std::min(mu, local_mu);
+    }
+  }
+  if (side.bins_.bin(side.bin_).empty()) {
+    side.next_frontier();
+  } else {
+    side.frontier_.resize(0);
+    side.frontier_.swap(side.bins_.bin(side.bin_));
+  }
+}
+
+
+/**
+ * Point-to-point shortest path with delta-stepping from both endpoints.
+ * The forward search follows the out edges from src, the backward search follows the in edges (the transpose of
+ * a directed graph) from dst. Each round processes the current bin of the side with the smaller frontier.
+ * All the nodes closer than lower_bound() to the source of a side are settled in that direction, so once the two
+ * lower bounds add up to at least mu, the shortest path that was met by both searches, no shorter path exists.
+ * Returns the distance, or numeric_limits<WeightT>::max() if dst is not reachable.
+ * A delta <= 0 selects the delta from the statistics of the graph.
+ **/
+template <class WGraph_>
+WeightT BidirectionalDeltaStepping(const WGraph_ &g, NodeID src, NodeID dst, WeightT delta){
+  if (src == dst) return 0;
+  if (delta <= 0) delta = SelectInitialDelta(g);
+  BidirectionalSearchSide<WeightT> forward(g.num_nodes(), delta, src);
+  BidirectionalSearchSide<WeightT> backward(g.num_nodes(), delta, dst);
+  const int64_t kNoPath = std::numeric_limits<int64_t>::max()/2;
+  int64_t mu = kNoPath;
+  while (forward.lower_bound() + backward.lower_bound() < mu) {
+    bool run_forward = backward.exhausted_ ||
+        (!forward.exhausted_ && forward.frontier_.size() <= backward.frontier_.size());
+    if (run_forward)
+      RelaxBidirectionalFrontier<false>(g, forward, backward, mu);
+    else
+      RelaxBidirectionalFrontier<true>(g, backward, forward, mu);
+  }
+  if (mu == kNoPath) return std::numeric_limits<WeightT>::max();
+  return static_cast<WeightT>(mu);
+}
+
+#endif  // BIDIRECTIONAL_DELTA_STEPPING_H_
@@ -0,0 +1,82 @@
+#ifndef COUNTER_RNG_H_
+#define COUNTER_RNG_H_
+
+#include <atomic>
+#include <cinttypes>
+
+
+/**
+ * Counter-based random numbers: the number for (stream, counter) is a hash of the seed, the stream and the counter,
+ * so threads (or walkers) draw from their own streams without sharing any state, and the numbers do not depend on
+ * which thread draws them or in which order.
+ **/
+class CounterRNG {
+
+public:
+  explicit CounterRNG(uint64_t seed = 0) : seed_(seed) {}
+
+  uint64_t operator()(uint64_t stream, uint64_t counter) const {
+    return Mix(Mix(seed_ ^ (stream * 0x9e3779b97f4a7c15ULL)) + counter * 0xd1b54a32d192ed03ULL);
+  }
+
+  // uniform in [0, bound), from the high 32 bits of r
+  static uint32_t Bounded(uint64_t r, uint32_t bound){
+    return (uint32_t) (((r >> 32) * bound) >> 32);
+  }
+
+  // uniform in [0, 1), from the low 32 bits of r
+  static float Unit(uint64_t r){
+    return (r & 0xffffffffULL) * (1.0f / 4294967296.0f);
+  }
+
+  uint64_t seed() const {
+    return seed_;
+  }
+
+private:
+  // splitmix64 finalizer
+  static uint64_t Mix(uint64_t x){
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+  }
+
+  uint64_t seed_;
+};
+
+// seed of the random numbers used by the runtime library, set with setRandomSeed
+static uint64_t& GlobalRandomSeed(){
+  static uint64_t seed = 0;
+  return seed;
+}
+
+// bumped by every reseed, so that the threads restart their streams
+static std::atomic<uint64_t>& GlobalRandomEpoch(){
+  static std::atomic<uint64_t> epoch(0);
+  return epoch;
+}
+
+static void SetGlobalRandomSeed(uint64_t seed){
+  GlobalRandomSeed() = seed;
+  GlobalRandomEpoch()++;
+}
+
+/**
+ * Next random number of the calling thread, for code without a natural counter (e.g. a random neighbor).
+ * Each thread gets its own stream the first time it draws, in order, so a serial program draws the same numbers in
+ * every run with the same seed.
+ **/
+static uint64_t ThreadRandom(){
+  static std::atomic<uint64_t> next_stream(0);
+  thread_local uint64_t stream = next_stream++;
+  thread_local uint64_t counter = 0;
+  thread_local uint64_t epoch = 0;
+  uint64_t global_epoch = GlobalRandomEpoch().load(std::memory_order_relaxed);
+  if (epoch != global_epoch) {
+    epoch = global_epoch;
+    counter = 0;
+  }
+  return CounterRNG(GlobalRandomSeed())(stream, counter++);
+}
+
+#endif  // COUNTER_RNG_H_
@@ -0,0 +1,102 @@
+#ifndef DEGREE_BUCKETS_H_
+#define DEGREE_BUCKETS_H_
+
+#include <cinttypes>
+#include <vector>
+#include <algorithm>
+
+/**
+ * Classification of the vertices of a CSRGraph by degree used by degree bucketed traversals, by in-degree
+ * (destinations) for pull and by out-degree (sources) for push, depending on the index it is built from.
+ * Light vertices (degree of at most grainSize) are grouped into chunks of consecutive light vertices with
+ * about grainSize edges each. The edges of a heavy vertex are split into blocks of grainSize edges,
+ * so that the edges of a single high degree vertex can be processed by several threads.
+ **/
+template <class NodeID_>
+struct DegreeBuckets
+{
+  NodeID_ *lightVertices;
+  int64_t numLightVertices;
+  // start of each chunk in lightVertices, numLightChunks + 1 entries
+  int64_t *lightChunkOffsets;
+  int64_t numLightChunks;
+
+  NodeID_ *heavyVertices;
+  int64_t numHeavyVertices;
+  // the heavy vertex of each block and the range of its edges (relative to the start of its neighbors)
+  NodeID_ *heavyBlockVertex;
+  int64_t *heavyBlockBegin;
+  int64_t *heavyBlockEnd;
+  int64_t numHeavyBlocks;
+  // the blocks of heavy vertex i are [heavyBlockOffsets[i], heavyBlockOffsets[i+1]), numHeavyVertices + 1 entries
+  int64_t *heavyBlockOffsets;
+
+  int64_t grainSize;
+
+  template <class DestID_>
+  DegreeBuckets(int64_t num_nodes, DestID_** index, int64_t grain_size) : grainSize(grain_size)
+  {
+    std::vector<NodeID_> light, heavy;
+    std::vector<int64_t> chunk_offsets;
+    int64_t num_blocks = 0;
+    int64_t chunk_edges = 0;
+    for (NodeID_ d = 0; d < num_nodes; d++) {
+      int64_t degree = index[d+1] - index[d];
+      if (degree > grainSize) {
+        heavy.push_back(d);
+        num_blocks += (degree + grainSize - 1) / grainSize;
+        continue;
+      }
+      if (chunk_offsets.empty() || chunk_edges >= grainSize) {
+        chunk_offsets.push_back(light.size());
+        chunk_edges = 0;
+      }
+      light.push_back(d);
+      // vertices without edges still take some work
+      chunk_edges += degree + 1;
+    }
+    chunk_offsets.push_back(light.size());
+
+    numLightVertices = light.size();
+    lightVertices = new NodeID_[numLightVertices];
+    std::copy(light.begin(), light.end(), lightVertices);
+    numLightChunks = chunk_offsets.size() - 1;
+    lightChunkOffsets = new int64_t[numLightChunks + 1];
+    std::copy(chunk_offsets.begin(), chunk_offsets.end(), lightChunkOffsets);
+
+    numHeavyVertices = heavy.size();
+    heavyVertices = new NodeID_[numHeavyVertices];
+    std::copy(heavy.begin(), heavy.end(), heavyVertices);
+    numHeavyBlocks = num_blocks;
+    heavyBlockVertex = new NodeID_[numHeavyBlocks];
+    heavyBlockBegin = new int64_t[numHeavyBlocks];
+    heavyBlockEnd = new int64_t[numHeavyBlocks];
+    heavyBlockOffsets = new int64_t[numHeavyVertices + 1];
+    int64_t block = 0;
+    for (int64_t i = 0; i < numHeavyVertices; i++) {
+      NodeID_ d = heavy[i];
+      int64_t degree = index[d+1] - index[d];
+      heavyBlockOffsets[i] = block;
+      for (int64_t begin = 0; begin < degree; begin += grainSize) {
+        heavyBlockVertex[block] = d;
+        heavyBlockBegin[block] = begin;
+        heavyBlockEnd[block] = std::min(begin + grainSize, degree);
+        block++;
+      }
+    }
+    heavyBlockOffsets[numHeavyVertices] = block;
+  }
+
+  ~DegreeBuckets()
+  {
+    delete[] lightVertices;
+    delete[] lightChunkOffsets;
+    delete[] heavyVertices;
+    delete[] heavyBlockVertex;
+    delete[] heavyBlockBegin;
+    delete[] heavyBlockEnd;
+    delete[] heavyBlockOffsets;
+  }
+};
+
+#endif  // DEGREE_BUCKETS_H_
@@ -0,0 +1,59 @@
+#ifndef DELTA_SELECTION_H_
+#define DELTA_SELECTION_H_
+
+#include <algorithm>
+#include <cinttypes>
+
+
+// weight of an out edge, 1 for unweighted graphs
+template <class NodeID_, class WeightT_>
+inline WeightT_ OutEdgeWeight(const NodeWeight<NodeID_, WeightT_>& wn){
+  return wn.w;
+}
+
+template <class NodeID_>
+inline int OutEdgeWeight(NodeID_){
+  return 1;
+}
+
+// target of an edge, the edge itself for unweighted graphs
+template <class NodeID_, class WeightT_>
+inline NodeID_ EdgeTarget(const NodeWeight<NodeID_, WeightT_>& wn){
+  return wn.v;
+}
+
+template <class NodeID_>
+inline NodeID_ EdgeTarget(NodeID_ v){
+  return v;
+}
+
+
+/**
+ * Initial delta for delta-stepping picked from statistics of the weighted graph.
+ * Following Meyer and Sanders, delta is about the average edge weight divided by the average degree, so that
+ * a bucket holds a few light edges per node. The weights are sampled from the out edges of up to
+ * num_samples evenly spaced nodes. Road networks (few edges, large weights) get a large delta,
+ * social networks (many edges, small weights) a small one.
+ **/
+template <class WGraph_>
+int SelectInitialDelta(const WGraph_ &g, int64_t num_samples = 1024){
+  int64_t num_nodes = g.num_nodes();
+  if (num_nodes == 0 || g.num_edges_directed() == 0)
+    return 1;
+  int64_t stride = std::max<int64_t>(1, num_nodes / num_samples);
+  double weight_sum = 0;
+  int64_t num_weights = 0;
+  for (int64_t u = 0; u < num_nodes; u += stride) {
+    for (auto wn : g.out_neigh(u)) {
+      weight_sum += OutEdgeWeight(wn);
+      num_weights++;
+    }
+  }
+  if (num_weights == 0)
+    return 1;
+  double average_degree = static_cast<double>(g.num_edges_directed()) / num_nodes;
+  double delta = (weight_sum / num_weights) / std::max(1.0, average_degree);
+  return std::max(1, static_cast<int>(delta));
+}
+
+#endif  // DELTA_SELECTION_H_
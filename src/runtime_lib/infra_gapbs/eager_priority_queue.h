@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <cinttypes>
+#include <limits>
 
 #include "platform_atomics.h"
 
@@ -17,8 +18,10 @@ template<typename PriorityT_>
 class EagerPriorityQueue {
 
 public:
-  explicit EagerPriorityQueue(PriorityT_* priorities, PriorityT_ delta=1) 
-  		: priorities_(priorities), delta_(delta){
+  explicit EagerPriorityQueue(PriorityT_* priorities, PriorityT_ delta=1, bool adaptive_delta=false,
+                              size_t num_open_buckets=128)
+  		: priorities_(priorities), delta_(delta), adaptive_delta_(adaptive_delta),
+  		  num_open_buckets_(num_open_buckets){
     	init_indexes_tails();
   }
 
@@ -34,10 +37,16 @@ public:
   }
 
   // get the prioirty of the current iteration (each iter has a priority)
+  // when processing asynchronously, each thread is at the priority of the node it is working on
   size_t get_current_priority(){
+    if (relaxed_) return thread_priority_;
     return shared_indexes[iter_&1];
   }
 
+  void set_thread_priority(size_t priority){
+    thread_priority_ = priority;
+  }
+
   // increment the iteration number, which was used for computing the current priorty
   void increment_iter() {
     iter_++;
@@ -51,6 +60,26 @@ public:
     return priorities_[v]/delta_ < get_current_priority();
   }
 
+  // picks the delta for the next round from the round that just finished, returns true if delta changed.
+  // More than half of the round inserted again into the current bucket means that delta is too large and
+  // the bucket is relaxed over and over, a round too small to keep the threads busy asks for a larger delta.
+  bool adapt_delta(size_t round_size, size_t min_round_size){
+    prev_delta_ = delta_;
+    if (round_reinserted_ * 2 > round_size && delta_ > 1) {
+      delta_ = delta_/2;
+    } else if (round_size < min_round_size && round_reinserted_ * 8 <= round_size
+               && delta_ < std::numeric_limits<PriorityT_>::max()/4) {
+      delta_ = delta_*2;
+    }
+    round_reinserted_ = 0;
+    return delta_ != prev_delta_;
+  }
+
+  // generated code deletes the priority queue with pq->deleteObject() (delete pq in GraphIt)
+  void deleteObject(){
+    delete this;
+  }
+
   PriorityT_* priorities_;
   const PriorityT_ kDistInf = std::numeric_limits<PriorityT_>::max()/2;
   const size_t kMaxBin = std::numeric_limits<size_t>::max()/2;
@@ -59,6 +88,23 @@ public:
   size_t frontier_tails[2];
   size_t iter_;;
 
+  // adaptive delta (delta is changed between the rounds of the ordered processing operators)
+  bool adaptive_delta_;
+  // nodes inserted into the bucket that was being processed during the current round
+  size_t round_reinserted_ = 0;
+  PriorityT_ prev_delta_;
+  bool delta_changed_ = false;
+  size_t prev_next_bin_ = 0;
+
+  // number of bins materialized by each thread, later bins share an overflow bin
+  size_t num_open_buckets_;
+  // set while a relaxed (asynchronous) ordered processing operator is running
+  bool relaxed_ = false;
+  static thread_local size_t thread_priority_;
+
 };
 
+template<typename PriorityT_>
+thread_local size_t EagerPriorityQueue<PriorityT_>::thread_priority_ = 0;
+
 #endif // EAGER_PRIORITY_QUEUE_H
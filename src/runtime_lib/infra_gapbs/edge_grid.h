@@ -0,0 +1,93 @@
+#ifndef EDGE_GRID_H_
+#define EDGE_GRID_H_
+
+#include <cinttypes>
+#include <vector>
+#include <algorithm>
+
+/**
+ * Coordinate (COO) copy of the out edges of a CSRGraph used by edge-centric traversals.
+ * The vertices are split into blocks of (1 << blockShift) vertices and the edges are grouped
+ * into a numBlocks x numBlocks grid of cells, stored row-major by source block.
+ * Processing one cell at a time keeps both the source and the destination working sets in cache.
+ **/
+template <class DestID_, class NodeID_>
+struct EdgeGrid
+{
+  NodeID_ *srcArray;
+  // destinations (carrying the weight for weighted graphs)
+  DestID_ *dstArray;
+  // start of each cell in srcArray / dstArray, numCells + 1 entries
+  int64_t *cellOffsets;
+  int64_t numEdges;
+  int numBlocks;
+  int blockShift;
+
+  // smallest block is 64K vertices, the grid never grows beyond 256 x 256 cells
+  static const int kMinBlockShift = 16;
+  static const int kMaxBlocksPerDim = 256;
+
+  EdgeGrid(int64_t num_nodes, DestID_** out_index)
+  {
+    blockShift = kMinBlockShift;
+    while (((num_nodes + (1l << blockShift) - 1) >> blockShift) > kMaxBlocksPerDim)
+      blockShift++;
+    numBlocks = (num_nodes + (1l << blockShift) - 1) >> blockShift;
+    if (numBlocks == 0)
+      numBlocks = 1;
+
+    numEdges = out_index[num_nodes] - out_index[0];
+    srcArray = new NodeID_[numEdges];
+    dstArray = new DestID_[numEdges];
+    cellOffsets = new int64_t[num_cells() + 1];
+    cellOffsets[num_cells()] = numEdges;
+
+    // the out edges of a block row are contiguous in the CSR, so every row is sorted independently
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int row = 0; row < numBlocks; row++) {
+      NodeID_ row_start = (NodeID_) std::min<int64_t>((int64_t) row << blockShift, num_nodes);
+      NodeID_ row_end = (NodeID_) std::min<int64_t>((int64_t) (row + 1) << blockShift, num_nodes);
+      int64_t *row_offsets = cellOffsets + (int64_t) row * numBlocks;
+
+      std::vector<int64_t> counts(numBlocks, 0);
+      for (NodeID_ s = row_start; s < row_end; s++) {
+        for (DestID_ *d = out_index[s]; d < out_index[s+1]; d++)
+          counts[dst_id(*d) >> blockShift]++;
+      }
+
+      int64_t pos = out_index[row_start] - out_index[0];
+      for (int col = 0; col < numBlocks; col++) {
+        row_offsets[col] = pos;
+        pos += counts[col];
+        counts[col] = row_offsets[col];
+      }
+
+      for (NodeID_ s = row_start; s < row_end; s++) {
+        for (DestID_ *d = out_index[s]; d < out_index[s+1]; d++) {
+          int64_t e = counts[dst_id(*d) >> blockShift]++;
+          srcArray[e] = s;
+          dstArray[e] = *d;
+        }
+      }
+    }
+  }
+
+  ~EdgeGrid()
+  {
+    delete[] srcArray;
+    delete[] dstArray;
+    delete[] cellOffsets;
+  }
+
+  inline int64_t num_cells() const {
+    return (int64_t) numBlocks * numBlocks;
+  }
+
+private:
+  // NodeWeight converts to its NodeID_
+  static inline NodeID_ dst_id(DestID_ d) {
+    return static_cast<NodeID_>(d);
+  }
+};
+
+#endif  // EDGE_GRID_H_
@@ -10,10 +10,14 @@
 #include <type_traits>
 #include <map>
 
+#include "counter_rng.h"
 #include "pvector.h"
 #include "util.h"
 
 #include "segmentgraph.h"
+#include "edge_grid.h"
+#include "degree_buckets.h"
+#include "hub_bitmaps.h"
 #include <memory>
 #include <assert.h>
 
@@ -125,6 +129,10 @@ class CSRGraph {
     in_neighbors_shared_.reset();
     flags_shared_.reset();
     offsets_shared_.reset();
+    edge_grid_shared_.reset();
+    degree_buckets_shared_.reset();
+    out_degree_buckets_shared_.reset();
+    hub_bitmaps_shared_.reset();
     for (auto iter = label_to_segment.begin(); iter != label_to_segment.end(); iter++) {
       delete ((*iter).second);
     }
@@ -153,8 +161,6 @@ class CSRGraph {
       flags_shared_.reset(flags_);
     //adding offsets for load balacne scheme
     SetUpOffsets(true);
-    //Set this up for getting random neighbors
-      srand(time(NULL));
     }
 
   CSRGraph(int64_t num_nodes, DestID_** out_index, DestID_* out_neighs,
@@ -170,9 +176,6 @@ class CSRGraph {
       flags_ = new int[num_nodes_];
       flags_shared_.reset(flags_);
         SetUpOffsets(true);
-
-      //Set this up for getting random neighbors
-      srand(time(NULL));
     }
 
     CSRGraph(int64_t num_nodes, DestID_** out_index, DestID_* out_neighs,
@@ -189,9 +192,6 @@ class CSRGraph {
       flags_ = new int[num_nodes_];
       flags_shared_.reset(flags_);
       SetUpOffsets(true);
-
-        //Set this up for getting random neighbors
-        srand(time(NULL));
     }
 
     CSRGraph(int64_t num_nodes, std::shared_ptr<DestID_*> out_index, std::shared_ptr<DestID_> out_neighs,
@@ -208,8 +208,6 @@ class CSRGraph {
       flags_ = new int[num_nodes_];
       flags_shared_.reset(flags_);
     SetUpOffsets(true);
-        //Set this up for getting random neighbors
-        srand(time(NULL));
   }
 
   
@@ -231,8 +229,6 @@ class CSRGraph {
         out_neighbors_shared_ = other.out_neighbors_shared_;
         in_index_shared_ = other.in_index_shared_;
         in_neighbors_shared_ = other.in_neighbors_shared_;
-        //Set this up for getting random neighbors
-        srand(time(NULL));
 	
     }
 
@@ -262,8 +258,6 @@ class CSRGraph {
        
         other.flags_shared_.reset(); 
         other.offsets_shared_.reset();
-      //Set this up for getting random neighbors
-      srand(time(NULL));
   }
 
 
@@ -371,17 +365,18 @@ class CSRGraph {
     return Neighborhood(n, in_index_);
   }
 
+  // uses the random stream of the calling thread (see counter_rng.h), seeded with setRandomSeed
   NodeID_ get_random_out_neigh(NodeID_ n)  {
       int num_nghs = out_degree(n);
       assert(num_nghs!=0);
-      int rand_index = rand() % num_nghs;
+      int rand_index = CounterRNG::Bounded(ThreadRandom(), num_nghs);
       return out_index_[n][rand_index];
   }
 
   NodeID_ get_random_in_neigh(NodeID_ n)  {
       int num_nghs = in_degree(n);
       assert(num_nghs!=0);
-      int rand_index = rand() % num_nghs;
+      int rand_index = CounterRNG::Bounded(ThreadRandom(), num_nghs);
       return in_index_[n][rand_index];
   }
 
@@ -433,6 +428,32 @@ class CSRGraph {
           offsets_[n] = out_index_[n] - out_index_[0];
     }
 
+  // builds the grid ordered COO edge array used by edge-centric traversals
+  void SetUpEdgeGrid() {
+      edge_grid_shared_.reset(new EdgeGrid<DestID_, NodeID_>(num_nodes_, out_index_));
+  }
+
+  // classifies the destinations by in-degree for degree bucketed pull traversals, reused while the grain size stays the same
+  void SetUpDegreeBuckets(int64_t grain_size) {
+      if (degree_buckets_shared_ != nullptr && degree_buckets_shared_->grainSize == grain_size)
+          return;
+      degree_buckets_shared_.reset(new DegreeBuckets<NodeID_>(num_nodes_, in_index_, grain_size));
+  }
+
+  // classifies the sources by out-degree for degree bucketed push traversals, reused while the grain size stays the same
+  void SetUpOutDegreeBuckets(int64_t grain_size) {
+      if (out_degree_buckets_shared_ != nullptr && out_degree_buckets_shared_->grainSize == grain_size)
+          return;
+      out_degree_buckets_shared_.reset(new DegreeBuckets<NodeID_>(num_nodes_, out_index_, grain_size));
+  }
+
+  // builds the neighbor bitmaps of the highest degree vertices for hub bitmap intersections, reused while the budget stays the same
+  void SetUpHubBitmaps(int64_t budget_bytes) {
+      if (hub_bitmaps_shared_ != nullptr && hub_bitmaps_shared_->budgetBytes == budget_bytes)
+          return;
+      hub_bitmaps_shared_.reset(new HubBitmaps<NodeID_>(num_nodes_, out_index_, budget_bytes));
+  }
+
   Range<NodeID_> vertices() const {
     return Range<NodeID_>(num_nodes());
   }
@@ -529,6 +550,10 @@ private:
 public:
   std::shared_ptr<int> flags_shared_;
   std::shared_ptr<SGOffset> offsets_shared_;
+  std::shared_ptr<EdgeGrid<DestID_, NodeID_>> edge_grid_shared_;
+  std::shared_ptr<DegreeBuckets<NodeID_>> degree_buckets_shared_;
+  std::shared_ptr<DegreeBuckets<NodeID_>> out_degree_buckets_shared_;
+  std::shared_ptr<HubBitmaps<NodeID_>> hub_bitmaps_shared_;
 
   std::shared_ptr<DestID_*> out_index_shared_;
   std::shared_ptr<DestID_> out_neighbors_shared_;
@@ -560,6 +585,18 @@ public:
   inline SGOffset * get_offsets_(void) {
       return offsets_;
   }
+  inline EdgeGrid<DestID_, NodeID_> * get_edge_grid_(void) {
+      return edge_grid_shared_.get();
+  }
+  inline DegreeBuckets<NodeID_> * get_degree_buckets_(void) {
+      return degree_buckets_shared_.get();
+  }
+  inline DegreeBuckets<NodeID_> * get_out_degree_buckets_(void) {
+      return out_degree_buckets_shared_.get();
+  }
+  inline HubBitmaps<NodeID_> * get_hub_bitmaps_(void) {
+      return hub_bitmaps_shared_.get();
+  }
 };
 
 #endif  // GRAPH_H_
@@ -0,0 +1,67 @@
+#ifndef HUB_BITMAPS_H_
+#define HUB_BITMAPS_H_
+
+#include <algorithm>
+#include <cinttypes>
+#include <memory>
+#include <vector>
+
+#include "bitmap.h"
+
+/**
+ * Bitmaps of the out neighbors of the highest out-degree vertices (hubs) of a CSRGraph, used by hub bitmap
+ * intersections. An intersection with a hub probes the bitmap with the elements of the other set instead of
+ * merging the long neighbor list of the hub again. The per vertex bitmap lookup (num_nodes pointers) is counted
+ * against budgetBytes, and as many of the highest degree vertices as fit in the rest get a bitmap (num_nodes bits
+ * each).
+ **/
+template <class NodeID_>
+struct HubBitmaps
+{
+  int64_t budgetBytes;
+  int64_t numHubs;
+  // hubs in decreasing order of degree
+  std::vector<NodeID_> hubs;
+
+  template <class DestID_>
+  HubBitmaps(int64_t num_nodes, DestID_** out_index, int64_t budget_bytes)
+      : budgetBytes(budget_bytes), bitmapOf_(num_nodes, nullptr)
+  {
+    int64_t bitmap_bytes = std::max<int64_t>(1, (num_nodes + 63) / 64) * sizeof(uint64_t);
+    int64_t lookup_bytes = num_nodes * (int64_t) sizeof(const Bitmap*);
+    int64_t max_hubs = std::min(num_nodes, std::max<int64_t>(0, budget_bytes - lookup_bytes) / bitmap_bytes);
+    for (NodeID_ v = 0; v < num_nodes; v++) {
+      if (out_index[v+1] > out_index[v])
+        hubs.push_back(v);
+    }
+    auto higher_degree = [out_index](NodeID_ u, NodeID_ v) {
+      int64_t degree_u = out_index[u+1] - out_index[u], degree_v = out_index[v+1] - out_index[v];
+      return degree_u > degree_v || (degree_u == degree_v && u < v);
+    };
+    numHubs = std::min<int64_t>(hubs.size(), max_hubs);
+    std::partial_sort(hubs.begin(), hubs.begin() + numHubs, hubs.end(), higher_degree);
+    hubs.resize(numHubs);
+
+    bitmaps_.resize(numHubs);
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int64_t h = 0; h < numHubs; h++) {
+      NodeID_ v = hubs[h];
+      bitmaps_[h].reset(new Bitmap(num_nodes));
+      bitmaps_[h]->reset();
+      for (DestID_* ngh = out_index[v]; ngh < out_index[v+1]; ngh++)
+        bitmaps_[h]->set_bit(*ngh);
+      bitmapOf_[v] = bitmaps_[h].get();
+    }
+  }
+
+  // bitmap of the out neighbors of v, nullptr if v is not a hub
+  inline const Bitmap* bitmap(NodeID_ v) const {
+    return bitmapOf_[v];
+  }
+
+private:
+  std::vector<std::unique_ptr<Bitmap>> bitmaps_;
+  std::vector<const Bitmap*> bitmapOf_;
+};
+
+#endif  // HUB_BITMAPS_H_
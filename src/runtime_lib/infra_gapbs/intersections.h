@@ -16,6 +16,11 @@
 #include "bitmap.h"
 #include "timer.h"
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define GRAPHIT_X86_INTERSECTIONS
+#endif
+
 
 using namespace std;
 
@@ -49,11 +54,12 @@ static size_t intersectSortedNodeSetNaive(NodeID *A, NodeID *B, size_t totalA, s
 
 }
 
-static size_t intersectSortedNodeSetBitset(Bitmap* A, NodeID *B, size_t totalB) {
+static size_t intersectSortedNodeSetBitset(const Bitmap* A, NodeID *B, size_t totalB, NodeID dest=(NodeID)INT32_MAX) {
 
     size_t total = 0;
 
     for (size_t j = 0; j < totalB; j++) {
+        if (*(B + j) > dest) break;
         if (A->get_bit(*(B + j))) {
             total++;
         }
@@ -270,4 +276,106 @@ static size_t intersectSortedNodeSetCombined(NodeID *A, NodeID *B, size_t totalA
 
     return count;
 }
+
+// Probes the bitmap of a hub (hubA or hubB, nullptr for a set without one) with the elements of the other set,
+// the smaller set when both have a bitmap. Sets without a bitmap use the combined intersection.
+static size_t intersectSortedNodeSetHubBitmap(NodeID *A, NodeID *B, const Bitmap* hubA, const Bitmap* hubB,
+                                              size_t totalA, size_t totalB, size_t sizeThreshold,
+                                              double ratioThreshold, NodeID dest=(NodeID)INT32_MAX) {
+    if (hubA != nullptr && (hubB == nullptr || totalB <= totalA))
+        return intersectSortedNodeSetBitset(hubA, B, totalB, dest);
+    if (hubB != nullptr)
+        return intersectSortedNodeSetBitset(hubB, A, totalA, dest);
+    return intersectSortedNodeSetCombined(A, B, totalA, totalB, sizeThreshold, ratioThreshold, dest);
+}
+
+// number of elements of the sorted array A that are <= dest
+static size_t sortedPrefixUpTo(NodeID *A, size_t totalA, NodeID dest) {
+    return std::upper_bound(A, A + totalA, dest) - A;
+}
+
+#if defined(GRAPHIT_X86_INTERSECTIONS)
+
+//block compare intersection with AVX2: every 8 element block of A is compared with the 8 rotations of a block of B,
+//then the block with the smaller last element moves forward. Reference: https://doi.org/10.14778/3137765.3137778
+__attribute__((target("avx2")))
+static size_t intersectSortedNodeSetAVX2(NodeID *A, NodeID *B, size_t totalA, size_t totalB, NodeID dest=(NodeID)INT32_MAX) {
+    totalA = sortedPrefixUpTo(A, totalA, dest);
+    totalB = sortedPrefixUpTo(B, totalB, dest);
+    size_t begin_a = 0;
+    size_t begin_b = 0;
+    size_t count = 0;
+    const __m256i rotate = _mm256_set_epi32(0, 7, 6, 5, 4, 3, 2, 1);
+    while (begin_a + 8 <= totalA && begin_b + 8 <= totalB) {
+        __m256i a = _mm256_loadu_si256((const __m256i *) (A + begin_a));
+        __m256i b = _mm256_loadu_si256((const __m256i *) (B + begin_b));
+        __m256i matches = _mm256_cmpeq_epi32(a, b);
+        for (int r = 1; r < 8; r++) {
+            b = _mm256_permutevar8x32_epi32(b, rotate);
+            matches = _mm256_or_si256(matches, _mm256_cmpeq_epi32(a, b));
+        }
+        count += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(matches)));
+        NodeID last_a = A[begin_a + 7];
+        NodeID last_b = B[begin_b + 7];
+        if (last_a <= last_b) begin_a += 8;
+        if (last_b <= last_a) begin_b += 8;
+    }
+    return count + intersectSortedNodeSetNaive(A + begin_a, B + begin_b, totalA - begin_a, totalB - begin_b);
+}
+
+//same as the AVX2 version with 16 element blocks
+__attribute__((target("avx512f")))
+static size_t intersectSortedNodeSetAVX512(NodeID *A, NodeID *B, size_t totalA, size_t totalB, NodeID dest=(NodeID)INT32_MAX) {
+    totalA = sortedPrefixUpTo(A, totalA, dest);
+    totalB = sortedPrefixUpTo(B, totalB, dest);
+    size_t begin_a = 0;
+    size_t begin_b = 0;
+    size_t count = 0;
+    while (begin_a + 16 <= totalA && begin_b + 16 <= totalB) {
+        __m512i a = _mm512_loadu_si512((const void *) (A + begin_a));
+        __m512i b = _mm512_loadu_si512((const void *) (B + begin_b));
+        __mmask16 matches = _mm512_cmpeq_epi32_mask(a, b);
+        for (int r = 1; r < 16; r++) {
+            b = _mm512_alignr_epi32(b, b, 1);
+            matches |= _mm512_cmpeq_epi32_mask(a, b);
+        }
+        count += __builtin_popcount(matches);
+        NodeID last_a = A[begin_a + 15];
+        NodeID last_b = B[begin_b + 15];
+        if (last_a <= last_b) begin_a += 16;
+        if (last_b <= last_a) begin_b += 16;
+    }
+    return count + intersectSortedNodeSetNaive(A + begin_a, B + begin_b, totalA - begin_a, totalB - begin_b);
+}
+
+#endif
+
+enum class SIMDIntersectionLevel { SCALAR, AVX2, AVX512 };
+
+// widest intersection kernel the processor supports, checked with CPUID once
+static SIMDIntersectionLevel simdIntersectionLevel() {
+#if defined(GRAPHIT_X86_INTERSECTIONS)
+    static const SIMDIntersectionLevel level = __builtin_cpu_supports("avx512f") ? SIMDIntersectionLevel::AVX512
+            : __builtin_cpu_supports("avx2") ? SIMDIntersectionLevel::AVX2 : SIMDIntersectionLevel::SCALAR;
+    return level;
+#else
+    return SIMDIntersectionLevel::SCALAR;
+#endif
+}
+
+//SIMD block compare intersection, the kernel is picked at runtime (scalar merge without AVX2)
+static size_t intersectSortedNodeSetSIMD(NodeID *A, NodeID *B, size_t totalA, size_t totalB, NodeID dest=(NodeID)INT32_MAX) {
+#if defined(GRAPHIT_X86_INTERSECTIONS)
+    switch (simdIntersectionLevel()) {
+        case SIMDIntersectionLevel::AVX512:
+            return intersectSortedNodeSetAVX512(A, B, totalA, totalB, dest);
+        case SIMDIntersectionLevel::AVX2:
+            return intersectSortedNodeSetAVX2(A, B, totalA, totalB, dest);
+        default:
+            break;
+    }
+#endif
+    return intersectSortedNodeSetNaive(A, B, totalA, totalB, dest);
+}
+
 #endif
\ No newline at end of file
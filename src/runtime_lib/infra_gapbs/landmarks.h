@@ -0,0 +1,217 @@
+#ifndef LANDMARKS_H_
+#define LANDMARKS_H_
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "delta_selection.h"
+#include "eager_priority_queue.h"
+#include "ordered_processing.h"
+
+
+/**
+ * Landmark distance tables for A* with the ALT (A*, landmarks, triangle inequality) lower bound.
+ * from_[v * k + l] is the distance from landmark l to v, to_[v * k + l] the distance from v to landmark l (only
+ * stored for directed graphs, it is from_ for symmetric ones). The k distances of a node are next to each other
+ * so that a bound reads one row per endpoint.
+ * The tables can be written to a file and loaded again, so the preprocessing runs once per graph.
+ **/
+class LandmarkTable {
+
+public:
+  LandmarkTable() : num_nodes_(0), directed_(false) {}
+
+  static WeightT kDistInf(){
+    return std::numeric_limits<WeightT>::max()/2;
+  }
+
+  int num_landmarks() const {
+    return landmarks_.size();
+  }
+
+  int64_t num_nodes() const {
+    return num_nodes_;
+  }
+
+  const std::vector<NodeID>& landmarks() const {
+    return landmarks_;
+  }
+
+  /**
+   * Picks up to max_landmarks landmarks with the farthest point heuristic and computes their tables.
+   * The first landmark is the node farthest from node 0, every next one is the node whose distance to (or from) the
+   * closest landmark picked so far is the largest. Nodes that are not connected to any landmark are not picked. The
+   * distances come from one delta-stepping run per landmark, and one on the transpose for directed graphs.
+   * delta <= 0 selects delta from the graph.
+   **/
+  template <class WGraph_>
+  void build(const WGraph_ &g, int max_landmarks, WeightT delta = 0){
+    num_nodes_ = g.num_nodes();
+    directed_ = g.directed();
+    landmarks_.resize(0);
+    if (delta <= 0) delta = SelectInitialDelta(g);
+    max_landmarks = std::max<int64_t>(0, std::min<int64_t>(max_landmarks, num_nodes_));
+    std::vector<WeightT> dist(num_nodes_);
+    std::vector<WeightT> closest_landmark(num_nodes_, kDistInf());
+    std::vector<std::vector<WeightT> > from_columns;
+    std::vector<std::vector<WeightT> > to_columns;
+
+    if (num_nodes_ > 0 && max_landmarks > 0) {
+      DeltaSteppingDistances(g, false, 0, delta, dist.data());
+      NodeID next = FarthestNode(dist);
+      while (next >= 0 && (int) landmarks_.size() < max_landmarks) {
+        landmarks_.push_back(next);
+        DeltaSteppingDistances(g, false, next, delta, dist.data());
+        from_columns.push_back(dist);
+        if (directed_) {
+          DeltaSteppingDistances(g, true, next, delta, dist.data());
+          to_columns.push_back(dist);
+        }
+        const std::vector<WeightT>& from_next = from_columns.back();
+        const std::vector<WeightT>& to_next = directed_ ? to_columns.back() : from_next;
+        #pragma omp parallel for
+        for (int64_t v = 0; v < num_nodes_; v++)
+          closest_landmark[v] = std::min(closest_landmark[v], std::min(from_next[v], to_next[v]));
+        next = FarthestNode(closest_landmark);
+        // every reached node is a landmark already
+        if (next >= 0 && closest_landmark[next] == 0) next = -1;
+      }
+    }
+
+    from_.assign(num_nodes_ * num_landmarks(), kDistInf());
+    to_.assign(directed_ ? num_nodes_ * num_landmarks() : 0, kDistInf());
+    for (int l = 0; l < num_landmarks(); l++) {
+      SetColumn(from_, l, from_columns[l]);
+      if (directed_) SetColumn(to_, l, to_columns[l]);
+    }
+  }
+
+  // lower bound on the distance from v to t, both endpoints need a finite distance to use a landmark
+  WeightT lower_bound(NodeID v, NodeID t) const {
+    int k = num_landmarks();
+    const WeightT* from_v = from_.data() + (int64_t) v * k;
+    const WeightT* from_t = from_.data() + (int64_t) t * k;
+    const WeightT* to_v = (directed_ ? to_ : from_).data() + (int64_t) v * k;
+    const WeightT* to_t = (directed_ ? to_ : from_).data() + (int64_t) t * k;
+    const WeightT kInf = kDistInf();
+    WeightT bound = 0;
+    for (int l = 0; l < k; l++) {
+      // d(l, t) <= d(l, v) + d(v, t)
+      if (from_v[l] != kInf && from_t[l] != kInf)
+        bound = std::max(bound, from_t[l] - from_v[l]);
+      // d(v, l) <= d(v, t) + d(t, l)
+      if (to_v[l] != kInf && to_t[l] != kInf)
+        bound = std::max(bound, to_v[l] - to_t[l]);
+    }
+    return bound;
+  }
+
+  bool save(const std::string &file_name) const {
+    std::ofstream out(file_name, std::ios::binary);
+    if (!out.is_open())
+      return false;
+    int32_t num_landmarks = landmarks_.size();
+    char directed = directed_;
+    out.write(Magic(), kMagicSize);
+    out.write(reinterpret_cast<const char*>(&num_nodes_), sizeof(num_nodes_));
+    out.write(reinterpret_cast<const char*>(&num_landmarks), sizeof(num_landmarks));
+    out.write(&directed, sizeof(directed));
+    out.write(reinterpret_cast<const char*>(landmarks_.data()), sizeof(NodeID) * landmarks_.size());
+    out.write(reinterpret_cast<const char*>(from_.data()), sizeof(WeightT) * from_.size());
+    out.write(reinterpret_cast<const char*>(to_.data()), sizeof(WeightT) * to_.size());
+    return out.good();
+  }
+
+  // returns false (and leaves the table empty) if the file is missing, corrupt or was built for another graph
+  template <class WGraph_>
+  bool load(const WGraph_ &g, const std::string &file_name){
+    *this = LandmarkTable();
+    std::ifstream in(file_name, std::ios::binary);
+    if (!in.is_open())
+      return false;
+    char magic[kMagicSize];
+    int64_t num_nodes;
+    int32_t num_landmarks;
+    char directed;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&num_nodes), sizeof(num_nodes));
+    in.read(reinterpret_cast<char*>(&num_landmarks), sizeof(num_landmarks));
+    in.read(&directed, sizeof(directed));
+    if (!in.good() || memcmp(magic, Magic(), kMagicSize) != 0 || num_nodes != g.num_nodes() ||
+        (directed != 0) != g.directed() || num_landmarks < 0)
+      return false;
+    num_nodes_ = num_nodes;
+    directed_ = directed;
+    landmarks_.resize(num_landmarks);
+    from_.resize(num_nodes_ * num_landmarks);
+    to_.resize(directed_ ? num_nodes_ * num_landmarks : 0);
+    in.read(reinterpret_cast<char*>(landmarks_.data()), sizeof(NodeID) * landmarks_.size());
+    in.read(reinterpret_cast<char*>(from_.data()), sizeof(WeightT) * from_.size());
+    in.read(reinterpret_cast<char*>(to_.data()), sizeof(WeightT) * to_.size());
+    if (!in.good()) {
+      *this = LandmarkTable();
+      return false;
+    }
+    return true;
+  }
+
+private:
+  // first bytes of a landmark file, with the format version
+  static const char* Magic(){
+    return "GTALTv1";
+  }
+  static const size_t kMagicSize = 8;
+
+  // distances from the source over the out edges, or over the in edges (to the source) when reverse is set
+  template <class WGraph_>
+  static void DeltaSteppingDistances(const WGraph_ &g, bool reverse, NodeID source, WeightT delta, WeightT* dist){
+    #pragma omp parallel for
+    for (int64_t v = 0; v < g.num_nodes(); v++)
+      dist[v] = kDistInf();
+    dist[source] = 0;
+    EagerPriorityQueue<WeightT> pq(dist, delta);
+    auto edge_update = [&](ThreadLocalBins& local_bins, NodeID src, NodeID dst, WeightT wt) {
+      updatePriorityMin<WeightT>()(&pq, local_bins, dst, dist[dst], dist[src] + wt);
+    };
+    auto while_cond = [&]()->bool{ return !pq.finished(); };
+    if (reverse) {
+      // shares the arrays of g with the in and out edges swapped
+      WGraph_ transpose(g.num_nodes(), g.in_index_shared_, g.in_neighbors_shared_,
+                        g.out_index_shared_, g.out_neighbors_shared_, true);
+      OrderedProcessingOperatorNoMerge(&pq, transpose, while_cond, edge_update, source);
+    } else {
+      OrderedProcessingOperatorNoMerge(&pq, g, while_cond, edge_update, source);
+    }
+  }
+
+  // reached node with the largest distance, -1 if no node was reached
+  static NodeID FarthestNode(const std::vector<WeightT> &dist){
+    NodeID farthest = -1;
+    for (int64_t v = 0; v < (int64_t) dist.size(); v++) {
+      if (dist[v] != kDistInf() && (farthest < 0 || dist[v] > dist[farthest]))
+        farthest = v;
+    }
+    return farthest;
+  }
+
+  void SetColumn(std::vector<WeightT> &table, int landmark, const std::vector<WeightT> &column) const {
+    int k = num_landmarks();
+    #pragma omp parallel for
+    for (int64_t v = 0; v < num_nodes_; v++)
+      table[v * k + landmark] = column[v];
+  }
+
+  int64_t num_nodes_;
+  bool directed_;
+  std::vector<NodeID> landmarks_;
+  std::vector<WeightT> from_;
+  std::vector<WeightT> to_;
+};
+
+#endif  // LANDMARKS_H_
@@ -5,15 +5,18 @@
 #ifndef GRAPHIT_MINIMUM_SPANNING_TREE_H
 #define GRAPHIT_MINIMUM_SPANNING_TREE_H
 
+#include <algorithm>
 #include <cinttypes>
 #include <limits>
 #include <iostream>
 #include <queue>
+#include <random>
 #include <vector>
 
 #include "builder.h"
 #include "graph.h"
 #include "benchmark.h"
+#include "platform_atomics.h"
 
 
 //Takes as input a weighted graph, a starting point
@@ -51,4 +54,285 @@ static NodeID * minimum_spanning_tree(WGraph g, NodeID start){
 }
 
 
+
+/**
+ * Parallel minimum spanning forest.
+ * The edges are undirected: the out edges of a symmetric graph are taken once, every arc of a directed graph is
+ * an edge. Ties between equal weights are broken by the position of the edge in the graph, so the forest is
+ * unique. Returns a parent array where each tree is rooted at start if it contains it, at its smallest vertex
+ * otherwise, and the root is its own parent (isolated vertices are single vertex trees).
+ **/
+
+enum class MSFAlgorithm {
+  // rounds of hooking every component along its lightest edge, then contracting the edges
+  Boruvka,
+  // Kruskal on the edges lighter than a pivot, the heavier edges inside a component are filtered out before
+  // they are sorted
+  FilterKruskal
+};
+
+struct MSFEdge {
+  NodeID u;
+  NodeID v;
+  WeightT w;
+  // position in the graph, orders the edges of the same weight (MSFCollectEdges rejects graphs of 2^32 edges)
+  uint32_t id;
+};
+
+// weight in the high bits (with the sign bit flipped to order negative weights first), id in the low bits
+static inline uint64_t MSFEdgeKey(const MSFEdge &e){
+  return ((uint64_t) ((uint32_t) e.w ^ 0x80000000u) << 32) | e.id;
+}
+
+/**
+ * Concurrent union-find. The root of a set is its smallest vertex: unite links the larger root under the smaller
+ * one with a compare and swap, which cannot create cycles, and find halves the paths it walks.
+ **/
+class ParallelUnionFind {
+
+public:
+  explicit ParallelUnionFind(int64_t num_nodes) : parent_(num_nodes) {
+    #pragma omp parallel for
+    for (int64_t v = 0; v < num_nodes; v++)
+      parent_[v] = v;
+  }
+
+  NodeID find(NodeID v){
+    while (true) {
+      NodeID p = parent_[v];
+      NodeID gp = parent_[p];
+      if (p == gp) return p;
+      compare_and_swap(parent_[v], p, gp);
+      v = gp;
+    }
+  }
+
+  // returns false if u and v were in the same set already
+  bool unite(NodeID u, NodeID v){
+    while (true) {
+      u = find(u);
+      v = find(v);
+      if (u == v) return false;
+      if (u > v) std::swap(u, v);
+      if (compare_and_swap(parent_[v], v, u)) return true;
+    }
+  }
+
+private:
+  pvector<NodeID> parent_;
+};
+
+// exclusive prefix sum, the blocks are scanned in parallel. Returns the total
+static int64_t MSFExclusiveSum(std::vector<int64_t> &values){
+  const int64_t kBlockSize = 1 << 16;
+  int64_t n = values.size();
+  int64_t num_blocks = (n + kBlockSize - 1) / kBlockSize;
+  std::vector<int64_t> block_offsets(num_blocks + 1, 0);
+  #pragma omp parallel for
+  for (int64_t b = 0; b < num_blocks; b++) {
+    int64_t sum = 0;
+    for (int64_t i = b * kBlockSize; i < std::min(n, (b + 1) * kBlockSize); i++)
+      sum += values[i];
+    block_offsets[b + 1] = sum;
+  }
+  for (int64_t b = 0; b < num_blocks; b++)
+    block_offsets[b + 1] += block_offsets[b];
+  #pragma omp parallel for
+  for (int64_t b = 0; b < num_blocks; b++) {
+    int64_t sum = block_offsets[b];
+    for (int64_t i = b * kBlockSize; i < std::min(n, (b + 1) * kBlockSize); i++) {
+      int64_t value = values[i];
+      values[i] = sum;
+      sum += value;
+    }
+  }
+  return block_offsets[num_blocks];
+}
+
+// the elements of in that satisfy keep, in their order
+template <typename T, typename P>
+static std::vector<T> MSFPack(const std::vector<T> &in, P keep){
+  const int64_t kBlockSize = 1 << 12;
+  int64_t n = in.size();
+  int64_t num_blocks = (n + kBlockSize - 1) / kBlockSize;
+  std::vector<int64_t> offsets(num_blocks);
+  #pragma omp parallel for
+  for (int64_t b = 0; b < num_blocks; b++) {
+    int64_t count = 0;
+    for (int64_t i = b * kBlockSize; i < std::min(n, (b + 1) * kBlockSize); i++)
+      count += keep(in[i]) ? 1 : 0;
+    offsets[b] = count;
+  }
+  std::vector<T> out(MSFExclusiveSum(offsets));
+  #pragma omp parallel for
+  for (int64_t b = 0; b < num_blocks; b++) {
+    int64_t pos = offsets[b];
+    for (int64_t i = b * kBlockSize; i < std::min(n, (b + 1) * kBlockSize); i++) {
+      if (keep(in[i])) out[pos++] = in[i];
+    }
+  }
+  return out;
+}
+
+static std::vector<MSFEdge> MSFCollectEdges(const WGraph &g){
+  bool symmetric = !g.directed();
+  std::vector<int64_t> offsets(g.num_nodes());
+  #pragma omp parallel for schedule(dynamic, 1024)
+  for (NodeID u = 0; u < g.num_nodes(); u++) {
+    int64_t count = 0;
+    for (WNode wn : g.out_neigh(u))
+      count += (wn.v != u && (!symmetric || u < wn.v)) ? 1 : 0;
+    offsets[u] = count;
+  }
+  int64_t num_edges = MSFExclusiveSum(offsets);
+  // the ids share the 64 bit sort key with the weights, wrapped ids would break the ties between equal weights
+  if (num_edges > (int64_t) std::numeric_limits<uint32_t>::max()) {
+    std::cout << "minimum spanning forest supports up to 2^32 - 1 edges, the graph has " << num_edges << std::endl;
+    std::exit(-1);
+  }
+  std::vector<MSFEdge> edges(num_edges);
+  #pragma omp parallel for schedule(dynamic, 1024)
+  for (NodeID u = 0; u < g.num_nodes(); u++) {
+    int64_t pos = offsets[u];
+    for (WNode wn : g.out_neigh(u)) {
+      if (wn.v != u && (!symmetric || u < wn.v)) {
+        edges[pos] = {u, wn.v, wn.w, (uint32_t) pos};
+        pos++;
+      }
+    }
+  }
+  return edges;
+}
+
+static void MSFWriteMin(uint64_t &x, uint64_t value){
+  uint64_t old_value = x;
+  while (value < old_value && !compare_and_swap(x, old_value, value))
+    old_value = x;
+}
+
+// marks the forest edges in in_forest, the endpoints of the live edges are replaced by their component
+static void BoruvkaMSF(int64_t num_nodes, std::vector<MSFEdge> live, ParallelUnionFind &uf,
+                       std::vector<uint8_t> &in_forest, const std::vector<MSFEdge> &edges){
+  const uint64_t kNoEdge = std::numeric_limits<uint64_t>::max();
+  pvector<uint64_t> lightest(num_nodes, kNoEdge);
+  while (!live.empty()) {
+    // lightest edge leaving each component
+    #pragma omp parallel for
+    for (size_t i = 0; i < live.size(); i++) {
+      uint64_t key = MSFEdgeKey(live[i]);
+      MSFWriteMin(lightest[live[i].u], key);
+      MSFWriteMin(lightest[live[i].v], key);
+    }
+    // hooks the components, the lightest edges form a forest so a unite only fails for an edge picked by both
+    // of its endpoints
+    #pragma omp parallel for
+    for (size_t i = 0; i < live.size(); i++) {
+      uint64_t key = MSFEdgeKey(live[i]);
+      if (lightest[live[i].u] == key || lightest[live[i].v] == key) {
+        const MSFEdge &e = edges[live[i].id];
+        if (uf.unite(e.u, e.v)) in_forest[live[i].id] = 1;
+      }
+    }
+    #pragma omp parallel for
+    for (size_t i = 0; i < live.size(); i++) {
+      lightest[live[i].u] = kNoEdge;
+      lightest[live[i].v] = kNoEdge;
+    }
+    // contracts the edges onto the new components and drops the ones inside a component
+    #pragma omp parallel for
+    for (size_t i = 0; i < live.size(); i++) {
+      live[i].u = uf.find(live[i].u);
+      live[i].v = uf.find(live[i].v);
+    }
+    live = MSFPack(live, [](const MSFEdge &e) { return e.u != e.v; });
+  }
+}
+
+static void FilterKruskalMSF(std::vector<MSFEdge> edges, ParallelUnionFind &uf, std::vector<uint8_t> &in_forest,
+                             std::mt19937 &rng){
+  const size_t kKruskalSize = 1 << 14;
+  if (edges.size() <= kKruskalSize) {
+    std::sort(edges.begin(), edges.end(),
+              [](const MSFEdge &a, const MSFEdge &b) { return MSFEdgeKey(a) < MSFEdgeKey(b); });
+    for (const MSFEdge &e : edges) {
+      if (uf.unite(e.u, e.v)) in_forest[e.id] = 1;
+    }
+    return;
+  }
+  // median of a sample as the pivot
+  std::vector<uint64_t> sample(31);
+  for (uint64_t &key : sample)
+    key = MSFEdgeKey(edges[rng() % edges.size()]);
+  std::nth_element(sample.begin(), sample.begin() + sample.size() / 2, sample.end());
+  uint64_t pivot = sample[sample.size() / 2];
+  std::vector<MSFEdge> heavy = MSFPack(edges, [&](const MSFEdge &e) { return MSFEdgeKey(e) > pivot; });
+  edges = MSFPack(edges, [&](const MSFEdge &e) { return MSFEdgeKey(e) <= pivot; });
+  FilterKruskalMSF(std::move(edges), uf, in_forest, rng);
+  heavy = MSFPack(heavy, [&](const MSFEdge &e) { return uf.find(e.u) != uf.find(e.v); });
+  FilterKruskalMSF(std::move(heavy), uf, in_forest, rng);
+}
+
+// roots the trees of the forest edges with a breadth first search from all the roots
+static NodeID* MSFRootForest(int64_t num_nodes, NodeID start, const std::vector<MSFEdge> &forest,
+                             ParallelUnionFind &uf){
+  std::vector<int64_t> offsets(num_nodes + 1, 0);
+  #pragma omp parallel for
+  for (size_t i = 0; i < forest.size(); i++) {
+    fetch_and_add(offsets[forest[i].u], 1);
+    fetch_and_add(offsets[forest[i].v], 1);
+  }
+  MSFExclusiveSum(offsets);
+  std::vector<int64_t> fill(offsets.begin(), offsets.end() - 1);
+  std::vector<NodeID> neighbors(2 * forest.size());
+  #pragma omp parallel for
+  for (size_t i = 0; i < forest.size(); i++) {
+    neighbors[fetch_and_add(fill[forest[i].u], 1)] = forest[i].v;
+    neighbors[fetch_and_add(fill[forest[i].v], 1)] = forest[i].u;
+  }
+
+  NodeID* parent = new NodeID[num_nodes];
+  NodeID start_component = uf.find(start);
+  std::vector<NodeID> queue(num_nodes);
+  int64_t tail = 0;
+  #pragma omp parallel for
+  for (NodeID v = 0; v < num_nodes; v++) {
+    parent[v] = -1;
+    NodeID component = uf.find(v);
+    if (v == start || (component == v && component != start_component)) {
+      parent[v] = v;
+      queue[fetch_and_add(tail, 1)] = v;
+    }
+  }
+  int64_t head = 0;
+  while (head < tail) {
+    int64_t level_end = tail;
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (int64_t i = head; i < level_end; i++) {
+      NodeID u = queue[i];
+      for (int64_t j = offsets[u]; j < offsets[u + 1]; j++) {
+        NodeID v = neighbors[j];
+        if (parent[v] == -1 && compare_and_swap(parent[v], (NodeID) -1, u))
+          queue[fetch_and_add(tail, 1)] = v;
+      }
+    }
+    head = level_end;
+  }
+  return parent;
+}
+
+static NodeID* minimum_spanning_forest(const WGraph &g, NodeID start,
+                                       MSFAlgorithm algorithm = MSFAlgorithm::Boruvka){
+  std::vector<MSFEdge> edges = MSFCollectEdges(g);
+  ParallelUnionFind uf(g.num_nodes());
+  std::vector<uint8_t> in_forest(edges.size(), 0);
+  if (algorithm == MSFAlgorithm::Boruvka) {
+    BoruvkaMSF(g.num_nodes(), edges, uf, in_forest, edges);
+  } else {
+    std::mt19937 rng(27491095);
+    FilterKruskalMSF(edges, uf, in_forest, rng);
+  }
+  std::vector<MSFEdge> forest = MSFPack(edges, [&](const MSFEdge &e) { return in_forest[e.id] != 0; });
+  return MSFRootForest(g.num_nodes(), start, forest, uf);
+}
+
 #endif //GRAPHIT_MINIMUM_SPANNING_TREE_H
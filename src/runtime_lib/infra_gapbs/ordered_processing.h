@@ -1,8 +1,12 @@
 #ifndef ORDERED_PROCESSING_H_
 #define ORDERED_PROCESSING_H_
 
+#include <atomic>
+
 #include "graph.h"
 #include "eager_priority_queue.h"
+#include "relaxed_multiqueue.h"
+#include "thread_local_bins.h"
 
 
 using namespace std;
@@ -15,7 +19,7 @@ template <typename PriorityT_>
 struct updatePriorityMin
 {
   void operator()(EagerPriorityQueue<PriorityT_>* pq, 
-  					vector<vector<NodeID> >& local_bins,
+  					ThreadLocalBins& local_bins,
   					NodeID dst, PriorityT_ old_val, 
 		  PriorityT_ new_val){
     if (new_val < old_val) {
@@ -32,49 +36,184 @@ struct updatePriorityMin
       	size_t dest_bin;
       	if (pq->delta_ != 1) dest_bin = new_val/pq->delta_;
       	else dest_bin = new_val;
-      	
-        if (dest_bin >= local_bins.size()) {
-	  local_bins.resize(dest_bin+1);
+
+        local_bins.push(dest_bin, dst);
+      }
+    }
+  }
+
+  // used by the relaxed multiqueue, the updated nodes are collected with their bins in a flat local buffer
+  void operator()(EagerPriorityQueue<PriorityT_>* pq,
+  					vector<pair<size_t, NodeID> >& local_bins,
+  					NodeID dst, PriorityT_ old_val,
+		  PriorityT_ new_val){
+    if (new_val < old_val) {
+      bool changed_dist = true;
+      while (!compare_and_swap(pq->priorities_[dst], old_val, new_val)) {
+        old_val = pq->priorities_[dst];
+        if (old_val <= new_val) {
+          changed_dist = false;
+          break;
         }
-        local_bins[dest_bin].push_back(dst);
       }
+      if (changed_dist) {
+      	size_t dest_bin;
+      	if (pq->delta_ != 1) dest_bin = new_val/pq->delta_;
+      	else dest_bin = new_val;
+        local_bins.push_back(make_pair(dest_bin, dst));
+      }
+    }
+  }
+};
+
+
+// called by all the threads once the next bin is known, adapts delta and rebins the nodes when it changed
+template <typename PriorityT_>
+void AdaptDeltaBetweenRounds(EagerPriorityQueue<PriorityT_>* pq, ThreadLocalBins& local_bins,
+                             size_t &next_bin_index, size_t curr_frontier_tail){
+  #pragma omp single
+  {
+    size_t min_round_size = 128;
+#if defined(OPENMP)
+    min_round_size *= omp_get_num_threads();
+#endif
+    pq->delta_changed_ = next_bin_index != kMaxBin && pq->adapt_delta(curr_frontier_tail, min_round_size);
+    if (pq->delta_changed_) {
+      pq->prev_next_bin_ = next_bin_index;
+      next_bin_index = kMaxBin;
     }
   }
+  if (pq->delta_changed_) {
+    size_t local_min_bin = local_bins.rebin(pq, pq->prev_delta_, pq->prev_next_bin_);
+    #pragma omp critical
+    next_bin_index = min(next_bin_index, local_min_bin);
+    #pragma omp barrier
+  }
+}
+
+// the frontier of a round is made of one chunk per thread, chunk_offsets holds their prefix sums
+inline NodeID FrontierNode(const vector<vector<NodeID> >& frontier, const vector<size_t>& chunk_offsets, size_t i){
+  size_t chunk = upper_bound(chunk_offsets.begin(), chunk_offsets.end(), i) - chunk_offsets.begin() - 1;
+  return frontier[chunk][i - chunk_offsets[chunk]];
+}
+
+inline void ComputeFrontierChunkOffsets(const vector<vector<NodeID> >& frontier, vector<size_t>& chunk_offsets){
+  chunk_offsets.resize(frontier.size() + 1);
+  chunk_offsets[0] = 0;
+  for (size_t t = 0; t < frontier.size(); t++) {
+    chunk_offsets[t+1] = chunk_offsets[t] + frontier[t].size();
+  }
+}
+
+// every thread moves its part of the next bin into its chunk of the frontier
+template <typename PriorityT_>
+void MoveNextBinToFrontier(EagerPriorityQueue<PriorityT_>* pq, ThreadLocalBins& local_bins,
+                           vector<NodeID>& frontier_chunk, size_t next_bin_index, size_t &next_frontier_tail){
+  frontier_chunk.resize(0);
+  if (next_bin_index != kMaxBin) {
+    local_bins.advance(next_bin_index, pq);
+    frontier_chunk.swap(local_bins.bin(next_bin_index));
+    fetch_and_add(next_frontier_tail, frontier_chunk.size());
+  }
+}
+
+// default source filter: skips frontier nodes whose priority was improved into a bin that was processed already
+template <typename PriorityT_>
+struct PriorityAtLeastCurrentBin
+{
+  EagerPriorityQueue<PriorityT_>* pq;
+
+  bool operator()(NodeID u) const {
+    return pq->priorities_[u] >= (PriorityT_) (pq->delta_*pq->get_current_priority());
+  }
 };
 
+// the edge update function takes the weight of the edge only for weighted graphs
+template <class EdgeApplyFunc, class LocalBins_, class WeightT_>
+inline void ApplyOrderedEdge(EdgeApplyFunc& edge_apply, LocalBins_& local_bins, NodeID u,
+                             const NodeWeight<NodeID, WeightT_>& wn){
+  edge_apply(local_bins, u, wn.v, wn.w);
+}
+
+template <class EdgeApplyFunc, class LocalBins_>
+inline void ApplyOrderedEdge(EdgeApplyFunc& edge_apply, LocalBins_& local_bins, NodeID u, NodeID v){
+  edge_apply(local_bins, u, v);
+}
+
+template <class Graph_, class EdgeApplyFunc, class LocalBins_>
+inline void ApplyOrderedOutEdges(const Graph_& g, EdgeApplyFunc& edge_apply, LocalBins_& local_bins, NodeID u){
+  for (auto wn : g.out_neigh(u)) {
+    ApplyOrderedEdge(edge_apply, local_bins, u, wn);
+  }
+}
+
+// without a source node, the first frontier is made of all the nodes that have a priority (below the kDistInf of pq).
+// Called by all the threads, the first bin and the size of its frontier end up in the first round's slots of pq.
+template <typename PriorityT_>
+void SeedFrontierFromPriorities(EagerPriorityQueue<PriorityT_>* pq, ThreadLocalBins& local_bins,
+                                vector<NodeID>& frontier_chunk, int64_t num_nodes){
+  #pragma omp for nowait schedule(static)
+  for (int64_t v = 0; v < num_nodes; v++) {
+    if (pq->priorities_[v] < pq->kDistInf)
+      local_bins.push(pq->priorities_[v]/pq->delta_, v);
+  }
+  size_t local_first_bin = local_bins.next_bin();
+  if (local_first_bin != kMaxBin) {
+    #pragma omp critical
+    pq->shared_indexes[0] = min(pq->shared_indexes[0], local_first_bin);
+  }
+  #pragma omp barrier
+  MoveNextBinToFrontier(pq, local_bins, frontier_chunk, pq->shared_indexes[0], pq->frontier_tails[0]);
+  #pragma omp barrier
+}
 
-template< class Priority, class EdgeApplyFunc , class WhileCond>
-  void OrderedProcessingOperatorNoMerge(EagerPriorityQueue<Priority>* pq, const WGraph &g, WhileCond while_cond, EdgeApplyFunc edge_apply,  NodeID optional_source_node){
 
-  pvector<NodeID> frontier(g.num_edges_directed());
+/**
+ * Eager ordered processing (bucket fusion), round by round over the buckets kept in thread local bins.
+ * The graph can be weighted or not. src_filter decides whether a node of the frontier is processed,
+ * optional_source_node is the first frontier, or -1 to start from every node that has a priority.
+ **/
+template< class Priority, class Graph_, class EdgeApplyFunc , class WhileCond, class SrcFilter>
+  void OrderedProcessingOperatorNoMerge(EagerPriorityQueue<Priority>* pq, const Graph_ &g, WhileCond while_cond, EdgeApplyFunc edge_apply, SrcFilter src_filter, NodeID optional_source_node){
+
+  // one chunk per thread, filled from the thread local bins, so the frontier only takes the size of the buckets
+  vector<vector<NodeID> > frontier;
   // two element arrays for double buffering curr=iter&1, next=(iter+1)&1
   //size_t shared_indexes[2] = {0, kMaxBin};
   //size_t frontier_tails[2] = {1, 0};
 
   pq->init_indexes_tails();
-  
-  //optional source node
-
-
-  frontier[0] = optional_source_node;
 
 //  int round = 0;
   
   #pragma omp parallel
   {
-    vector<vector<NodeID> > local_bins(0);
+    int thread_id = 0;
+#if defined(OPENMP)
+    thread_id = omp_get_thread_num();
+#endif
+    #pragma omp single
+    {
+      int num_threads = 1;
+#if defined(OPENMP)
+      num_threads = omp_get_num_threads();
+#endif
+      frontier.resize(num_threads);
+      //optional source node
+      if (optional_source_node >= 0) {
+        frontier[0].push_back(optional_source_node);
+      } else {
+        pq->shared_indexes[0] = kMaxBin;
+        pq->frontier_tails[0] = 0;
+      }
+    }
+    ThreadLocalBins local_bins(pq->num_open_buckets_);
+    if (optional_source_node < 0) {
+      SeedFrontierFromPriorities(pq, local_bins, frontier[thread_id], g.num_nodes());
+    }
+    vector<size_t> chunk_offsets;
     size_t iter = 0;
     while (while_cond()) {
-      //TODO: refactor to use user supplied 
-      // while (user_supplied_condition())
-
-      // size_t &curr_bin_index = shared_indexes[iter&1];
-//       size_t &next_bin_index = shared_indexes[(iter+1)&1];
-//       size_t &curr_frontier_tail = frontier_tails[iter&1];
-//       size_t &next_frontier_tail = frontier_tails[(iter+1)&1];
-
-
-
       size_t &curr_bin_index = pq->shared_indexes[iter&1];
       size_t &next_bin_index = pq->shared_indexes[(iter+1)&1];
       size_t &curr_frontier_tail = pq->frontier_tails[iter&1];
@@ -84,35 +223,31 @@ template< class Priority, class EdgeApplyFunc , class WhileCond>
 //      round++;
 //      std::cout << " round: " << round << std::endl;
 //      std::cout << " frontier size: " << curr_frontier_tail << std::endl;
-//      for (size_t i=0; i < curr_frontier_tail; i++) {
-//          NodeID u = frontier[i];
-//          std::cout << u << " ";
-//      }
-//      std::cout << std::endl;
+
+      ComputeFrontierChunkOffsets(frontier, chunk_offsets);
 
       #pragma omp for nowait schedule(dynamic, 64)
       for (size_t i=0; i < curr_frontier_tail; i++) {
-        NodeID u = frontier[i];
-	//TODO: need to refactor to use user supplied filtering on the source node
-        //if (src_filter(u)) { //hard code this into the library
-	if (pq->priorities_[u] >= pq->delta_*pq->get_current_priority()){
-          for (WNode wn : g.out_neigh(u)) {
-             edge_apply(local_bins, u, wn.v, wn.w);
-          }
- 
-    } //end of if statement
+        NodeID u = FrontierNode(frontier, chunk_offsets, i);
+        if (src_filter(u)) {
+          ApplyOrderedOutEdges(g, edge_apply, local_bins, u);
+        }
     }//going through current frontier for end
 
-      //searching for the next priority
+      if (pq->adaptive_delta_) {
+        fetch_and_add(pq->round_reinserted_, local_bins.bin(curr_bin_index).size());
+      }
 
-      for (size_t i=pq->get_current_priority(); i < local_bins.size(); i++) {
-        if (!local_bins[i].empty()) {
-          #pragma omp critical
-          next_bin_index = min(next_bin_index, i);
-          break;
-        }
+      //searching for the next priority
+      size_t local_next_bin = local_bins.next_bin();
+      if (local_next_bin != kMaxBin) {
+        #pragma omp critical
+        next_bin_index = min(next_bin_index, local_next_bin);
       }
       #pragma omp barrier
+      if (pq->adaptive_delta_) {
+        AdaptDeltaBetweenRounds(pq, local_bins, next_bin_index, curr_frontier_tail);
+      }
       #pragma omp single nowait
       {
       //t.Stop();
@@ -123,13 +258,7 @@ template< class Priority, class EdgeApplyFunc , class WhileCond>
 	// need to make srue we increment it from only one thread
 	pq->increment_iter();
       }
-      if (next_bin_index < local_bins.size()) {
-        size_t copy_start = fetch_and_add(next_frontier_tail,
-                                          local_bins[next_bin_index].size());
-        copy(local_bins[next_bin_index].begin(),
-             local_bins[next_bin_index].end(), frontier.data() + copy_start);
-        local_bins[next_bin_index].resize(0);
-      }
+      MoveNextBinToFrontier(pq, local_bins, frontier[thread_id], next_bin_index, next_frontier_tail);
       iter++;
       
       #pragma omp barrier
@@ -143,81 +272,89 @@ template< class Priority, class EdgeApplyFunc , class WhileCond>
 
 
 
-template<class Priority,  class WhileCond, class EdgeApplyFunc >
-  void OrderedProcessingOperatorWithMerge(EagerPriorityQueue<Priority>* pq, const WGraph &g,  WhileCond while_cond, EdgeApplyFunc edge_apply, int bin_size_threshold = 1000, NodeID optional_source_node=-1){
+// same as OrderedProcessingOperatorNoMerge, but a thread keeps processing the current bin locally while it is small
+template<class Priority, class Graph_, class WhileCond, class EdgeApplyFunc, class SrcFilter>
+  void OrderedProcessingOperatorWithMerge(EagerPriorityQueue<Priority>* pq, const Graph_ &g,  WhileCond while_cond, EdgeApplyFunc edge_apply, SrcFilter src_filter, int bin_size_threshold, NodeID optional_source_node){
 
-  pvector<NodeID> frontier(g.num_edges_directed());
+  // one chunk per thread, filled from the thread local bins, so the frontier only takes the size of the buckets
+  vector<vector<NodeID> > frontier;
   // two element arrays for double buffering curr=iter&1, next=(iter+1)&1
   //size_t shared_indexes[2] = {0, kMaxBin};
   //size_t frontier_tails[2] = {1, 0};
 
   pq->init_indexes_tails();
   
-  //optional source node
-
-
-  frontier[0] = optional_source_node;
-  
   #pragma omp parallel
   {
-    vector<vector<NodeID> > local_bins(0);
+    int thread_id = 0;
+#if defined(OPENMP)
+    thread_id = omp_get_thread_num();
+#endif
+    #pragma omp single
+    {
+      int num_threads = 1;
+#if defined(OPENMP)
+      num_threads = omp_get_num_threads();
+#endif
+      frontier.resize(num_threads);
+      //optional source node
+      if (optional_source_node >= 0) {
+        frontier[0].push_back(optional_source_node);
+      } else {
+        pq->shared_indexes[0] = kMaxBin;
+        pq->frontier_tails[0] = 0;
+      }
+    }
+    ThreadLocalBins local_bins(pq->num_open_buckets_);
+    if (optional_source_node < 0) {
+      SeedFrontierFromPriorities(pq, local_bins, frontier[thread_id], g.num_nodes());
+    }
+    vector<size_t> chunk_offsets;
+    vector<NodeID> cur_bin_nodes;
     size_t iter = 0;
     while (while_cond()) {
-      //TODO: refactor to use user supplied 
-      // while (user_supplied_condition())
-
-      // size_t &curr_bin_index = shared_indexes[iter&1];
-//       size_t &next_bin_index = shared_indexes[(iter+1)&1];
-//       size_t &curr_frontier_tail = frontier_tails[iter&1];
-//       size_t &next_frontier_tail = frontier_tails[(iter+1)&1];
-
-
       size_t &curr_bin_index = pq->shared_indexes[iter&1];
       size_t &next_bin_index = pq->shared_indexes[(iter+1)&1];
       size_t &curr_frontier_tail = pq->frontier_tails[iter&1];
       size_t &next_frontier_tail = pq->frontier_tails[(iter+1)&1];
 
+      ComputeFrontierChunkOffsets(frontier, chunk_offsets);
+
       #pragma omp for nowait schedule(dynamic, 64)
       for (size_t i=0; i < curr_frontier_tail; i++) {
-        NodeID u = frontier[i];
-	//TODO: need to refactor to use user supplied filtering on the source node
-        //if (src_filter(u)) {
-	if (pq->priorities_[u] >= pq->delta_*pq->get_current_priority()){
-          for (WNode wn : g.out_neigh(u)) {
-             edge_apply(local_bins, u, wn.v, wn.w);
-          }
- 
-    } //end of if statement
+        NodeID u = FrontierNode(frontier, chunk_offsets, i);
+        if (src_filter(u)) {
+          ApplyOrderedOutEdges(g, edge_apply, local_bins, u);
+        }
     }//going through current frontier for end
 
 
-
-      while (local_bins.size() > 0 && curr_bin_index < local_bins.size() && !local_bins[curr_bin_index].empty()){
-      size_t cur_bin_size = local_bins[curr_bin_index].size();
-      if (cur_bin_size > bin_size_threshold) break;
-
-        vector<NodeID> cur_bin_copy = local_bins[curr_bin_index];
-        local_bins[curr_bin_index].resize(0);
-        for (size_t i=0; i < cur_bin_size; i++) {
-          NodeID u = cur_bin_copy[i];
-          //if (src_filter(u)) {
-	  if (pq->priorities_[u] >= pq->delta_*pq->get_current_priority()){
-              for (WNode wn : g.out_neigh(u)) {  
-                 edge_apply(local_bins, u, wn.v, wn.w);
-              }
+      // keep processing the current bin locally while it is small
+      while (!local_bins.bin(curr_bin_index).empty()
+             && local_bins.bin(curr_bin_index).size() <= (size_t) bin_size_threshold){
+        cur_bin_nodes.swap(local_bins.bin(curr_bin_index));
+        for (NodeID u : cur_bin_nodes) {
+          if (src_filter(u)) {
+            ApplyOrderedOutEdges(g, edge_apply, local_bins, u);
           }
         }
+        cur_bin_nodes.resize(0);
     }
-      //searching for the next priority
 
-      for (size_t i=pq->get_current_priority(); i < local_bins.size(); i++) {
-        if (!local_bins[i].empty()) {
-          #pragma omp critical
-          next_bin_index = min(next_bin_index, i);
-          break;
-        }
+      if (pq->adaptive_delta_) {
+        fetch_and_add(pq->round_reinserted_, local_bins.bin(curr_bin_index).size());
+      }
+
+      //searching for the next priority
+      size_t local_next_bin = local_bins.next_bin();
+      if (local_next_bin != kMaxBin) {
+        #pragma omp critical
+        next_bin_index = min(next_bin_index, local_next_bin);
       }
       #pragma omp barrier
+      if (pq->adaptive_delta_) {
+        AdaptDeltaBetweenRounds(pq, local_bins, next_bin_index, curr_frontier_tail);
+      }
       #pragma omp single nowait
       {
       //t.Stop();
@@ -228,13 +365,7 @@ template<class Priority,  class WhileCond, class EdgeApplyFunc >
 	// need to make srue we increment it from only one thread
 	pq->increment_iter();
       }
-      if (next_bin_index < local_bins.size()) {
-        size_t copy_start = fetch_and_add(next_frontier_tail,
-                                          local_bins[next_bin_index].size());
-        copy(local_bins[next_bin_index].begin(),
-             local_bins[next_bin_index].end(), frontier.data() + copy_start);
-        local_bins[next_bin_index].resize(0);
-      }
+      MoveNextBinToFrontier(pq, local_bins, frontier[thread_id], next_bin_index, next_frontier_tail);
       iter++;
       
       #pragma omp barrier
@@ -246,4 +377,276 @@ template<class Priority,  class WhileCond, class EdgeApplyFunc >
 
 }
 
+/**
+ * Asynchronous ordered processing with a relaxed concurrent priority queue (MultiQueue).
+ * There are no rounds and no barriers, every thread pops an approximately highest priority node, relaxes its
+ * out edges and pushes the updated nodes back. The while condition is evaluated per node with the thread at
+ * the priority of that node, so a node is only dropped when nodes of its priority can no longer matter
+ * (e.g. the destination of a point to point shortest path is already closer than the node).
+ * pending counts the nodes that are queued or being processed, the operator is done when it drops to zero.
+ * src_filter is evaluated with the thread at the bin the node was pushed with.
+ **/
+template<class Priority, class Graph_, class WhileCond, class EdgeApplyFunc, class SrcFilter>
+  void OrderedProcessingOperatorRelaxedMultiQueue(EagerPriorityQueue<Priority>* pq, const Graph_ &g,  WhileCond while_cond, EdgeApplyFunc edge_apply, SrcFilter src_filter, int relaxation_factor, NodeID optional_source_node){
+
+  int num_threads = 1;
+#if defined(OPENMP)
+  num_threads = omp_get_max_threads();
+#endif
+  RelaxedMultiQueue<NodeID> mq(num_threads, relaxation_factor);
+  std::atomic<int64_t> pending(optional_source_node >= 0 ? 1 : 0);
+  // smallest bin of a node dropped by the while condition, stays kMaxBin when the queue ran empty
+  size_t min_dropped_bin = kMaxBin;
+
+  pq->init_indexes_tails();
+  pq->relaxed_ = true;
+
+  if (optional_source_node >= 0) {
+    uint64_t source_seed = RelaxedMultiQueue<NodeID>::init_seed(num_threads);
+    mq.push(make_pair((size_t) (pq->priorities_[optional_source_node]/pq->delta_), optional_source_node), source_seed);
+  }
+
+  #pragma omp parallel
+  {
+    int thread_id = 0;
+#if defined(OPENMP)
+    thread_id = omp_get_thread_num();
+#endif
+    uint64_t seed = RelaxedMultiQueue<NodeID>::init_seed(thread_id);
+    vector<pair<size_t, NodeID> > local_bins;
+    size_t local_min_dropped_bin = kMaxBin;
+    pair<size_t, NodeID> item;
+
+    if (optional_source_node < 0) {
+      // start from every node that has a priority (below the kDistInf of pq)
+      #pragma omp for schedule(static)
+      for (int64_t v = 0; v < g.num_nodes(); v++) {
+        if (pq->priorities_[v] < pq->kDistInf) {
+          pending.fetch_add(1, std::memory_order_relaxed);
+          mq.push(make_pair((size_t) (pq->priorities_[v]/pq->delta_), (NodeID) v), seed);
+        }
+      }
+    }
+
+    while (pending.load(std::memory_order_acquire) > 0) {
+      if (!mq.try_pop(item, seed)) continue;
+      size_t bin = item.first;
+      NodeID u = item.second;
+      pq->set_thread_priority(bin);
+
+      if (!while_cond()) {
+        local_min_dropped_bin = min(local_min_dropped_bin, bin);
+      } else if (src_filter(u)) {
+        // the default filter skips nodes whose priority was improved after they were pushed
+        ApplyOrderedOutEdges(g, edge_apply, local_bins, u);
+        if (!local_bins.empty()) {
+          // account for the children before retiring the parent, so that pending never reaches zero early
+          pending.fetch_add(local_bins.size(), std::memory_order_acq_rel);
+          for (auto &child : local_bins) {
+            mq.push(child, seed);
+          }
+          local_bins.resize(0);
+        }
+      }
+      pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    #pragma omp critical
+    min_dropped_bin = min(min_dropped_bin, local_min_dropped_bin);
+  }//end of pragma omp parallel
+
+  pq->relaxed_ = false;
+  pq->shared_indexes[pq->iter_&1] = min_dropped_bin;
+}
+
+// nodes of the current bin that are still waiting to be processed, entries left behind by nodes that moved to a
+// lower bin or that were processed already are dropped (lazy re-insertion leaves the old entries in the bins)
+template <typename PriorityT_>
+void FilterConstSumFrontier(EagerPriorityQueue<PriorityT_>* pq, vector<uint8_t>& processed,
+                            vector<NodeID>& frontier_chunk, size_t curr_bin_index){
+  size_t kept = 0;
+  for (NodeID v : frontier_chunk) {
+    if ((size_t) (pq->priorities_[v]/pq->delta_) <= curr_bin_index
+        && compare_and_swap(processed[v], (uint8_t) 0, (uint8_t) 1))
+      frontier_chunk[kept++] = v;
+  }
+  frontier_chunk.resize(kept);
+}
+
+// sets the new priority of v, a node that drops into the current bin is processed in the current bin,
+// any other node is only pushed again when it moves to another bin. Returns true if v joined the current bin.
+template <typename PriorityT_>
+inline bool ApplyConstSumPriority(EagerPriorityQueue<PriorityT_>* pq, ThreadLocalBins& local_bins,
+                                  vector<uint8_t>& processed, NodeID v, PriorityT_ new_val, size_t curr_bin_index){
+  PriorityT_ old_val = pq->priorities_[v];
+  if (new_val == old_val)
+    return false;
+  pq->priorities_[v] = new_val;
+  size_t new_bin = new_val/pq->delta_;
+  if (new_bin <= curr_bin_index) {
+    processed[v] = 1;
+    return true;
+  }
+  if (new_bin != (size_t) (old_val/pq->delta_))
+    local_bins.push(new_bin, v);
+  return false;
+}
+
+/**
+ * Ordered processing for priorities that change by a constant sum per processed neighbor
+ * (k-core: updatePrioritySum(dst, -1, k)), the nodes are processed bin by bin starting from all of them.
+ * Instead of one atomic update per edge, every step counts the processed neighbors of the unprocessed nodes into
+ * a histogram, and priority_func(v, count) gives the new priority of every affected node once.
+ * Nodes that drop into the current bin become the next step of the bin without going through the bins, and once
+ * a step has at most bin_size_threshold nodes one thread processes the rest of the bin on its own (bucket fusion).
+ * frontier_size_func(n) receives the number of nodes processed by each step, while_cond is checked after a bin.
+ **/
+template<class Priority, class Graph_, class WhileCond, class PriorityFunc, class FrontierSizeFunc>
+  void OrderedProcessingOperatorConstSum(EagerPriorityQueue<Priority>* pq, const Graph_ &g, WhileCond while_cond, PriorityFunc priority_func, FrontierSizeFunc frontier_size_func, int bin_size_threshold = 1000){
+
+  int64_t num_nodes = g.num_nodes();
+  vector<uint8_t> processed(num_nodes, 0);
+  // number of processed neighbors of every node in the current step, zero outside of the histogram
+  vector<NodeID> neighbor_counts(num_nodes, 0);
+  vector<vector<NodeID> > frontier;
+  size_t step_sizes[2] = {0, 0};
+  bool running = true;
+
+  pq->init_indexes_tails();
+
+  #pragma omp parallel
+  {
+    int thread_id = 0;
+#if defined(OPENMP)
+    thread_id = omp_get_thread_num();
+#endif
+    #pragma omp single
+    {
+      int num_threads = 1;
+#if defined(OPENMP)
+      num_threads = omp_get_num_threads();
+#endif
+      frontier.resize(num_threads);
+      pq->shared_indexes[0] = kMaxBin;
+      pq->frontier_tails[0] = 0;
+      running = while_cond();
+    }
+    ThreadLocalBins local_bins(pq->num_open_buckets_);
+    SeedFrontierFromPriorities(pq, local_bins, frontier[thread_id], num_nodes);
+    vector<size_t> chunk_offsets;
+    vector<NodeID> affected;
+    vector<NodeID> next_chunk;
+    size_t iter = 0;
+    size_t step = 0;
+    while (running && pq->shared_indexes[iter&1] != kMaxBin) {
+      size_t &curr_bin_index = pq->shared_indexes[iter&1];
+      size_t &next_bin_index = pq->shared_indexes[(iter+1)&1];
+      size_t &curr_frontier_tail = pq->frontier_tails[iter&1];
+      size_t &next_frontier_tail = pq->frontier_tails[(iter+1)&1];
+
+      FilterConstSumFrontier(pq, processed, frontier[thread_id], curr_bin_index);
+
+      // steps over the current bin until no node drops into it
+      while (true) {
+        size_t &step_size = step_sizes[step&1];
+        fetch_and_add(step_size, frontier[thread_id].size());
+        #pragma omp barrier
+        #pragma omp single
+        {
+          step_sizes[(step+1)&1] = 0;
+          if (step_size > 0) frontier_size_func(step_size);
+        }
+        if (step_size == 0) break;
+
+        if (step_size <= (size_t) bin_size_threshold) {
+          // the bin is small, one thread finishes it without the histogram and the barriers
+          #pragma omp single
+          {
+            vector<NodeID> stack;
+            for (vector<NodeID>& chunk : frontier) {
+              stack.insert(stack.end(), chunk.begin(), chunk.end());
+              chunk.resize(0);
+            }
+            size_t fused_size = 0;
+            while (!stack.empty()) {
+              NodeID u = stack.back();
+              stack.pop_back();
+              for (NodeID v : g.out_neigh(u)) {
+                if (!processed[v] && ApplyConstSumPriority(pq, local_bins, processed, v,
+                                                           (Priority) priority_func(v, (Priority) 1), curr_bin_index)) {
+                  stack.push_back(v);
+                  fused_size++;
+                }
+              }
+            }
+            if (fused_size > 0) frontier_size_func(fused_size);
+          }
+          step++;
+          break;
+        }
+
+        // histogram of the processed neighbors, the first thread to count a node applies its update
+        ComputeFrontierChunkOffsets(frontier, chunk_offsets);
+        #pragma omp for schedule(dynamic, 64)
+        for (size_t i = 0; i < step_size; i++) {
+          NodeID u = FrontierNode(frontier, chunk_offsets, i);
+          for (NodeID v : g.out_neigh(u)) {
+            if (!processed[v] && fetch_and_add(neighbor_counts[v], 1) == 0)
+              affected.push_back(v);
+          }
+        }
+        for (NodeID v : affected) {
+          Priority count = neighbor_counts[v];
+          neighbor_counts[v] = 0;
+          if (ApplyConstSumPriority(pq, local_bins, processed, v, (Priority) priority_func(v, count), curr_bin_index))
+            next_chunk.push_back(v);
+        }
+        affected.resize(0);
+        frontier[thread_id].swap(next_chunk);
+        next_chunk.resize(0);
+        step++;
+      }
+
+      //searching for the next priority
+      size_t local_next_bin = local_bins.next_bin();
+      if (local_next_bin != kMaxBin) {
+        #pragma omp critical
+        next_bin_index = min(next_bin_index, local_next_bin);
+      }
+      #pragma omp barrier
+      #pragma omp single nowait
+      {
+        curr_bin_index = kMaxBin;
+        curr_frontier_tail = 0;
+        running = while_cond();
+        pq->increment_iter();
+      }
+      MoveNextBinToFrontier(pq, local_bins, frontier[thread_id], next_bin_index, next_frontier_tail);
+      iter++;
+
+      #pragma omp barrier
+    }
+  }//end of pragma omp parallel
+}
+
+// operators with the default source filter
+
+template< class Priority, class Graph_, class EdgeApplyFunc , class WhileCond>
+  void OrderedProcessingOperatorNoMerge(EagerPriorityQueue<Priority>* pq, const Graph_ &g, WhileCond while_cond, EdgeApplyFunc edge_apply, NodeID optional_source_node){
+  OrderedProcessingOperatorNoMerge(pq, g, while_cond, edge_apply, PriorityAtLeastCurrentBin<Priority>{pq},
+                                   optional_source_node);
+}
+
+template<class Priority, class Graph_, class WhileCond, class EdgeApplyFunc >
+  void OrderedProcessingOperatorWithMerge(EagerPriorityQueue<Priority>* pq, const Graph_ &g,  WhileCond while_cond, EdgeApplyFunc edge_apply, int bin_size_threshold = 1000, NodeID optional_source_node=-1){
+  OrderedProcessingOperatorWithMerge(pq, g, while_cond, edge_apply, PriorityAtLeastCurrentBin<Priority>{pq},
+                                     bin_size_threshold, optional_source_node);
+}
+
+template<class Priority, class Graph_, class WhileCond, class EdgeApplyFunc >
+  void OrderedProcessingOperatorRelaxedMultiQueue(EagerPriorityQueue<Priority>* pq, const Graph_ &g,  WhileCond while_cond, EdgeApplyFunc edge_apply, int relaxation_factor = 2, NodeID optional_source_node=-1){
+  OrderedProcessingOperatorRelaxedMultiQueue(pq, g, while_cond, edge_apply, PriorityAtLeastCurrentBin<Priority>{pq},
+                                             relaxation_factor, optional_source_node);
+}
+
 #endif  // ORDERED_PROCESSING_H
@@ -0,0 +1,155 @@
+#ifndef RANDOM_WALK_H_
+#define RANDOM_WALK_H_
+
+#include <algorithm>
+#include <cinttypes>
+#include <vector>
+
+#include "benchmark.h"
+#include "counter_rng.h"
+
+
+/**
+ * Alias tables for sampling an out edge of a vertex with probability proportional to its weight in O(1).
+ * The entries of a vertex are stored at the positions of its out edges: entry i keeps edge i with probability
+ * prob[i] and takes edge alias[i] otherwise.
+ **/
+class AliasTable {
+
+public:
+  AliasTable() {}
+
+  explicit AliasTable(const WGraph &g) : offsets_(g.num_nodes() + 1) {
+    offsets_[0] = 0;
+    for (NodeID v = 0; v < g.num_nodes(); v++)
+      offsets_[v + 1] = offsets_[v] + g.out_degree(v);
+    prob_.resize(offsets_[g.num_nodes()]);
+    alias_.resize(offsets_[g.num_nodes()]);
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for (NodeID v = 0; v < g.num_nodes(); v++)
+      build_vertex(g, v);
+  }
+
+  bool empty() const {
+    return offsets_.empty();
+  }
+
+  // index of the sampled out edge of v, degree is the out degree of v
+  int64_t sample(NodeID v, int64_t degree, uint64_t r) const {
+    int64_t i = CounterRNG::Bounded(r, degree);
+    int64_t entry = offsets_[v] + i;
+    return CounterRNG::Unit(r) < prob_[entry] ? i : alias_[entry];
+  }
+
+private:
+  // Vose's method, the weights are scaled so that they average 1
+  void build_vertex(const WGraph &g, NodeID v){
+    int64_t degree = g.out_degree(v);
+    if (degree == 0) return;
+    int64_t start = offsets_[v];
+    double total = 0;
+    for (WNode wn : g.out_neigh(v))
+      total += wn.w;
+    std::vector<double> scaled(degree);
+    std::vector<int64_t> small, large;
+    int64_t i = 0;
+    for (WNode wn : g.out_neigh(v)) {
+      // all weights 0 falls back to uniform sampling
+      scaled[i] = total > 0 ? wn.w * degree / total : 1;
+      (scaled[i] < 1 ? small : large).push_back(i);
+      i++;
+    }
+    while (!small.empty() && !large.empty()) {
+      int64_t s = small.back(), l = large.back();
+      small.pop_back();
+      prob_[start + s] = scaled[s];
+      alias_[start + s] = l;
+      scaled[l] -= 1 - scaled[s];
+      if (scaled[l] < 1) {
+        large.pop_back();
+        small.push_back(l);
+      }
+    }
+    // the rest are 1 up to rounding
+    for (int64_t l : large) {
+      prob_[start + l] = 1;
+      alias_[start + l] = l;
+    }
+    for (int64_t s : small) {
+      prob_[start + s] = 1;
+      alias_[start + s] = s;
+    }
+  }
+
+  std::vector<int64_t> offsets_;
+  std::vector<float> prob_;
+  std::vector<int32_t> alias_;
+};
+
+// next vertex of a walk at v, uniform over the out edges
+static NodeID RandomWalkStep(const Graph &g, const AliasTable &, NodeID v, uint64_t r){
+  return g.out_neigh(v).begin()[CounterRNG::Bounded(r, g.out_degree(v))];
+}
+
+// next vertex of a walk at v, proportional to the edge weights
+static NodeID RandomWalkStep(const WGraph &g, const AliasTable &alias, NodeID v, uint64_t r){
+  return g.out_neigh(v).begin()[alias.sample(v, g.out_degree(v), r)].v;
+}
+
+static AliasTable RandomWalkTransitions(const Graph &){
+  return AliasTable();
+}
+
+static AliasTable RandomWalkTransitions(const WGraph &g){
+  return AliasTable(g);
+}
+
+/**
+ * Runs batches of first order random walks (DeepWalk style corpus generation).
+ * The random number of step s of walker w is CounterRNG(seed)(w, s), so the walks only depend on the seed and the
+ * walker ids, not on the number of threads. The walkers of a batch advance together one step at a time, a step
+ * only reads the current vertices and the neighborhoods they point to.
+ * Transitions are uniform on Graph and proportional to the edge weights (through alias tables) on WGraph.
+ **/
+template <class Graph_>
+class RandomWalkEngine {
+
+public:
+  static const int64_t kBatchSize = 1 << 16;
+
+  RandomWalkEngine(const Graph_ &g, uint64_t seed) : g_(g), rng_(seed), transitions_(RandomWalkTransitions(g)) {}
+
+  /**
+   * walks[w * (length + 1) + s] is the vertex of walker first_walker + w after s steps, starting at starts[w].
+   * A walk that reaches a vertex without out edges stops there, the rest of its row is -1.
+   **/
+  void walk(const NodeID* starts, int64_t num_walkers, int length, NodeID* walks, uint64_t first_walker = 0) const {
+    int64_t row = length + 1;
+    for (int64_t batch_start = 0; batch_start < num_walkers; batch_start += kBatchSize) {
+      int64_t batch_end = std::min(num_walkers, batch_start + kBatchSize);
+      std::vector<NodeID> current(starts + batch_start, starts + batch_end);
+      #pragma omp parallel for
+      for (int64_t w = batch_start; w < batch_end; w++)
+        walks[w * row] = starts[w];
+      for (int step = 1; step <= length; step++) {
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (int64_t w = batch_start; w < batch_end; w++) {
+          NodeID v = current[w - batch_start];
+          if (v >= 0 && g_.out_degree(v) > 0)
+            v = RandomWalkStep(g_, transitions_, v, rng_(first_walker + w, step));
+          else
+            v = -1;
+          current[w - batch_start] = v;
+          walks[w * row + step] = v;
+        }
+      }
+    }
+  }
+
+private:
+  const Graph_ &g_;
+  CounterRNG rng_;
+  AliasTable transitions_;
+};
+
+#endif  // RANDOM_WALK_H_
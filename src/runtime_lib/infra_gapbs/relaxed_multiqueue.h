@@ -0,0 +1,116 @@
+#ifndef RELAXED_MULTIQUEUE_H_
+#define RELAXED_MULTIQUEUE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+/**
+ * Relaxed concurrent priority queue (MultiQueue) of (bin, node) pairs.
+ * The queue is made of relaxation_factor * num_threads sequential binary heaps, each guarded by a try-lock.
+ * A push goes to a random heap, a pop takes the smaller top of two randomly chosen heaps.
+ * Pops are only approximately ordered by bin, so the nodes are processed asynchronously instead of in rounds.
+ * Each thread passes its own random state (see init_seed) to push and try_pop.
+ **/
+template <class NodeID_>
+class RelaxedMultiQueue {
+
+public:
+  typedef std::pair<size_t, NodeID_> Item;
+
+  RelaxedMultiQueue(int num_threads, int relaxation_factor)
+  		: num_queues_(std::max(2, num_threads * std::max(1, relaxation_factor))){
+    queues_ = new Queue[num_queues_];
+  }
+
+  ~RelaxedMultiQueue(){
+    delete[] queues_;
+  }
+
+  static uint64_t init_seed(int thread_id){
+    return 0x9E3779B97F4A7C15ULL * (thread_id + 1);
+  }
+
+  void push(const Item& item, uint64_t& seed){
+    while (true) {
+      Queue& q = queues_[random_queue(seed)];
+      if (!q.try_lock()) continue;
+      q.heap.push_back(item);
+      std::push_heap(q.heap.begin(), q.heap.end(), std::greater<Item>());
+      q.top.store(q.heap.front().first, std::memory_order_relaxed);
+      q.unlock();
+      return;
+    }
+  }
+
+  // returns false if no item was found, other threads might still be pushing
+  bool try_pop(Item& item, uint64_t& seed){
+    for (int attempt = 0; attempt < num_queues_; attempt++) {
+      size_t i = random_queue(seed);
+      size_t j = random_queue(seed);
+      if (queues_[j].top.load(std::memory_order_relaxed) < queues_[i].top.load(std::memory_order_relaxed))
+        i = j;
+      if (queues_[i].top.load(std::memory_order_relaxed) == kEmpty) continue;
+      if (pop_from(queues_[i], item)) return true;
+    }
+    // the sampled heaps were all empty or contended, look at every heap once before giving up
+    for (int i = 0; i < num_queues_; i++) {
+      if (queues_[i].top.load(std::memory_order_relaxed) == kEmpty) continue;
+      if (pop_from(queues_[i], item)) return true;
+    }
+    return false;
+  }
+
+private:
+  static const size_t kEmpty = std::numeric_limits<size_t>::max();
+
+  struct Queue {
+    std::vector<Item> heap;
+    std::atomic<bool> locked;
+    // bin of the top of the heap, read without holding the lock
+    std::atomic<size_t> top;
+    // keep the heaps on separate cache lines
+    char padding[64];
+
+    Queue() : locked(false), top(kEmpty) {}
+
+    bool try_lock(){
+      return !locked.load(std::memory_order_relaxed) && !locked.exchange(true, std::memory_order_acquire);
+    }
+
+    void unlock(){
+      locked.store(false, std::memory_order_release);
+    }
+  };
+
+  bool pop_from(Queue& q, Item& item){
+    if (!q.try_lock()) return false;
+    if (q.heap.empty()) {
+      q.unlock();
+      return false;
+    }
+    std::pop_heap(q.heap.begin(), q.heap.end(), std::greater<Item>());
+    item = q.heap.back();
+    q.heap.pop_back();
+    q.top.store(q.heap.empty() ? kEmpty : q.heap.front().first, std::memory_order_relaxed);
+    q.unlock();
+    return true;
+  }
+
+  // xorshift64
+  size_t random_queue(uint64_t& seed){
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    return seed % num_queues_;
+  }
+
+  int num_queues_;
+  Queue* queues_;
+};
+
+#endif  // RELAXED_MULTIQUEUE_H_
@@ -0,0 +1,110 @@
+#ifndef SHORTEST_PATH_QUERIES_H_
+#define SHORTEST_PATH_QUERIES_H_
+
+#include <cinttypes>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark.h"
+#include "delta_selection.h"
+#include "eager_priority_queue.h"
+#include "ordered_processing.h"
+#include "touched_vertices.h"
+
+
+/**
+ * Answers many shortest path queries against one loaded graph.
+ * The distance array and the priority queue are allocated once. A query runs the eager delta-stepping operator
+ * (stopping at the destination for point to point queries) and records the vertices it gave a distance, the next
+ * query only resets those, so the cost of a query is the cost of its traversal.
+ **/
+template <class WGraph_>
+class ShortestPathQueryEngine {
+
+public:
+  // delta <= 0 selects delta from the graph
+  explicit ShortestPathQueryEngine(const WGraph_ &g, WeightT delta = 0)
+      : g_(g), dist_(new WeightT[g.num_nodes()]), touched_(g.num_nodes()),
+        pq_(dist_, delta > 0 ? delta : SelectInitialDelta(g)) {
+    #pragma omp parallel for
+    for (int64_t v = 0; v < g.num_nodes(); v++)
+      dist_[v] = kDistInf();
+  }
+
+  ~ShortestPathQueryEngine(){
+    delete[] dist_;
+  }
+
+  static WeightT kDistInf(){
+    return std::numeric_limits<WeightT>::max()/2;
+  }
+
+  // distance from src to dst, numeric_limits<WeightT>::max() if dst is not reachable
+  WeightT query(NodeID src, NodeID dst){
+    run(src, dst);
+    return dist_[dst] == kDistInf() ? std::numeric_limits<WeightT>::max() : dist_[dst];
+  }
+
+  // distances from src to every vertex (kDistInf() if unreachable), valid until the next query
+  const WeightT* query(NodeID src){
+    run(src, -1);
+    return dist_;
+  }
+
+  void query_batch(const std::vector<std::pair<NodeID, NodeID> > &queries, std::vector<WeightT> &answers){
+    answers.resize(queries.size());
+    for (size_t i = 0; i < queries.size(); i++)
+      answers[i] = query(queries[i].first, queries[i].second);
+  }
+
+  /**
+   * Reads "source destination" lines and writes one distance per line, until the end of the input.
+   * Lines that are not two vertex ids get "error" so that the answers stay aligned with the queries.
+   * Every answer is flushed, so the input can be an interactive pipe or a socket bound to stdin.
+   **/
+  void serve(std::istream &in, std::ostream &out){
+    std::string line;
+    while (std::getline(in, line)) {
+      std::istringstream fields(line);
+      int64_t src, dst;
+      if (!(fields >> src >> dst) || src < 0 || dst < 0 || src >= g_.num_nodes() || dst >= g_.num_nodes()) {
+        out << "error" << std::endl;
+        continue;
+      }
+      out << query(src, dst) << std::endl;
+    }
+  }
+
+private:
+  void run(NodeID src, NodeID dst){
+    touched_.reset(dist_, kDistInf());
+    touched_.clear();
+    dist_[src] = 0;
+    touched_.touch(src);
+    if (src == dst) return;
+    WeightT* dist = dist_;
+    EagerPriorityQueue<WeightT>* pq = &pq_;
+    TouchedVertices* touched = &touched_;
+    auto edge_update = [&](ThreadLocalBins& local_bins, NodeID u, NodeID v, WeightT w) {
+      WeightT old_dist = dist[v];
+      updatePriorityMin<WeightT>()(pq, local_bins, v, old_dist, dist[u] + w);
+      if (old_dist == kDistInf()) touched->touch(v);
+    };
+    if (dst >= 0) {
+      OrderedProcessingOperatorNoMerge(pq, g_, [&]()->bool{ return !pq->finishedNode(dst); }, edge_update, src);
+    } else {
+      OrderedProcessingOperatorNoMerge(pq, g_, [&]()->bool{ return !pq->finished(); }, edge_update, src);
+    }
+  }
+
+  const WGraph_ &g_;
+  WeightT* dist_;
+  TouchedVertices touched_;
+  EagerPriorityQueue<WeightT> pq_;
+};
+
+#endif  // SHORTEST_PATH_QUERIES_H_
@@ -0,0 +1,185 @@
+#ifndef SWEEP_CUT_H_
+#define SWEEP_CUT_H_
+
+#include <algorithm>
+#include <cfloat>
+#include <cinttypes>
+#include <limits>
+#include <vector>
+
+#include "benchmark.h"
+
+#if defined(CILK)
+#include <cilk/cilk_api.h>
+#endif
+
+
+/**
+ * Parallel sweep cut for local clustering.
+ * The vertices are sorted by decreasing value with a sample sort, every position gets the change of the volume and
+ * of the crossing edges caused by adding its vertex (from the positions of its neighbors), two scans turn those into
+ * the volume and the cut of every prefix, and the prefix with the lowest conductance is found with a blocked argmin.
+ * Computes the same prefix as the serial sweep in serialSweepCut, vertices with equal values are ordered by id.
+ **/
+
+static int SweepCutNumThreads(){
+  int num_threads = 1;
+#if defined(CILK)
+  num_threads = __cilkrts_get_nworkers();
+#elif defined(OPENMP)
+  num_threads = omp_get_max_threads();
+#endif
+  return num_threads;
+}
+
+// inclusive prefix sum in place
+static void SweepCutInclusiveSum(std::vector<int64_t> &values){
+  const int64_t kBlockSize = 1 << 16;
+  int64_t n = values.size();
+  int64_t num_blocks = (n + kBlockSize - 1) / kBlockSize;
+  std::vector<int64_t> block_offsets(num_blocks + 1, 0);
+  #pragma omp parallel for
+  for (int64_t b = 0; b < num_blocks; b++) {
+    int64_t sum = 0;
+    for (int64_t i = b * kBlockSize; i < std::min(n, (b + 1) * kBlockSize); i++)
+      sum += values[i];
+    block_offsets[b + 1] = sum;
+  }
+  for (int64_t b = 0; b < num_blocks; b++)
+    block_offsets[b + 1] += block_offsets[b];
+  #pragma omp parallel for
+  for (int64_t b = 0; b < num_blocks; b++) {
+    int64_t sum = block_offsets[b];
+    for (int64_t i = b * kBlockSize; i < std::min(n, (b + 1) * kBlockSize); i++) {
+      sum += values[i];
+      values[i] = sum;
+    }
+  }
+}
+
+// sample sort, the elements are split into buckets by sorted splitters and the buckets are sorted in parallel
+template <typename T, typename Compare>
+static void SweepCutSort(T* A, int64_t n, Compare less){
+  const int64_t kSerialCutoff = 1 << 14;
+  const int64_t kOversample = 32;
+  int num_threads = SweepCutNumThreads();
+  if (n <= kSerialCutoff || num_threads == 1) {
+    std::sort(A, A + n, less);
+    return;
+  }
+  int64_t num_buckets = std::min<int64_t>(8 * num_threads, n / kSerialCutoff + 1);
+  int64_t num_blocks = num_buckets;
+  int64_t block_size = (n + num_blocks - 1) / num_blocks;
+
+  // evenly spaced samples, the input is usually unordered with respect to the values
+  std::vector<T> sample(num_buckets * kOversample);
+  int64_t stride = n / sample.size();
+  for (size_t s = 0; s < sample.size(); s++)
+    sample[s] = A[s * stride];
+  std::sort(sample.begin(), sample.end(), less);
+  std::vector<T> splitters(num_buckets - 1);
+  for (int64_t b = 0; b < num_buckets - 1; b++)
+    splitters[b] = sample[(b + 1) * kOversample];
+
+  // bucket of every element and the per (bucket, block) counts
+  std::vector<int32_t> bucket_of(n);
+  std::vector<int64_t> counts(num_buckets * num_blocks, 0);
+  #pragma omp parallel for schedule(dynamic, 1)
+  for (int64_t block = 0; block < num_blocks; block++) {
+    for (int64_t i = block * block_size; i < std::min(n, (block + 1) * block_size); i++) {
+      int32_t b = std::upper_bound(splitters.begin(), splitters.end(), A[i], less) - splitters.begin();
+      bucket_of[i] = b;
+      counts[b * num_blocks + block]++;
+    }
+  }
+  // bucket major offsets, the blocks of a bucket are next to each other
+  int64_t total = 0;
+  for (int64_t c = 0; c < num_buckets * num_blocks; c++) {
+    int64_t count = counts[c];
+    counts[c] = total;
+    total += count;
+  }
+  std::vector<T> out(n);
+  #pragma omp parallel for schedule(dynamic, 1)
+  for (int64_t block = 0; block < num_blocks; block++) {
+    for (int64_t i = block * block_size; i < std::min(n, (block + 1) * block_size); i++)
+      out[counts[bucket_of[i] * num_blocks + block]++] = A[i];
+  }
+  // counts[b * num_blocks + num_blocks - 1] is now the end of bucket b
+  #pragma omp parallel for schedule(dynamic, 1)
+  for (int64_t b = 0; b < num_buckets; b++) {
+    int64_t start = b == 0 ? 0 : counts[(b - 1) * num_blocks + num_blocks - 1];
+    int64_t end = counts[b * num_blocks + num_blocks - 1];
+    std::sort(out.begin() + start, out.begin() + end, less);
+    std::copy(out.begin() + start, out.begin() + end, A + start);
+  }
+}
+
+/**
+ * Sorts order[0, n) by decreasing val_array and returns the position of the lowest conductance prefix
+ * (-1 if n is 0), ties go to the shortest prefix.
+ * The conductance of a prefix S is cut(S) / min(vol(S), m - vol(S)), 1 if either is 0, with out degrees.
+ **/
+template <class Graph_, typename T>
+static int64_t SweepCutBestPrefix(const Graph_ &g, T* order, int64_t n, const double* val_array){
+  if (n == 0) return -1;
+  SweepCutSort(order, n, [val_array](const T &a, const T &b) -> bool {
+    return val_array[a] > val_array[b] || (val_array[a] == val_array[b] && a < b);
+  });
+
+  const int64_t kNotInSet = std::numeric_limits<int64_t>::max();
+  std::vector<int64_t> position(g.num_nodes());
+  #pragma omp parallel for
+  for (int64_t v = 0; v < g.num_nodes(); v++)
+    position[v] = kNotInSet;
+  #pragma omp parallel for
+  for (int64_t i = 0; i < n; i++)
+    position[order[i]] = i;
+
+  // adding the vertex at position i removes the edges to the neighbors placed before it from the cut,
+  // and adds the edges to the neighbors placed after it (or outside of the set)
+  std::vector<int64_t> volume(n), crossing(n);
+  #pragma omp parallel for schedule(dynamic, 64)
+  for (int64_t i = 0; i < n; i++) {
+    NodeID v = order[i];
+    int64_t delta = 0;
+    for (NodeID ngh : g.out_neigh(v))
+      delta += position[ngh] <= i ? -1 : 1;
+    volume[i] = g.out_degree(v);
+    crossing[i] = delta;
+  }
+  SweepCutInclusiveSum(volume);
+  SweepCutInclusiveSum(crossing);
+
+  const int64_t kBlockSize = 1 << 12;
+  int64_t num_blocks = (n + kBlockSize - 1) / kBlockSize;
+  std::vector<double> block_best(num_blocks);
+  std::vector<int64_t> block_best_position(num_blocks);
+  int64_t m = g.num_edges();
+  #pragma omp parallel for
+  for (int64_t b = 0; b < num_blocks; b++) {
+    double best = DBL_MAX;
+    int64_t best_position = -1;
+    for (int64_t i = b * kBlockSize; i < std::min(n, (b + 1) * kBlockSize); i++) {
+      int64_t denom = std::min(volume[i], m - volume[i]);
+      double conductance = (crossing[i] == 0 || denom == 0) ? 1 : (double) crossing[i] / denom;
+      if (conductance < best) {
+        best = conductance;
+        best_position = i;
+      }
+    }
+    block_best[b] = best;
+    block_best_position[b] = best_position;
+  }
+  double best = DBL_MAX;
+  int64_t best_position = -1;
+  for (int64_t b = 0; b < num_blocks; b++) {
+    if (block_best[b] < best) {
+      best = block_best[b];
+      best_position = block_best_position[b];
+    }
+  }
+  return best_position;
+}
+
+#endif  // SWEEP_CUT_H_
@@ -0,0 +1,101 @@
+#ifndef THREAD_LOCAL_BINS_H_
+#define THREAD_LOCAL_BINS_H_
+
+#include <algorithm>
+#include <cinttypes>
+#include <limits>
+#include <vector>
+
+
+/**
+ * Thread local buckets of the eager ordered processing operators.
+ * Only the open bins [base, base + num_open_bins) are materialized, in a circular window of vectors indexed by
+ * bin % num_open_bins. Nodes of later bins wait in a single overflow vector, and are moved into the window
+ * (with bins recomputed from their current priority) once the window reaches them.
+ * Memory is bounded by the number of inserted nodes and the number of open bins, not by the largest bin.
+ **/
+class ThreadLocalBins {
+
+public:
+  static const size_t kNoBin = std::numeric_limits<size_t>::max()/2;
+
+  explicit ThreadLocalBins(size_t num_open_bins = 128)
+      : window_(std::max<size_t>(1, num_open_bins)), base_(0), overflow_min_bin_(kNoBin) {}
+
+  // bins only move forward, a node for a bin that was already passed goes into the current bin
+  void push(size_t bin, NodeID v){
+    if (bin < base_) bin = base_;
+    if (bin < base_ + window_.size()) {
+      window_[bin % window_.size()].push_back(v);
+    } else {
+      overflow_.push_back(v);
+      overflow_min_bin_ = std::min(overflow_min_bin_, bin);
+    }
+  }
+
+  // the bin has to be in the window
+  std::vector<NodeID>& bin(size_t b){
+    return window_[b % window_.size()];
+  }
+
+  // smallest non empty bin, can be lower than the actual one when it comes from the overflow nodes
+  size_t next_bin() const {
+    for (size_t b = base_; b < base_ + window_.size(); b++) {
+      if (!window_[b % window_.size()].empty())
+        return b;
+    }
+    return overflow_.empty() ? kNoBin : overflow_min_bin_;
+  }
+
+  // moves the window to start at new_base, all the bins before new_base have to be empty
+  template <class PriorityQueue_>
+  void advance(size_t new_base, PriorityQueue_* pq){
+    base_ = std::max(base_, new_base);
+    if (overflow_.empty() || overflow_min_bin_ >= base_ + window_.size())
+      return;
+    std::vector<NodeID> overflow;
+    overflow.swap(overflow_);
+    overflow_min_bin_ = kNoBin;
+    for (NodeID v : overflow) {
+      size_t b = pq->priorities_[v]/pq->delta_;
+      // the node was improved into a bin that has been processed already
+      if (b < base_) continue;
+      push(b, v);
+    }
+  }
+
+  // recomputes the bins of all the nodes after pq->delta_ changed from old_delta and returns the next bin.
+  // from_bin is the next bin under old_delta, there are no nodes in earlier bins.
+  template <class PriorityQueue_, class PriorityT_>
+  size_t rebin(PriorityQueue_* pq, PriorityT_ old_delta, size_t from_bin){
+    std::vector<NodeID> nodes;
+    for (size_t b = base_; b < base_ + window_.size(); b++) {
+      std::vector<NodeID>& nodes_in_bin = window_[b % window_.size()];
+      for (NodeID v : nodes_in_bin) {
+        // a node whose priority dropped below its bin was also inserted into a lower bin
+        if ((size_t) (pq->priorities_[v]/old_delta) >= b)
+          nodes.push_back(v);
+      }
+      nodes_in_bin.resize(0);
+    }
+    for (NodeID v : overflow_) {
+      if ((size_t) (pq->priorities_[v]/old_delta) >= from_bin)
+        nodes.push_back(v);
+    }
+    overflow_.resize(0);
+    overflow_min_bin_ = kNoBin;
+    base_ = (from_bin * old_delta) / pq->delta_;
+    for (NodeID v : nodes) {
+      push(pq->priorities_[v]/pq->delta_, v);
+    }
+    return next_bin();
+  }
+
+private:
+  std::vector<std::vector<NodeID> > window_;
+  size_t base_;
+  std::vector<NodeID> overflow_;
+  size_t overflow_min_bin_;
+};
+
+#endif  // THREAD_LOCAL_BINS_H_
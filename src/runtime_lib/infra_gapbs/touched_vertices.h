@@ -0,0 +1,118 @@
+#ifndef TOUCHED_VERTICES_H_
+#define TOUCHED_VERTICES_H_
+
+#include <algorithm>
+#include <cinttypes>
+#include <vector>
+
+#include "platform_atomics.h"
+
+#if defined(CILK)
+#include <cilk/cilk_api.h>
+#endif
+
+
+/**
+ * Records the vertices a traversal modified, so that per-query vertex properties can be restored by only writing
+ * those vertices instead of the whole array.
+ * touch(v) can be called concurrently, a vertex is recorded once (into the list of the calling thread) until
+ * clear(). Past dense_fraction of the vertices a reset writes the whole array, which is cheaper than scattered
+ * writes at that point. A set created with all_touched counts every vertex as touched until the first clear, for
+ * values that are not known to hold their reset value yet.
+ **/
+class TouchedVertices {
+
+public:
+  explicit TouchedVertices(int64_t num_nodes, double dense_fraction = 0.05, bool all_touched = false)
+      : num_nodes_(num_nodes), dense_fraction_(dense_fraction), flags_(num_nodes, all_touched ? 1 : 0),
+        all_touched_(all_touched) {
+    int num_threads = 1;
+#if defined(CILK)
+    num_threads = __cilkrts_get_nworkers();
+#elif defined(OPENMP)
+    num_threads = omp_get_max_threads();
+#endif
+    thread_touched_.resize(num_threads);
+  }
+
+  // returns true if v was not touched since the last clear
+  bool touch(NodeID v){
+    if (flags_[v] != 0 || !compare_and_swap(flags_[v], (uint8_t) 0, (uint8_t) 1))
+      return false;
+    int thread_id = 0;
+#if defined(CILK)
+    thread_id = __cilkrts_get_worker_number();
+#elif defined(OPENMP)
+    thread_id = omp_get_thread_num();
+#endif
+    thread_touched_[thread_id].list.push_back(v);
+    return true;
+  }
+
+  bool touched(NodeID v) const {
+    return flags_[v] != 0;
+  }
+
+  size_t size() const {
+    size_t count = 0;
+    for (const ThreadList& t : thread_touched_)
+      count += t.list.size();
+    return count;
+  }
+
+  bool dense() const {
+    return all_touched_ || size() > dense_fraction_ * num_nodes_;
+  }
+
+  // calls f(v) for the touched vertices (or all of them once the touched set is dense)
+  template <typename F>
+  void for_each(F f) const {
+    if (dense()) {
+      #pragma omp parallel for
+      for (int64_t v = 0; v < num_nodes_; v++)
+        f(v);
+      return;
+    }
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (size_t t = 0; t < thread_touched_.size(); t++) {
+      for (NodeID v : thread_touched_[t].list)
+        f(v);
+    }
+  }
+
+  // sets values[v] = value for the touched vertices (or all of them once the touched set is dense)
+  template <typename T>
+  void reset(T* values, T value) const {
+    for_each([&](NodeID v) { values[v] = value; });
+  }
+
+  // forgets the touched vertices, the flags are cleared the same way as the arrays in reset
+  void clear(){
+    if (dense()) {
+      std::fill(flags_.begin(), flags_.end(), 0);
+    } else {
+      for (ThreadList& t : thread_touched_) {
+        for (NodeID v : t.list)
+          flags_[v] = 0;
+      }
+    }
+    for (ThreadList& t : thread_touched_)
+      t.list.resize(0);
+    all_touched_ = false;
+  }
+
+private:
+  struct ThreadList {
+    std::vector<NodeID> list;
+    // keep the lists of different threads on separate cache lines
+    char padding[64];
+  };
+
+  int64_t num_nodes_;
+  double dense_fraction_;
+  std::vector<uint8_t> flags_;
+  bool all_touched_;
+  std::vector<ThreadList> thread_touched_;
+};
+
+#endif  // TOUCHED_VERTICES_H_
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <cmath>
 #include <limits>
 #include <tuple>
+#include <vector>
 
 #include "dyn_arr.h"
 #include "maybe.h"
@@ -42,6 +44,8 @@ struct buckets {
 
     const uintE null_bkt = std::numeric_limits<D>::max();
     int delta_ = 1;
+    // > 0 selects (1+eps_) geometric buckets over the priorities, see priority_to_bucket
+    double eps_ = 0;
 
     // Create a bucketing structure.
     //   n : the number of identifiers
@@ -49,31 +53,38 @@ struct buckets {
     //   bkt_order : the order to iterate over the buckets
     //   pri_order : the order in which priorities are updated
     //   total_buckets: the total buckets to materialize
+    //   eps: 0 for exact buckets of width delta, > 0 for approximate (1+eps) geometric buckets
     //
     //   For an identifier i:
-    //   d[i] is the bucket currently containing i
+    //   d[i] is the priority of i, it is in bucket priority_to_bucket(d[i])
     //   d[i] = UINT_E_MAX if i is not in any bucket
+    //
+    //   In the approximate mode the buckets returned by next_bucket carry the smallest priority of the bucket as
+    //   their id, and get_bucket_* take the priority an identifier moves to. An identifier whose priority moves
+    //   further along the bucket order while it waits in a bucket does not need to be moved, it is re-bucketed
+    //   when its old bucket is extracted (lazy re-evaluation).
     buckets(size_t _n,
             D* _d,
             bucket_order _bkt_order,
             priority_order _pri_order,
-            size_t _total_buckets, int delta=1) :
+            size_t _total_buckets, int delta=1, double eps=0) :
         n(_n), d(_d), bkt_order(_bkt_order), pri_order(_pri_order),
         open_buckets(_total_buckets-1), total_buckets(_total_buckets),
-        cur_bkt(0), max_bkt(_total_buckets), num_elms(0), delta_(delta) {
+        cur_bkt(0), max_bkt(_total_buckets), num_elms(0), delta_(delta), eps_(eps),
+        log_base_(eps > 0 ? log1p(eps) : 0) {
       // Initialize array consisting of the materialized buckets.
       bkts = pbbso::new_array<id_dyn_arr>(total_buckets);
 
       // Set the current range being processed based on the order.
       if (bkt_order == increasing) {
 //        auto imap = make_in_imap<uintE>(n, [&] (size_t i) { return d[i]; });
-        auto imap = make_in_imap<uintE>(n, [&] (size_t i) { return (d[i] == null_bkt) ? null_bkt : d[i]/delta_; });
+        auto imap = make_in_imap<uintE>(n, [&] (size_t i) { return priority_to_bucket(d[i]); });
         auto min = [] (uintE x, uintE y) { return std::min(x, y); };
         size_t min_b = pbbso::reduce(imap, min);
         cur_range = min_b / open_buckets;
       } else if (bkt_order == decreasing) {
         auto imap = make_in_imap<uintE>(n, [&] (size_t i) {
-            return (d[i] == null_bkt) ? 0 : d[i]/delta; });
+            return (d[i] == (D) null_bkt) ? 0 : priority_to_bucket(d[i]); });
         auto max = [] (uintE x, uintE y) { return std::max(x,y); };
         size_t max_b = pbbso::reduce(imap, max);
         cur_range = (max_b + open_buckets) / open_buckets;
@@ -83,11 +94,14 @@ struct buckets {
         abort();
       }
 
+      if (approximate()) {
+        last_bkt_.assign(n, null_bkt);
+      }
+
       // Update buckets with all (id, bucket) pairs. Identifiers with bkt =
       // null_bkt are ignored by update_buckets.
       auto get_id_and_bkt = [&] (uintE i) -> Maybe<tuple<uintE, uintE> > {
-          //updated with delta
-        uintE bkt = (d[i] == null_bkt) ? null_bkt : d[i]/delta_;
+        uintE bkt = priority_to_bucket(d[i]);
         if (bkt != null_bkt) {
           bkt = to_range(bkt);
         }
@@ -110,9 +124,9 @@ struct buckets {
       return get_cur_bucket();
     }
 
-    // Computes a bucket_dest for an identifier moving to bucket_id next.
+    // Computes a bucket_dest for an identifier moving to bucket_id next (to priority next in the approximate mode).
     inline bucket_dest get_bucket_no_overflow_insertion(const bucket_id& next) const {
-      uintE nb = to_range(next);
+      uintE nb = to_range(approximate() ? priority_to_bucket(next) : next);
       // Note that the interface currently only implements strictly_decreasing 
       // priority, which is why the code below does not check pri_order.
       if (bkt_order == increasing) {
@@ -131,9 +145,9 @@ struct buckets {
       return null_bkt;
     }
 
-    // Computes a bucket_dest for an identifier moving to bucket_id next.
+    // Computes a bucket_dest for an identifier moving to bucket_id next (to priority next in the approximate mode).
     inline bucket_dest get_bucket_with_overflow_insertion(const bucket_id& next) const {
-        uintE nb = to_range(next);
+        uintE nb = to_range(approximate() ? priority_to_bucket(next) : next);
         // Note that the interface currently only implements strictly_decreasing
         // priority, which is why the code below does not check pri_order.
         if (bkt_order == increasing) {
@@ -152,6 +166,44 @@ struct buckets {
     }
 
 
+    inline bool approximate() const {
+      return eps_ > 0;
+    }
+
+    // Bucket of a priority. Exact buckets have a width of delta. Approximate bucket 0 holds priority 0 and bucket
+    // b > 0 holds the priorities in [(1+eps)^(b-1), (1+eps)^b), so a priority only changes bucket when it changes
+    // by a factor of (1+eps).
+    inline bucket_id priority_to_bucket(D priority) const {
+      if (priority == (D) null_bkt) {
+        return null_bkt;
+      }
+      if (!approximate()) {
+        return priority/delta_;
+      }
+      if (priority < 1) {
+        return 0;
+      }
+      return 1 + (bucket_id) floor(log((double) priority) / log_base_);
+    }
+
+    // Smallest priority in bucket b.
+    inline D bucket_to_priority(bucket_id b) const {
+      if (b == null_bkt) {
+        return null_bkt;
+      }
+      if (!approximate()) {
+        return b * delta_;
+      }
+      if (b == 0) {
+        return 0;
+      }
+      // corrects the rounding of pow against priority_to_bucket
+      D priority = (D) ceil(pow(1.0 + eps_, (double) (b - 1)));
+      while (priority > 1 && priority_to_bucket(priority - 1) >= b) priority--;
+      while (priority_to_bucket(priority) < b) priority++;
+      return priority;
+    }
+
     // Updates k identifiers in the bucket structure. The i'th identifier and
     // its bucket_dest are given by F(i).
     template <class F>
@@ -228,6 +280,7 @@ struct buckets {
            if (m.exists && b != null_bkt) {
              size_t ind = hists[(b*num_blocks + i)*CACHE_LINE_S];
              bkts[b].insert(v, ind);
+             mark_inserted(v, b);
              hists[(b*num_blocks + i)*CACHE_LINE_S]++;
            }
          }
@@ -256,6 +309,10 @@ struct buckets {
     size_t num_elms;
     size_t open_buckets;
     size_t total_buckets;
+    double log_base_;
+    // approximate mode: the bucket each identifier was last inserted into (null_bkt for the overflow bucket),
+    // so that the lazy re-bucketing skips the identifiers the caller already moved
+    std::vector<uintE> last_bkt_;
 
     template <class F>
     inline size_t update_buckets_seq(F& f, size_t n) {
@@ -266,6 +323,7 @@ struct buckets {
         if (m.exists && bkt != null_bkt) {
           bkts[bkt].resize(1);
           insert_in_bucket(bkt, std::get<0>(m.t));
+          mark_inserted(std::get<0>(m.t), bkt);
           num_elms++;
         }
       }
@@ -279,6 +337,12 @@ struct buckets {
       bkts[b].size += 1;
     }
 
+    inline void mark_inserted(uintE v, bucket_dest b) {
+      if (approximate()) {
+        last_bkt_[v] = (b == open_buckets) ? null_bkt : range_to_bucket(b);
+      }
+    }
+
     inline bool curBucketNonEmpty() {
       return bkts[cur_bkt].size > 0;
     }
@@ -299,9 +363,7 @@ struct buckets {
 
       auto g = [&] (uintE i) -> Maybe<tuple<uintE, uintE> > {
         uintE v = tmp[i];
-        //uintE bkt = to_range(d[v]);
-        D priority = (d[v] == null_bkt)? null_bkt : d[v]/delta_;
-        uintE bkt = to_range(priority);
+        uintE bkt = to_range(priority_to_bucket(d[v]));
           return Maybe<tuple<uintE, uintE> >(make_tuple(v, bkt));
       };
 
@@ -351,29 +413,71 @@ struct buckets {
       }
     }
 
-    size_t get_cur_bucket_num() const {
+    // inverse of to_range for the materialized buckets of the current range
+    inline size_t range_to_bucket(size_t b) const {
       if (bkt_order == increasing) {
-        return cur_range*open_buckets + cur_bkt;
+        return cur_range*open_buckets + b;
       } else {
-        return (cur_range)*(open_buckets) - cur_bkt - 1;
+        return (cur_range)*(open_buckets) - b - 1;
       }
     }
 
+    size_t get_cur_bucket_num() const {
+      return range_to_bucket(cur_bkt);
+    }
+
+    // Re-inserts the identifiers of an extracted bucket whose priority moved to a bucket that is not reached yet.
+    // Identifiers that were inserted into another bucket since (moved by the caller) already have an entry there,
+    // their entry here is dropped. An identifier is claimed by its first entry, so it is only re-inserted once.
+    inline void rebucket_moved_ahead(uintE* A, size_t size, size_t cur_bkt_num) {
+      // filtered first, update_buckets evaluates g twice
+      auto p = [&] (uintE v) {
+        bucket_id b = priority_to_bucket(d[v]);
+        bool ahead = (bkt_order == increasing) ? (b > cur_bkt_num) : (b < cur_bkt_num);
+        return b != null_bkt && ahead && CAS(&last_bkt_[v], (uintE) cur_bkt_num, null_bkt);
+      };
+      uintE* moved = newA(uintE, size);
+      size_t m = pbbso::filterf(A, moved, size, p);
+      auto g = [&] (size_t i) -> Maybe<tuple<uintE, uintE> > {
+        uintE v = moved[i];
+        return Maybe<tuple<uintE, uintE> >(make_tuple(v, to_range(priority_to_bucket(d[v]))));
+      };
+      update_buckets(g, m);
+      free(moved);
+    }
+
     inline bucket get_cur_bucket() {
       id_dyn_arr bkt = bkts[cur_bkt];
       size_t size = bkt.size;
       num_elms -= size;
       uintE* out = newA(uintE, size);
       size_t cur_bkt_num = get_cur_bucket_num();
-      auto p = [&] (size_t i) { return ((d[i] == null_bkt)? null_bkt : d[i]/delta_) == cur_bkt_num; };
-      size_t m = pbbso::filterf(bkt.A, out, size, p);
-      bkts[cur_bkt].size = 0;
+      size_t m;
+      if (approximate()) {
+        // filterf compacts its input, the re-bucketing gets a copy of the bucket
+        uintE* A = newA(uintE, size);
+        parallel_for(size_t i=0; i<size; i++) {
+          A[i] = bkt.A[i];
+        }
+        // an identifier moved by the caller within its bucket has several entries, the first one claims it
+        auto p = [&] (uintE v) {
+          return priority_to_bucket(d[v]) == cur_bkt_num && CAS(&last_bkt_[v], (uintE) cur_bkt_num, null_bkt);
+        };
+        m = pbbso::filterf(bkt.A, out, size, p);
+        bkts[cur_bkt].size = 0;
+        rebucket_moved_ahead(A, size, cur_bkt_num);
+        free(A);
+      } else {
+        auto p = [&] (size_t i) { return priority_to_bucket(d[i]) == cur_bkt_num; };
+        m = pbbso::filterf(bkt.A, out, size, p);
+        bkts[cur_bkt].size = 0;
+      }
       if (m == 0) {
         free(out);
         return next_bucket();
       }
       vertexSubset vs(n, m, out);
-      auto ret = bucket(cur_bkt_num, vs);
+      auto ret = bucket(approximate() ? bucket_to_priority(cur_bkt_num) : cur_bkt_num, vs);
       ret.num_filtered = size;
       return ret;
     }
@@ -0,0 +1,451 @@
+#pragma once
+
+#include <limits>
+#include <tuple>
+#include <vector>
+
+#include "bucket.h"
+
+// Alternative bucketing structures for PriorityQueue. They implement the interface of buckets (constructor,
+// next_bucket, update_buckets and get_bucket_*_insertion), but bucket_dest is the bucket id itself instead of a
+// slot of the open buckets, and an identifier is stored together with the bucket it was inserted into.
+// An entry is stale (and dropped) once the bucket of its identifier no longer matches.
+
+// An identifier with the key of its bucket. Keys are bucket ids, reversed for decreasing bucket orders,
+// so that buckets are always processed by increasing key.
+struct bucket_entry {
+  uintE key;
+  uintE id;
+};
+
+// Appends the entries given by f(i), for i < k, to bkts. f returns Maybe<tuple<E, size_t>> with the entry and
+// the index of its destination in bkts. f is called twice per index when the update runs in parallel.
+template <class E, class F>
+inline size_t scatter_into_buckets(dyn_arr<E>* bkts, size_t num_bkts, F& f, size_t k) {
+  int num_threads = getWorkers();
+  if (k < 4096 || num_threads == 1) {
+    size_t inserted = 0;
+    for (size_t i=0; i<k; i++) {
+      auto m = f(i);
+      if (m.exists) {
+        size_t b = std::get<1>(m.t);
+        bkts[b].resize(1);
+        bkts[b].A[bkts[b].size] = std::get<0>(m.t);
+        bkts[b].size += 1;
+        inserted++;
+      }
+    }
+    return inserted;
+  }
+
+  size_t num_blocks = 4 * num_threads;
+  size_t block_size = (k + num_blocks - 1) / num_blocks;
+  // counts[i*num_bkts + b]: entries of block i going to bucket b, then the offset of block i in bucket b
+  size_t* counts = newA(size_t, num_blocks * num_bkts);
+  parallel_for_1 (size_t i=0; i<num_blocks; i++) {
+    size_t* count = counts + i*num_bkts;
+    for (size_t b=0; b<num_bkts; b++) { count[b] = 0; }
+    size_t s = i * block_size;
+    size_t e = min(s + block_size, k);
+    for (size_t j=s; j<e; j++) {
+      auto m = f(j);
+      if (m.exists) {
+        count[std::get<1>(m.t)]++;
+      }
+    }
+  }
+
+  std::vector<size_t> totals(num_bkts);
+  size_t inserted = 0;
+  for (size_t b=0; b<num_bkts; b++) {
+    size_t total = 0;
+    for (size_t i=0; i<num_blocks; i++) {
+      size_t c = counts[i*num_bkts + b];
+      counts[i*num_bkts + b] = total;
+      total += c;
+    }
+    if (total > 0) {
+      bkts[b].resize(total);
+    }
+    totals[b] = total;
+    inserted += total;
+  }
+
+  parallel_for_1 (size_t i=0; i<num_blocks; i++) {
+    size_t* offset = counts + i*num_bkts;
+    size_t s = i * block_size;
+    size_t e = min(s + block_size, k);
+    for (size_t j=s; j<e; j++) {
+      auto m = f(j);
+      if (m.exists) {
+        size_t b = std::get<1>(m.t);
+        bkts[b].A[bkts[b].size + offset[b]] = std::get<0>(m.t);
+        offset[b]++;
+      }
+    }
+  }
+
+  for (size_t b=0; b<num_bkts; b++) {
+    bkts[b].size += totals[b];
+  }
+  free(counts);
+  return inserted;
+}
+
+// Shared by the bucket backends: key conversion and extraction of the identifiers of one key.
+template <class D>
+struct keyed_buckets_base {
+  const uintE null_bkt = std::numeric_limits<D>::max();
+  int delta_ = 1;
+
+  keyed_buckets_base(size_t _n, D* _d, bucket_order _bkt_order, int delta) :
+      delta_(delta), n(_n), d(_d), bkt_order(_bkt_order) {
+    if (bkt_order != increasing && bkt_order != decreasing) {
+      cout << "Unknown order: " << bkt_order
+           << ". Must be one of {increasing, decreasing}" << endl;
+      abort();
+    }
+  }
+
+  // Computes a bucket_dest for an identifier moving to bucket_id next. Both variants insert the identifier again,
+  // since the entry made before the move is stale now. Buckets behind the current one are dropped, as in buckets.
+  inline bucket_dest get_bucket_no_overflow_insertion(const bucket_id& next) const {
+    return get_bucket_with_overflow_insertion(next);
+  }
+
+  inline bucket_dest get_bucket_with_overflow_insertion(const bucket_id& next) const {
+    if (next == null_bkt || to_key(next) < cur_key) {
+      return null_bkt;
+    }
+    return next;
+  }
+
+ protected:
+  size_t n;
+  D* d;
+  const bucket_order bkt_order;
+  size_t num_elms = 0;
+  // key of the bucket returned last
+  uintE cur_key = 0;
+
+  inline uintE to_key(uintE bkt) const {
+    return (bkt_order == increasing) ? bkt : (null_bkt - 1) - bkt;
+  }
+
+  inline uintE from_key(uintE key) const {
+    return (bkt_order == increasing) ? key : (null_bkt - 1) - key;
+  }
+
+  // key of the bucket the identifier currently belongs to, UINT_E_MAX if it is in no bucket
+  inline uintE current_key(uintE v) const {
+    return (d[v] == null_bkt) ? UINT_E_MAX : to_key(d[v]/delta_);
+  }
+
+  inline bool is_stale(const bucket_entry& e) const {
+    return current_key(e.id) != e.key;
+  }
+
+  // smallest key among the entries that are not stale, UINT_E_MAX if there is none
+  inline uintE min_valid_key(const dyn_arr<bucket_entry>& bkt) const {
+    bucket_entry* A = bkt.A;
+    auto imap = make_in_imap<uintE>(bkt.size, [&] (size_t i) { return is_stale(A[i]) ? UINT_E_MAX : A[i].key; });
+    auto min = [] (uintE x, uintE y) { return std::min(x, y); };
+    return pbbso::reduce(imap, min);
+  }
+
+  // scatters the entries given by g, which wraps the update function of update_buckets. The update function
+  // is called once per identifier, as in buckets, so g is evaluated before scattering.
+  template <class G>
+  inline size_t scatter_updates(dyn_arr<bucket_entry>* bkts, size_t num_bkts, G& g, size_t k) {
+    typedef Maybe<tuple<bucket_entry, size_t> > M;
+    M* updates = newA(M, k);
+    parallel_for(size_t i=0; i<k; i++) {
+      updates[i] = g(i);
+    }
+    auto h = [&] (size_t i) { return updates[i]; };
+    size_t inserted = scatter_into_buckets(bkts, num_bkts, h, k);
+    free(updates);
+    return inserted;
+  }
+
+  // empties bkt, which only holds entries with key cur_key, and returns its identifiers that are still in it
+  inline bucket extract(dyn_arr<bucket_entry>& bkt) {
+    size_t size = bkt.size;
+    bucket_entry* A = bkt.A;
+    uintE* ids = newA(uintE, size);
+    parallel_for(size_t i=0; i<size; i++) {
+      ids[i] = is_stale(A[i]) ? UINT_E_MAX : A[i].id;
+    }
+    uintE* out = newA(uintE, size);
+    size_t m = pbbso::filterf(ids, out, size, [] (uintE v) { return v != UINT_E_MAX; });
+    free(ids);
+    bkt.size = 0;
+    num_elms -= size;
+    if (m == 0) {
+      free(out);
+      return bucket(null_bkt, vertexSubset(n));
+    }
+    vertexSubset vs(n, m, out);
+    auto ret = bucket(from_key(cur_key), vs);
+    ret.num_filtered = size;
+    return ret;
+  }
+};
+
+/**
+ * Monotone radix heap over the bucket keys. Bucket 0 holds the entries with the current key, bucket i > 0 the
+ * entries whose key first differs from the current key in bit i-1. When bucket 0 runs empty, the smallest key of
+ * the first non empty bucket becomes the current key and the entries of that bucket move to lower buckets.
+ * An entry moves at most once per key bit, independently of how widely the priorities are spread.
+ **/
+template <class D>
+struct radix_heap_buckets : public keyed_buckets_base<D> {
+  using base = keyed_buckets_base<D>;
+  using base::null_bkt;
+  using base::n;
+  using base::d;
+  using base::num_elms;
+  using base::cur_key;
+
+  static const size_t kNumRadixBkts = 8*sizeof(uintE) + 1;
+
+  radix_heap_buckets(size_t _n, D* _d, bucket_order _bkt_order, priority_order,
+                     size_t, int delta=1) :
+      base(_n, _d, _bkt_order, delta) {
+    auto f = [&] (size_t i) -> Maybe<tuple<bucket_entry, size_t> > {
+      uintE key = this->current_key(i);
+      if (key == UINT_E_MAX) {
+        return Maybe<tuple<bucket_entry, size_t> >();
+      }
+      bucket_entry e = {key, (uintE) i};
+      return Maybe<tuple<bucket_entry, size_t> >(make_tuple(e, radix_index(key)));
+    };
+    num_elms += scatter_into_buckets(bkts, kNumRadixBkts, f, n);
+  }
+
+  ~radix_heap_buckets() {
+    for (size_t i=0; i<kNumRadixBkts; i++) {
+      bkts[i].del();
+    }
+  }
+
+  // Returns the next non-empty bucket from the bucket structure. The return
+  // value's bkt_id is null_bkt when no further buckets remain.
+  inline bucket next_bucket() {
+    while (num_elms > 0) {
+      if (bkts[0].size == 0) {
+        size_t i = 1;
+        while (bkts[i].size == 0) { i++; }
+        redistribute(i);
+        continue;
+      }
+      auto ret = this->extract(bkts[0]);
+      if (ret.id != null_bkt) {
+        return ret;
+      }
+    }
+    return bucket(null_bkt, vertexSubset(n));
+  }
+
+  // Updates k identifiers in the bucket structure. The i'th identifier and
+  // its bucket_dest are given by F(i).
+  template <class F>
+  inline size_t update_buckets(F f, size_t k) {
+    auto g = [&] (size_t i) -> Maybe<tuple<bucket_entry, size_t> > {
+      auto m = f(i);
+      if (!m.exists || std::get<1>(m.t) == null_bkt) {
+        return Maybe<tuple<bucket_entry, size_t> >();
+      }
+      bucket_entry e = {this->to_key(std::get<1>(m.t)), std::get<0>(m.t)};
+      return Maybe<tuple<bucket_entry, size_t> >(make_tuple(e, radix_index(e.key)));
+    };
+    size_t inserted = this->scatter_updates(bkts, kNumRadixBkts, g, k);
+    num_elms += inserted;
+    return inserted;
+  }
+
+ private:
+  dyn_arr<bucket_entry> bkts[kNumRadixBkts];
+
+  inline size_t radix_index(uintE key) const {
+    if (key == cur_key) {
+      return 0;
+    }
+    return 8*sizeof(unsigned long) - __builtin_clzl((unsigned long) (key ^ cur_key));
+  }
+
+  // moves the entries of bucket i (all its keys are larger than the current key) into lower buckets
+  inline void redistribute(size_t i) {
+    dyn_arr<bucket_entry>& bkt = bkts[i];
+    size_t m = bkt.size;
+    uintE min_key = this->min_valid_key(bkt);
+    if (min_key != UINT_E_MAX) {
+      cur_key = min_key;
+      bucket_entry* A = bkt.A;
+      // the entries only move to buckets below i, so bkt can be read while scattering
+      auto f = [&] (size_t j) -> Maybe<tuple<bucket_entry, size_t> > {
+        if (this->is_stale(A[j])) {
+          return Maybe<tuple<bucket_entry, size_t> >();
+        }
+        return Maybe<tuple<bucket_entry, size_t> >(make_tuple(A[j], radix_index(A[j].key)));
+      };
+      num_elms += scatter_into_buckets(bkts, i, f, m);
+    }
+    bkt.size = 0;
+    num_elms -= m;
+  }
+};
+
+/**
+ * Two level bucket array. num_fine fine buckets hold one key each, starting at fine_base. The following keys are
+ * grouped by num_fine into num_coarse coarse buckets, and the keys beyond the coarse buckets share one overflow
+ * bucket. A coarse bucket is spread over the fine buckets when they run empty. The overflow bucket is only
+ * scanned once all coarse buckets are consumed, and then restarts the window at its smallest key, so empty key
+ * ranges are skipped instead of being visited one window at a time.
+ **/
+template <class D>
+struct two_level_buckets : public keyed_buckets_base<D> {
+  using base = keyed_buckets_base<D>;
+  using base::null_bkt;
+  using base::n;
+  using base::num_elms;
+  using base::cur_key;
+
+  two_level_buckets(size_t _n, D* _d, bucket_order _bkt_order, priority_order,
+                    size_t _total_buckets, int delta=1) :
+      base(_n, _d, _bkt_order, delta),
+      num_fine(std::max<size_t>(_total_buckets, 1)), num_coarse(std::max<size_t>(_total_buckets, 1)),
+      bkts(num_fine + num_coarse + 1) {
+    auto f = [&] (size_t i) -> Maybe<tuple<bucket_entry, size_t> > {
+      uintE key = this->current_key(i);
+      if (key == UINT_E_MAX) {
+        return Maybe<tuple<bucket_entry, size_t> >();
+      }
+      bucket_entry e = {key, (uintE) i};
+      return Maybe<tuple<bucket_entry, size_t> >(make_tuple(e, overflow_index()));
+    };
+    num_elms += scatter_into_buckets(bkts.data(), bkts.size(), f, n);
+    refill_from_overflow();
+  }
+
+  ~two_level_buckets() {
+    for (size_t i=0; i<bkts.size(); i++) {
+      bkts[i].del();
+    }
+  }
+
+  // Returns the next non-empty bucket from the bucket structure. The return
+  // value's bkt_id is null_bkt when no further buckets remain.
+  inline bucket next_bucket() {
+    while (num_elms > 0) {
+      while (cur_fine < num_fine && bkts[cur_fine].size == 0) { cur_fine++; }
+      if (cur_fine == num_fine) {
+        if (!refill_from_coarse()) {
+          refill_from_overflow();
+        }
+        continue;
+      }
+      cur_key = fine_base + cur_fine;
+      auto ret = this->extract(bkts[cur_fine]);
+      if (ret.id != null_bkt) {
+        return ret;
+      }
+    }
+    return bucket(null_bkt, vertexSubset(n));
+  }
+
+  // Updates k identifiers in the bucket structure. The i'th identifier and
+  // its bucket_dest are given by F(i).
+  template <class F>
+  inline size_t update_buckets(F f, size_t k) {
+    auto g = [&] (size_t i) -> Maybe<tuple<bucket_entry, size_t> > {
+      auto m = f(i);
+      if (!m.exists || std::get<1>(m.t) == null_bkt) {
+        return Maybe<tuple<bucket_entry, size_t> >();
+      }
+      bucket_entry e = {this->to_key(std::get<1>(m.t)), std::get<0>(m.t)};
+      return Maybe<tuple<bucket_entry, size_t> >(make_tuple(e, level_index(e.key)));
+    };
+    size_t inserted = this->scatter_updates(bkts.data(), bkts.size(), g, k);
+    num_elms += inserted;
+    return inserted;
+  }
+
+ private:
+  const size_t num_fine;
+  const size_t num_coarse;
+  // fine buckets, then coarse buckets, then the overflow bucket
+  std::vector<dyn_arr<bucket_entry> > bkts;
+  size_t fine_base = 0;
+  size_t cur_fine = 0;
+  size_t coarse_base = 0;
+  // coarse buckets before next_coarse have been spread over the fine buckets
+  size_t next_coarse = 0;
+
+  inline size_t overflow_index() const {
+    return num_fine + num_coarse;
+  }
+
+  inline size_t level_index(uintE key) const {
+    if (key < fine_base + num_fine) {
+      return key - fine_base;
+    }
+    if (key < coarse_base + num_coarse * num_fine) {
+      return num_fine + (key - coarse_base) / num_fine;
+    }
+    return overflow_index();
+  }
+
+  // spreads the next non empty coarse bucket over the fine buckets, returns false if there is none
+  inline bool refill_from_coarse() {
+    size_t j = next_coarse;
+    while (j < num_coarse && bkts[num_fine + j].size == 0) { j++; }
+    if (j == num_coarse) {
+      return false;
+    }
+    fine_base = coarse_base + j * num_fine;
+    cur_fine = 0;
+    // the keys before the window are done, later insertions of them are dropped
+    cur_key = fine_base;
+    next_coarse = j + 1;
+    dyn_arr<bucket_entry>& bkt = bkts[num_fine + j];
+    size_t m = bkt.size;
+    bucket_entry* A = bkt.A;
+    // all the keys of the coarse bucket fall into the fine buckets
+    auto f = [&] (size_t i) -> Maybe<tuple<bucket_entry, size_t> > {
+      if (this->is_stale(A[i])) {
+        return Maybe<tuple<bucket_entry, size_t> >();
+      }
+      return Maybe<tuple<bucket_entry, size_t> >(make_tuple(A[i], (size_t) (A[i].key - fine_base)));
+    };
+    num_elms += scatter_into_buckets(bkts.data(), num_fine, f, m);
+    bkt.size = 0;
+    num_elms -= m;
+    return true;
+  }
+
+  // restarts the fine and coarse buckets at the smallest key of the overflow bucket and redistributes it
+  inline void refill_from_overflow() {
+    dyn_arr<bucket_entry> overflow = bkts[overflow_index()];
+    bkts[overflow_index()] = dyn_arr<bucket_entry>();
+    size_t m = overflow.size;
+    uintE min_key = this->min_valid_key(overflow);
+    if (min_key != UINT_E_MAX) {
+      fine_base = min_key;
+      cur_fine = 0;
+      cur_key = fine_base;
+      coarse_base = fine_base + num_fine;
+      next_coarse = 0;
+      bucket_entry* A = overflow.A;
+      auto f = [&] (size_t i) -> Maybe<tuple<bucket_entry, size_t> > {
+        if (this->is_stale(A[i])) {
+          return Maybe<tuple<bucket_entry, size_t> >();
+        }
+        return Maybe<tuple<bucket_entry, size_t> >(make_tuple(A[i], level_index(A[i].key)));
+      };
+      num_elms += scatter_into_buckets(bkts.data(), bkts.size(), f, m);
+    }
+    num_elms -= m;
+    overflow.del();
+  }
+};
@@ -4,6 +4,7 @@
 
 //#include "platform_atomics.h"
 #include "bucket.h"
+#include "bucket_backends.h"
 
 
 typedef int64_t NodeID;
@@ -29,7 +30,8 @@ class PriorityFunctor {
 };
 */
 
-template<class D>
+// B is the bucketing structure: buckets (default), radix_heap_buckets or two_level_buckets
+template<class D, class B = buckets<D> >
 class PriorityQueue {
 
 
@@ -42,12 +44,28 @@ public:
   explicit PriorityQueue(size_t n, D* priority_array, bucket_order bkt_order, priority_order pri_order, size_t total_buckets=128, int delta = 1) {
 
       //cout << "constructing a priority map from array" << endl;
-      buckets_ = new buckets<D>(n, priority_array, bkt_order, pri_order, total_buckets, delta);
+      buckets_ = new B(n, priority_array, bkt_order, pri_order, total_buckets, delta);
       tracking_variable = priority_array;
       cur_priority_ = 0;
       delta_ = delta;
   }
 
+  // approximate (1+eps) geometric buckets, only implemented by buckets, see buckets::priority_to_bucket.
+  // The current priority is then the smallest priority of the current bucket.
+  PriorityQueue(size_t n, D* priority_array, bucket_order bkt_order, priority_order pri_order, size_t total_buckets,
+                int delta, double eps) {
+      buckets_ = new B(n, priority_array, bkt_order, pri_order, total_buckets, delta, eps);
+      tracking_variable = priority_array;
+      cur_priority_ = 0;
+      delta_ = delta;
+      eps_ = eps;
+  }
+
+  // 0 for exact buckets
+  double get_epsilon(){
+    return eps_;
+  }
+
 
 
   // get the prioirty of the current iteration (each iter has a priority)
@@ -87,8 +105,9 @@ public:
     delete buckets_;
   }
   
-  buckets<D>* buckets_;
+  B* buckets_;
   uintE cur_priority_ = 0;
+  double eps_ = 0;
   
   inline bool finished(void) {
       return cur_priority_ == buckets_->null_bkt;
@@ -50,6 +50,7 @@
 #include <tuple>
 #include <type_traits>
 #include <unistd.h>
+#include <vector>
 
 
 #define ulong unsigned long
@@ -81,13 +82,16 @@ static julienne::graph<julienne::symmetricVertex> __julienne_null_graph(NULL, 0,
 #include "infra_gapbs/platform_atomics.h"
 #include "infra_gapbs/pvector.h"
 #include "infra_gapbs/eager_priority_queue.h"
+#include "infra_gapbs/delta_selection.h"
 #include <queue>
 #include <curses.h>
 #include "infra_gapbs/timer.h"
 #include "infra_gapbs/sliding_queue.h"
 #include "infra_gapbs/ordered_processing.h"
+#include "infra_gapbs/bidirectional_delta_stepping.h"
 
 #include "edgeset_apply_functions.h"
+#include "multi_source_traversal.h"
 #include <unordered_map>
 #include <unordered_set>
 
@@ -103,6 +107,11 @@ namespace julienne {
 #include <time.h>
 #include <chrono>
 #include "infra_gapbs/minimum_spanning_tree.h"
+#include "infra_gapbs/landmarks.h"
+#include "infra_gapbs/shortest_path_queries.h"
+#include "infra_gapbs/sweep_cut.h"
+#include "infra_gapbs/random_walk.h"
+#include "infra_gapbs/touched_vertices.h"
 #include <float.h>
 
 
@@ -215,6 +224,16 @@ static Graph builtin_relabel(Graph &edges) {
     return edges;
 }
 
+// directed copy of an undirected graph for triangle and clique counting, "degree" keeps every edge once from the lower
+// to the higher degree endpoint (see Builder::OrientByDegree)
+static Graph builtin_orient(Graph &edges, std::string order) {
+    if (order != "degree") {
+        std::cout << "Error: unsupported orientation " << order << std::endl;
+        throw std::runtime_error("Unsupported orientation");
+    }
+    return Builder::OrientByDegree(edges);
+}
+
 static VertexSubset<NodeID>* builtin_getNgh(Graph &edges, NodeID src){
     auto v =  new VertexSubset<NodeID>(edges.out_degree(src));
     v->dense_vertex_set_ = (unsigned int*) edges.out_neigh(src).begin();
@@ -228,27 +247,77 @@ static VertexSubset<NodeID>* builtin_getNgh(WGraph &edges, NodeID src){
 }
 
 
-static size_t hiroshiVertexIntersection(VertexSubset<NodeID>* A, VertexSubset<NodeID>* B, size_t totalA, size_t totalB, NodeID dest) {
-    return intersectSortedNodeSetHiroshi((NodeID *) A->dense_vertex_set_, (NodeID *) B->dense_vertex_set_, totalA, totalB, dest);
+// neighbors of a vertex without a VertexSubset, emitted for getNgh results that are only passed to intersection.
+// Does not own the neighbor array
+struct NeighborView {
+    NodeID* data;
+    int64_t size;
+    // bitmap of the neighbors when src is a hub of the graph (see Graph::SetUpHubBitmaps), nullptr otherwise
+    const Bitmap* hub;
+};
+
+static NeighborView builtin_getNghView(Graph &edges, NodeID src){
+    HubBitmaps<NodeID>* hubs = edges.get_hub_bitmaps_();
+    return {edges.out_neigh(src).begin(), edges.out_degree(src), hubs == nullptr ? nullptr : hubs->bitmap(src)};
+}
+
+static NodeID* IntersectionOperand(VertexSubset<NodeID>* set){
+    return (NodeID *) set->dense_vertex_set_;
+}
+
+static NodeID* IntersectionOperand(const NeighborView &view){
+    return view.data;
+}
+
+static const Bitmap* HubBitmapOperand(VertexSubset<NodeID>*){
+    return nullptr;
+}
+
+static const Bitmap* HubBitmapOperand(const NeighborView &view){
+    return view.hub;
+}
+
+template <typename SetA, typename SetB>
+static size_t hiroshiVertexIntersection(const SetA &A, const SetB &B, size_t totalA, size_t totalB, NodeID dest=(NodeID)INT32_MAX) {
+    return intersectSortedNodeSetHiroshi(IntersectionOperand(A), IntersectionOperand(B), totalA, totalB, dest);
 
 }
 
-static size_t multiSkipVertexIntersection(VertexSubset<NodeID>* A, VertexSubset<NodeID>* B, size_t totalA, size_t totalB, NodeID dest) {
-    return intersectSortedNodeSetMultipleSkip((NodeID *) A->dense_vertex_set_, (NodeID *) B->dense_vertex_set_, totalA, totalB, dest);
+template <typename SetA, typename SetB>
+static size_t multiSkipVertexIntersection(const SetA &A, const SetB &B, size_t totalA, size_t totalB, NodeID dest=(NodeID)INT32_MAX) {
+    return intersectSortedNodeSetMultipleSkip(IntersectionOperand(A), IntersectionOperand(B), totalA, totalB, dest);
 
 }
 
-static size_t naiveVertexIntersection(VertexSubset<NodeID>* A, VertexSubset<NodeID>* B, size_t totalA, size_t totalB, NodeID dest) {
-    return intersectSortedNodeSetNaive((NodeID *) A->dense_vertex_set_, (NodeID *) B->dense_vertex_set_, totalA, totalB, dest);
+template <typename SetA, typename SetB>
+static size_t naiveVertexIntersection(const SetA &A, const SetB &B, size_t totalA, size_t totalB, NodeID dest=(NodeID)INT32_MAX) {
+    return intersectSortedNodeSetNaive(IntersectionOperand(A), IntersectionOperand(B), totalA, totalB, dest);
 }
 
-static size_t combinedVertexIntersection(VertexSubset<NodeID>* A, VertexSubset<NodeID>* B, size_t totalA, size_t totalB) {
-    // currently just has fixed thresholds
-    return intersectSortedNodeSetCombined((NodeID *) A->dense_vertex_set_, (NodeID *) B->dense_vertex_set_, totalA, totalB, 1000, 0.1);
+// AVX-512 or AVX2 block compare, whichever the processor supports
+template <typename SetA, typename SetB>
+static size_t simdVertexIntersection(const SetA &A, const SetB &B, size_t totalA, size_t totalB, NodeID dest=(NodeID)INT32_MAX) {
+    return intersectSortedNodeSetSIMD(IntersectionOperand(A), IntersectionOperand(B), totalA, totalB, dest);
 }
 
-static size_t binarySearchIntersection(VertexSubset<NodeID>* A, VertexSubset<NodeID>* B, size_t totalA, size_t totalB) {
-    return intersectSortedNodeSetBinarySearch((NodeID *) A->dense_vertex_set_, (NodeID *) B->dense_vertex_set_, totalA, totalB);
+template <typename SetA, typename SetB>
+static size_t combinedVertexIntersection(const SetA &A, const SetB &B, size_t totalA, size_t totalB, NodeID dest=(NodeID)INT32_MAX,
+                                         size_t sizeThreshold=1000, double ratioThreshold=0.1) {
+    return intersectSortedNodeSetCombined(IntersectionOperand(A), IntersectionOperand(B), totalA, totalB,
+                                          sizeThreshold, ratioThreshold, dest);
+}
+
+// bitmap probes when one of the sets is the neighborhood of a hub, combined intersection otherwise
+template <typename SetA, typename SetB>
+static size_t hubBitmapVertexIntersection(const SetA &A, const SetB &B, size_t totalA, size_t totalB, NodeID dest=(NodeID)INT32_MAX,
+                                          size_t sizeThreshold=1000, double ratioThreshold=0.1) {
+    return intersectSortedNodeSetHubBitmap(IntersectionOperand(A), IntersectionOperand(B), HubBitmapOperand(A),
+                                           HubBitmapOperand(B), totalA, totalB, sizeThreshold, ratioThreshold, dest);
+}
+
+template <typename SetA, typename SetB>
+static size_t binarySearchIntersection(const SetA &A, const SetB &B, size_t totalA, size_t totalB) {
+    return intersectSortedNodeSetBinarySearch(IntersectionOperand(A), IntersectionOperand(B), totalA, totalB);
 }
 
 template <typename T>
@@ -310,6 +379,25 @@ static VertexSubset<int>* serialSweepCut(Graph& graph,  VertexSubset<int> * vert
     return output_vertexset;
 }
 
+// same cut as serialSweepCut, computed with a parallel sort and prefix scans (see infra_gapbs/sweep_cut.h).
+// The input vertex set is left in its original order
+static VertexSubset<int>* parallelSweepCut(Graph& graph,  VertexSubset<int> * vertices, double* val_array){
+    vertices->toSparse();
+    int64_t num_vertices = vertices->num_vertices_;
+    unsigned int* order = new unsigned int[num_vertices];
+    #pragma omp parallel for
+    for (int64_t i = 0; i < num_vertices; i++)
+        order[i] = vertices->dense_vertex_set_[i];
+
+    int64_t best_cut = SweepCutBestPrefix(graph, order, num_vertices, val_array);
+
+    //the output holds the sorted vertices, its size is the best cut as in serialSweepCut
+    VertexSubset<int>* output_vertexset = new VertexSubset<int>(vertices->vertices_range_, 0);
+    output_vertexset->dense_vertex_set_ = order;
+    output_vertexset->num_vertices_ = best_cut;
+    return output_vertexset;
+}
+
 static int getRandomOutNgh(Graph &edges, NodeID v){
     return edges.get_random_out_neigh(v);
 }
@@ -318,8 +406,135 @@ static int getRandomInNgh(Graph &edges, NodeID v){
     return edges.get_random_in_neigh(v);
 }
 
+// seeds the random numbers of getRandomOutNgh, getRandomInNgh and writeRandomWalks (0 until it is called)
+static void setRandomSeed(int seed){
+    SetGlobalRandomSeed(seed);
+}
+
+template <class Graph_>
+static int WriteRandomWalks(Graph_ &edges, int walks_per_vertex, int walk_length, std::string file_name){
+    std::ofstream file(file_name);
+    if (!file.is_open()) {
+        std::cout << "Error: could not write the random walks to " << file_name << std::endl;
+        throw std::runtime_error("Could not write random walks");
+    }
+    std::vector<NodeID> starts;
+    for (NodeID v = 0; v < edges.num_nodes(); v++) {
+        if (edges.out_degree(v) > 0) starts.push_back(v);
+    }
+    RandomWalkEngine<Graph_> engine(edges, GlobalRandomSeed());
+    const int64_t kChunkSize = 1 << 20;
+    std::vector<NodeID> walks;
+    for (int round = 0; round < walks_per_vertex; round++) {
+        for (int64_t chunk = 0; chunk < (int64_t) starts.size(); chunk += kChunkSize) {
+            int64_t num_walkers = std::min(kChunkSize, (int64_t) starts.size() - chunk);
+            walks.resize(num_walkers * (walk_length + 1));
+            engine.walk(starts.data() + chunk, num_walkers, walk_length, walks.data(),
+                        (uint64_t) round * edges.num_nodes() + chunk);
+            for (int64_t w = 0; w < num_walkers; w++) {
+                file << walks[w * (walk_length + 1)];
+                for (int s = 1; s <= walk_length && walks[w * (walk_length + 1) + s] >= 0; s++)
+                    file << " " << walks[w * (walk_length + 1) + s];
+                file << "\n";
+            }
+        }
+    }
+    return walks_per_vertex * starts.size();
+}
+
+// writes walks_per_vertex walks of walk_length steps from every vertex with out edges to file_name (one walk per
+// line, DeepWalk corpus format) and returns the number of walks. Walks on a weighted edgeset follow the weights
+static int writeRandomWalks(Graph &edges, int walks_per_vertex, int walk_length, std::string file_name){
+    return WriteRandomWalks(edges, walks_per_vertex, walk_length, file_name);
+}
+
+static int writeRandomWalks(WGraph &edges, int walks_per_vertex, int walk_length, std::string file_name){
+    return WriteRandomWalks(edges, walks_per_vertex, walk_length, file_name);
+}
+
+// parent array of the minimum spanning forest, rooted at start in its tree (kept under its original name, the
+// forest is computed in parallel with Boruvka)
 static int* serialMinimumSpanningTree(WGraph &edges, NodeID start){
-    return minimum_spanning_tree(edges, start);
+    return minimum_spanning_forest(edges, start);
+}
+
+// length of the shortest path from src to dst, INT_MAX if dst is not reachable. delta <= 0 selects delta from the graph
+static int bidirectionalDeltaStepping(WGraph &edges, NodeID src, NodeID dst, int delta){
+    return BidirectionalDeltaStepping(edges, src, dst, delta);
+}
+
+// answers the "source destination" lines of stdin until the end of the input, delta <= 0 selects delta from the graph
+static void servePPSPQueries(WGraph &edges, int delta){
+    ShortestPathQueryEngine<WGraph> engine(edges, delta);
+    engine.serve(std::cin, std::cout);
+}
+
+// landmark tables used by landmarkLowerBound, built by buildLandmarks or read by loadLandmarks
+static LandmarkTable __graphit_landmarks;
+
+static void buildLandmarks(WGraph &edges, int num_landmarks){
+    __graphit_landmarks.build(edges, num_landmarks);
+}
+
+// returns false if the file is missing or was built for another graph, buildLandmarks has to be called then
+static bool loadLandmarks(WGraph &edges, std::string file_name){
+    return __graphit_landmarks.load(edges, file_name);
+}
+
+static void saveLandmarks(std::string file_name){
+    if (!__graphit_landmarks.save(file_name)) {
+        std::cout << "Error: could not write the landmarks to " << file_name << std::endl;
+        throw std::runtime_error("Could not write landmarks");
+    }
+}
+
+// ALT lower bound on the distance from v to t, 0 when no landmarks were built or loaded
+static int landmarkLowerBound(NodeID v, NodeID t){
+    return __graphit_landmarks.lower_bound(v, t);
+}
+
+// sums[s] is the sum of the hop distances from s to the vertices it reaches, for every s in sources
+static void multiSourceBFSDistanceSums(Graph &edges, VertexSubset<NodeID>* sources, int* sums){
+    int num_threads = 1;
+#if defined(OPENMP)
+    num_threads = omp_get_max_threads();
+#endif
+    ForEachSourceBatch(sources, [&](const NodeID* batch, int batch_size) {
+        std::vector<int64_t> partial_sums(num_threads * kMaxBatchSources, 0);
+        MultiSourceBFS(edges, batch, batch_size, [&](NodeID, uint64_t lanes, int depth) {
+            int thread_id = 0;
+#if defined(OPENMP)
+            thread_id = omp_get_thread_num();
+#endif
+            int64_t* thread_sums = &partial_sums[thread_id * kMaxBatchSources];
+            ForEachLane(lanes, [&](int lane) { thread_sums[lane] += depth; });
+        });
+        for (int lane = 0; lane < batch_size; lane++) {
+            int64_t sum = 0;
+            for (int t = 0; t < num_threads; t++)
+                sum += partial_sums[t * kMaxBatchSources + lane];
+            sums[batch[lane]] = sum;
+        }
+    });
+}
+
+// sums[s] is the sum of the weighted distances from s to the vertices it reaches, for every s in sources
+static void multiSourceSSSPDistanceSums(WGraph &edges, VertexSubset<NodeID>* sources, int* sums){
+    const WeightT kDistInf = std::numeric_limits<WeightT>::max()/2;
+    WeightT* dist = new WeightT[edges.num_nodes() * kMaxBatchSources];
+    ForEachSourceBatch(sources, [&](const NodeID* batch, int batch_size) {
+        MultiSourceSSSP(edges, batch, batch_size, dist);
+        for (int lane = 0; lane < batch_size; lane++) {
+            int64_t sum = 0;
+#pragma omp parallel for reduction(+:sum)
+            for (NodeID v = 0; v < edges.num_nodes(); v++) {
+                WeightT d = dist[(int64_t) v * batch_size + lane];
+                if (d != kDistInf) sum += d;
+            }
+            sums[batch[lane]] = sum;
+        }
+    });
+    delete[] dist;
 }
 
 static int * builtin_getOutDegrees(Graph &edges){
@@ -450,21 +665,52 @@ template<typename APPLY_FUNC> static void builtin_vertexset_apply(VertexSubset<i
    }
 }
 
+// records a write to a field restored by a sparse reset vertexset apply
+static inline void builtin_touchVertex(TouchedVertices* touched_vertices, NodeID v){
+    touched_vertices->touch(v);
+}
+
+// sparse reset vertexset apply, only visits the vertices written since its last run (all of them once too many were)
+template<typename APPLY_FUNC> static void builtin_touchedVertexSetApply(TouchedVertices* touched_vertices, APPLY_FUNC apply_func){
+    touched_vertices->for_each(apply_func);
+    touched_vertices->clear();
+}
+
 template<typename OBJECT_TYPE>
 static void deleteObject(OBJECT_TYPE* object) {
    if(object)
        delete object;
 }
+// Evaluates pred on every vertex in [0, n) in parallel and stores the result in the bool map next.
+// Every block is counted right after it is written, while it is still in cache,
+// so the map is only traversed once and the count is a reduction over the block sums.
+// The sparse form is only packed from the map if a consumer calls toSparse.
+template <typename T>
+static int64_t builtin_vertexset_filter_into_bool_map(bool * next, int64_t n, T pred) {
+    if (n <= 0) return 0;
+    int64_t num_blocks = nblocks(n, _F_BSIZE);
+    int64_t * block_counts = newA(int64_t, num_blocks);
+    ligra::parallel_for_lambda((int64_t)0, num_blocks, [&] (int64_t b) {
+        int64_t start = b * _F_BSIZE;
+        int64_t end = std::min(start + (int64_t)_F_BSIZE, n);
+        int64_t count = 0;
+        for (int64_t v = start; v < end; v++) {
+            next[v] = pred(v);
+            count += next[v];
+        }
+        block_counts[b] = count;
+    });
+    int64_t total = sequence::plusReduce(block_counts, num_blocks);
+    free(block_counts);
+    return total;
+}
+
 template <typename T>
 static VertexSubset<int> * builtin_const_vertexset_filter(T func, int total_elements) {
     VertexSubset<int> * output = new VertexSubset<NodeID>( total_elements, 0);
     bool * next0 = newA(bool, total_elements);
-    parallel_for(int v = 0; v < total_elements; v++) {
-        next0[v] = 0;
-        if (func(v))
-            next0[v] = 1;
-    }
-    output->num_vertices_ = sequence::sum(next0, total_elements);
+    output->num_vertices_ = builtin_vertexset_filter_into_bool_map(next0, total_elements,
+                                                                   [&] (int64_t v) -> bool { return func(v); });
     output->bool_map_ = next0;
     output->is_dense = true;
     return output;
@@ -489,40 +735,40 @@ static void deleteObject(julienne::vertexSubset set) {
 template <typename T>
 static VertexSubset<int> * builtin_vertexset_filter(VertexSubset<int> * input, T func) {
     int total_elements = input->vertices_range_;
-    //std::cout << "Filter range = " << total_elements << std::endl;
     VertexSubset<int> * output = new VertexSubset<NodeID>( total_elements, 0);
-    bool * next0 = newA(bool, total_elements);
-    parallel_for(int v = 0; v < total_elements; v++)
-        next0[v] = 0;
     if (input->is_dense) {
-        //std::cout << "Vertex subset is dense" << std::endl;
-        parallel_for(int v = 0; v < total_elements; v++) {
-            if (input->bool_map_[v] && func(v))
-                next0[v] = 1;
-	}
-    } else {
-        //std::cout << "Vertex subset is sparse" << std::endl;
-        if(!(input->dense_vertex_set_ == nullptr && input->num_vertices_ > 0))
-            parallel_for(int v = 0; v < input->num_vertices_; v++) {
-                //std::cout << "Vertex subset iteration for dense vertex set" << std::endl;
-                if (func(input->dense_vertex_set_[v]))
-                    next0[input->dense_vertex_set_[v]] = 1;
-            }
-	else 
-            parallel_for(int v = 0; v < input->num_vertices_; v++) {
-                //std::cout << "Vertex subset iteration for tmp" << std::endl;
-                if (func(input->tmp[v]))
-                    next0[input->tmp[v]] = 1;
-            }
+        bool * next0 = newA(bool, total_elements);
+        bool * input_map = input->bool_map_;
+        output->num_vertices_ = builtin_vertexset_filter_into_bool_map(next0, total_elements,
+                                                                       [&] (int64_t v) -> bool { return input_map[v] && func(v); });
+        output->bool_map_ = next0;
+        output->is_dense = true;
+        return output;
     }
-    output->num_vertices_ = sequence::sum(next0, total_elements);
-    output->bool_map_ = next0;
-    output->is_dense = true;
+
+    // a sparse input stays sparse, the work is proportional to the size of the input and not the range
+    int64_t num_input = input->num_vertices_;
+    const unsigned int * input_vertices = input->dense_vertex_set_;
+    std::vector<unsigned int> input_tmp;
+    if (input_vertices == nullptr && num_input > 0) {
+        input_tmp.assign(input->tmp.begin(), input->tmp.end());
+        num_input = input_tmp.size();
+        input_vertices = input_tmp.data();
+    }
+    bool * flags = newA(bool, num_input);
+    int64_t num_output = builtin_vertexset_filter_into_bool_map(flags, num_input,
+                                                                [&] (int64_t i) -> bool { return func(input_vertices[i]); });
+    unsigned int * next0 = new unsigned int[num_output];
+    sequence::pack(next0, flags, (int64_t) 0, num_input, sequence::getA<unsigned int, int64_t>((unsigned int *) input_vertices));
+    free(flags);
+    output->num_vertices_ = num_output;
+    output->dense_vertex_set_ = next0;
+    output->is_dense = false;
     return output;
 }
 
-template <typename PriorityType>
-  VertexSubset<NodeID> * getBucketWithGraphItVertexSubset(julienne::PriorityQueue<PriorityType>* pq){
+template <typename PriorityType, typename BucketsType>
+  VertexSubset<NodeID> * getBucketWithGraphItVertexSubset(julienne::PriorityQueue<PriorityType, BucketsType>* pq){
     julienne::vertexSubset ready_set = pq->dequeue_ready_set();
 
     auto vset =  new VertexSubset<NodeID> (ready_set);
@@ -533,8 +779,8 @@ template <typename PriorityType>
 }
 
 
-template <typename PriorityType>
-void updateBucketWithGraphItVertexSubset(VertexSubset<NodeID>* vset, julienne::PriorityQueue<PriorityType>* pq, bool nodes_init_in_bucket, int delta = 1){
+template <typename PriorityType, typename BucketsType>
+void updateBucketWithGraphItVertexSubset(VertexSubset<NodeID>* vset, julienne::PriorityQueue<PriorityType, BucketsType>* pq, bool nodes_init_in_bucket, int delta = 1){
     vset->toSparse();
 
     if (vset->size() == 0){
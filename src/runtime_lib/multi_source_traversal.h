@@ -0,0 +1,219 @@
+#ifndef GRAPHIT_MULTI_SOURCE_TRAVERSAL_H
+#define GRAPHIT_MULTI_SOURCE_TRAVERSAL_H
+
+#include <algorithm>
+#include <cinttypes>
+#include <limits>
+#include <vector>
+
+#include "vertexsubset.h"
+#include "infra_gapbs/benchmark.h"
+#include "infra_gapbs/graph.h"
+#include "infra_gapbs/platform_atomics.h"
+#include "infra_gapbs/delta_selection.h"
+
+// one bit of a 64 bit lane mask per source of a batch
+const int kMaxBatchSources = 64;
+
+// a level pulls instead of pushing once its frontier has more than this fraction of the edges
+const int kMultiSourcePullFraction = 15;
+
+inline uint64_t LaneBit(int lane){
+    return uint64_t(1) << lane;
+}
+
+// calls f(lane) for every set bit of the mask
+template <class F>
+inline void ForEachLane(uint64_t lanes, F f){
+    while (lanes != 0) {
+        f(__builtin_ctzll(lanes));
+        lanes &= lanes - 1;
+    }
+}
+
+// appends the nodes collected by every thread to the shared vector
+inline void AppendLocalNodes(std::vector<NodeID> &shared, std::vector<NodeID> &local){
+#pragma omp critical
+    shared.insert(shared.end(), local.begin(), local.end());
+}
+
+
+/**
+ * Bit-parallel BFS from up to 64 sources sharing a single traversal.
+ * Bit i of the masks of a node stands for sources[i]: seen holds the sources that reached the node, frontier the
+ * ones that reached it in the last level. A level moves the frontier masks along every edge once for all the
+ * sources, pushing from the active nodes with an atomic or while the frontier is small, and pulling over the in
+ * edges (no atomics) once it is large.
+ * visit(v, lanes, depth) is called once for every node and depth at which some sources reached it first, with the
+ * mask of those sources. It is called by several threads concurrently.
+ **/
+template <class Graph_, class VisitFunc>
+void MultiSourceBFS(const Graph_ &g, const NodeID* sources, int num_sources, VisitFunc visit){
+    int64_t num_nodes = g.num_nodes();
+    std::vector<uint64_t> seen(num_nodes, 0);
+    std::vector<uint64_t> frontier(num_nodes, 0);
+    std::vector<uint64_t> next(num_nodes, 0);
+    std::vector<NodeID> active;
+    std::vector<NodeID> next_active;
+
+    num_sources = std::min(num_sources, kMaxBatchSources);
+    const uint64_t all_lanes = num_sources == kMaxBatchSources ? ~uint64_t(0) : LaneBit(num_sources) - 1;
+    for (int lane = 0; lane < num_sources; lane++) {
+        NodeID s = sources[lane];
+        if (seen[s] == 0) active.push_back(s);
+        seen[s] |= LaneBit(lane);
+    }
+    for (NodeID s : active) {
+        frontier[s] = seen[s];
+        visit(s, seen[s], 0);
+    }
+
+    for (int depth = 1; !active.empty(); depth++) {
+        int64_t frontier_edges = 0;
+#pragma omp parallel for reduction(+:frontier_edges)
+        for (size_t i = 0; i < active.size(); i++)
+            frontier_edges += g.out_degree(active[i]);
+
+        bool pull = frontier_edges > g.num_edges_directed() / kMultiSourcePullFraction;
+#pragma omp parallel
+        {
+            std::vector<NodeID> local_active;
+            if (pull) {
+#pragma omp for nowait schedule(dynamic, 1024)
+                for (NodeID v = 0; v < num_nodes; v++) {
+                    if (seen[v] == all_lanes) continue;
+                    uint64_t lanes = 0;
+                    for (auto u : g.in_neigh(v))
+                        lanes |= frontier[EdgeTarget(u)];
+                    lanes &= ~seen[v];
+                    if (lanes != 0) {
+                        next[v] = lanes;
+                        local_active.push_back(v);
+                    }
+                }
+            } else {
+#pragma omp for nowait schedule(dynamic, 64)
+                for (size_t i = 0; i < active.size(); i++) {
+                    NodeID u = active[i];
+                    for (auto wn : g.out_neigh(u)) {
+                        NodeID v = EdgeTarget(wn);
+                        uint64_t lanes = frontier[u] & ~seen[v];
+                        if (lanes == 0 || (next[v] & lanes) == lanes) continue;
+                        if (__sync_fetch_and_or(&next[v], lanes) == 0)
+                            local_active.push_back(v);
+                    }
+                }
+            }
+            AppendLocalNodes(next_active, local_active);
+        }
+
+#pragma omp parallel for
+        for (size_t i = 0; i < active.size(); i++)
+            frontier[active[i]] = 0;
+
+#pragma omp parallel for schedule(dynamic, 1024)
+        for (size_t i = 0; i < next_active.size(); i++) {
+            NodeID v = next_active[i];
+            uint64_t lanes = next[v];
+            next[v] = 0;
+            seen[v] |= lanes;
+            frontier[v] = lanes;
+            visit(v, lanes, depth);
+        }
+        active.swap(next_active);
+        next_active.resize(0);
+    }
+}
+
+
+/**
+ * Shortest paths from up to 64 sources sharing a single traversal.
+ * The distances of a node to all the sources are kept next to each other (dist[v * num_sources + lane], the caller
+ * allocates num_nodes * num_sources entries), so that relaxing an edge updates all the lanes that changed at its
+ * source with one pass over a contiguous row. Rounds are Bellman-Ford style over the nodes with a changed lane,
+ * changed holds the mask of the lanes that improved since the node was last relaxed.
+ * Unreachable nodes keep numeric_limits<WeightT>::max()/2.
+ **/
+template <class WGraph_>
+void MultiSourceSSSP(const WGraph_ &g, const NodeID* sources, int num_sources, WeightT* dist){
+    int64_t num_nodes = g.num_nodes();
+    const WeightT kDistInf = std::numeric_limits<WeightT>::max()/2;
+    num_sources = std::min(num_sources, kMaxBatchSources);
+    std::vector<uint64_t> changed(num_nodes, 0);
+    std::vector<uint64_t> next(num_nodes, 0);
+    std::vector<NodeID> active;
+    std::vector<NodeID> next_active;
+
+#pragma omp parallel for
+    for (int64_t i = 0; i < num_nodes * num_sources; i++)
+        dist[i] = kDistInf;
+    for (int lane = 0; lane < num_sources; lane++) {
+        NodeID s = sources[lane];
+        if (changed[s] == 0) active.push_back(s);
+        changed[s] |= LaneBit(lane);
+        dist[(int64_t) s * num_sources + lane] = 0;
+    }
+
+    while (!active.empty()) {
+#pragma omp parallel
+        {
+            std::vector<NodeID> local_active;
+#pragma omp for nowait schedule(dynamic, 64)
+            for (size_t i = 0; i < active.size(); i++) {
+                NodeID u = active[i];
+                uint64_t lanes = changed[u];
+                const WeightT* dist_u = dist + (int64_t) u * num_sources;
+                for (auto wn : g.out_neigh(u)) {
+                    NodeID v = EdgeTarget(wn);
+                    WeightT w = OutEdgeWeight(wn);
+                    WeightT* dist_v = dist + (int64_t) v * num_sources;
+                    uint64_t improved = 0;
+                    ForEachLane(lanes, [&](int lane) {
+                        WeightT new_dist = dist_u[lane] + w;
+                        WeightT old_dist = dist_v[lane];
+                        while (new_dist < old_dist) {
+                            if (compare_and_swap(dist_v[lane], old_dist, new_dist)) {
+                                improved |= LaneBit(lane);
+                                break;
+                            }
+                            old_dist = dist_v[lane];
+                        }
+                    });
+                    if (improved != 0 && __sync_fetch_and_or(&next[v], improved) == 0)
+                        local_active.push_back(v);
+                }
+            }
+            AppendLocalNodes(next_active, local_active);
+        }
+
+#pragma omp parallel for
+        for (size_t i = 0; i < active.size(); i++)
+            changed[active[i]] = 0;
+
+#pragma omp parallel for
+        for (size_t i = 0; i < next_active.size(); i++) {
+            NodeID v = next_active[i];
+            changed[v] = next[v];
+            next[v] = 0;
+        }
+        active.swap(next_active);
+        next_active.resize(0);
+    }
+}
+
+
+// runs traverse_batch(sources, num_sources) over the vertices of the set in batches of at most 64 sources
+template <class TraverseBatchFunc>
+void ForEachSourceBatch(VertexSubset<NodeID>* source_set, TraverseBatchFunc traverse_batch){
+    source_set->toSparse();
+    int64_t num_sources = source_set->size();
+    std::vector<NodeID> sources(num_sources);
+    for (int64_t i = 0; i < num_sources; i++)
+        sources[i] = source_set->dense_vertex_set_[i];
+    for (int64_t first = 0; first < num_sources; first += kMaxBatchSources) {
+        int batch_size = std::min<int64_t>(kMaxBatchSources, num_sources - first);
+        traverse_batch(sources.data() + first, batch_size);
+    }
+}
+
+#endif //GRAPHIT_MULTI_SOURCE_TRAVERSAL_H
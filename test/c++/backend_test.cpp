@@ -821,6 +821,26 @@ TEST_F(BackendTest, SerialMinimumSpanningTreeTest) {
 }
 
 
+TEST_F(BackendTest, BidirectionalDeltaSteppingTest) {
+    istringstream is("element Vertex end\n"
+                     "element Edge end\n"
+                     "const edges : edgeset{Edge}(Vertex,Vertex, int) = load (argv[0]);\n"
+                     "func main() var dist : int = bidirectionalDeltaStepping(edges, 0, 4, 2); print dist; end");
+    EXPECT_EQ (0, basicTest(is));
+}
+
+
+TEST_F(BackendTest, MultiSourceBFSDistanceSumsTest) {
+    istringstream is("element Vertex end\n"
+                     "element Edge end\n"
+                     "const edges : edgeset{Edge}(Vertex,Vertex) = load (argv[0]);\n"
+                     "const sums : vector{Vertex}(int) = 0;\n"
+                     "func main() var sources : vertexset{Vertex} = new vertexset{Vertex}(0); "
+                     "sources.addVertex(0); multiSourceBFSDistanceSums(edges, sources, sums); end");
+    EXPECT_EQ (0, basicTest(is));
+}
+
+
 TEST_F(BackendTest, VectorVertexProperty) {
     istringstream is("element Vertex end\n"
                              "element Edge end\n"
@@ -71,6 +71,35 @@ protected:
                                              "    end\n"
                                              "end");
 
+        // pagerank with the contributions computed by a vertex apply, ahead of a fusible pull edgeset apply
+        const char*  pr_contrib_char = ("element Vertex end\n"
+                                             "element Edge end\n"
+                                             "const edges : edgeset{Edge}(Vertex,Vertex) = load (\"test.el\");\n"
+                                             "const vertices : vertexset{Vertex} = edges.getVertices();\n"
+                                             "const old_rank : vector{Vertex}(float) = 1.0;\n"
+                                             "const new_rank : vector{Vertex}(float) = 0.0;\n"
+                                             "const out_degrees : vector{Vertex}(int) = edges.getOutDegrees();\n"
+                                             "const contrib : vector{Vertex}(float) = 0.0;\n"
+                                             "const damp : float = 0.85;\n"
+                                             "const beta_score : float = (1.0 - damp) / vertices.size();\n"
+                                             "func computeContrib(v : Vertex)\n"
+                                             "    contrib[v] = old_rank[v] / out_degrees[v];\n"
+                                             "end\n"
+                                             "func updateEdge(src : Vertex, dst : Vertex)\n"
+                                             "    new_rank[dst] += contrib[src];\n"
+                                             "end\n"
+                                             "func updateVertex(v : Vertex)\n"
+                                             "    old_rank[v] = beta_score + damp*(new_rank[v]);\n"
+                                             "    new_rank[v] = 0.0;\n"
+                                             "end\n"
+                                             "func main()\n"
+                                             "#l1# for i in 1:10\n"
+                                             "   vertices.apply(computeContrib);\n"
+                                             "   #s1# edges.apply(updateEdge);\n"
+                                             "   #s2# vertices.apply(updateVertex);\n"
+                                             "    end\n"
+                                             "end");
+
         const char*  export_pr_char = ("element Vertex end\n"
                                 "element Edge end\n"
                                 "const edges : edgeset{Edge}(Vertex,Vertex);\n"
@@ -735,6 +764,7 @@ protected:
 
         bfs_str_ =  string (bfs_char);
         pr_str_ = string(pr_char);
+        pr_contrib_str_ = string(pr_contrib_char);
         sssp_str_ = string  (sssp_char);
         sssp_async_str_ = string (sssp_async_char);
         cf_str_ = string  (cf_char);
@@ -813,6 +843,7 @@ protected:
 
     string bfs_str_;
     string pr_str_;
+    string pr_contrib_str_;
     string sssp_str_;
     string sssp_async_str_;
     string cf_str_;
@@ -1098,6 +1129,67 @@ TEST_F(HighLevelScheduleTest, SimpleIntersectionBinary) {
     EXPECT_EQ (0, basicTestWithSchedule(program));
 }
 
+TEST_F(HighLevelScheduleTest, SimpleIntersectionSIMD) {
+    istringstream is(simple_intersection_opt_str_);
+
+    fe_->parseStream(is, context_, errors_);
+
+    fir::high_level_schedule::ProgramScheduleNode::Ptr program
+            = std::make_shared<fir::high_level_schedule::ProgramScheduleNode>(context_);
+
+    program = program->configIntersection("s1", "SIMDIntersection");
+    //generate c++ code successfully
+    EXPECT_EQ (0, basicTestWithSchedule(program));
+}
+
+TEST_F(HighLevelScheduleTest, SimpleIntersectionHubBitmap) {
+    istringstream is(simple_intersection_opt_str_);
+
+    fe_->parseStream(is, context_, errors_);
+
+    fir::high_level_schedule::ProgramScheduleNode::Ptr program
+            = std::make_shared<fir::high_level_schedule::ProgramScheduleNode>(context_);
+
+    program = program->configIntersection("s1", "HubBitmapIntersection")
+            ->configIntersectionHubBitmapBudget("s1", 16)
+            ->configIntersectionCombinedThresholds("s1", 100, 0.5);
+    //generate c++ code successfully
+    EXPECT_EQ (0, basicTestWithSchedule(program));
+}
+
+TEST_F(HighLevelScheduleTest, IntersectionNeighborViews) {
+    istringstream is("element Vertex end\n"
+                             "element Edge end\n"
+                             "const edges : edgeset{Edge}(Vertex,Vertex) = load (\"test.el\");\n"
+                             "const counts : vector{Vertex}(uint) = 0;\n"
+                             "func count(src : Vertex, dst : Vertex)\n"
+                             "    var src_nghs : vertexset{Vertex} = edges.getNgh(src);\n"
+                             "    var dst_nghs : vertexset{Vertex} = edges.getNgh(dst);\n"
+                             "    var kept_nghs : vertexset{Vertex} = edges.getNgh(dst);\n"
+                             "    #s1# counts[src] += intersection(src_nghs, dst_nghs, 0, 0, dst);\n"
+                             "    counts[dst] += intersection(src_nghs, kept_nghs, 0, 0, dst);\n"
+                             "    delete kept_nghs;\n"
+                             "end\n"
+                             "func main()\n"
+                             "    edges.apply(count);\n"
+                             "end");
+
+    fe_->parseStream(is, context_, errors_);
+    fir::high_level_schedule::ProgramScheduleNode::Ptr program
+            = std::make_shared<fir::high_level_schedule::ProgramScheduleNode>(context_);
+    program = program->configIntersection("s1", "HiroshiIntersection");
+    EXPECT_EQ (0, basicTestWithSchedule(program));
+    std::map<std::string, bool> neighbor_views;
+    for (auto stmt : *(mir_context_->getFunction("count")->body->stmts)) {
+        if (mir::isa<mir::VarDecl>(stmt))
+            neighbor_views[mir::to<mir::VarDecl>(stmt)->name] = mir::to<mir::VarDecl>(stmt)->neighbor_view;
+    }
+    EXPECT_TRUE (neighbor_views["src_nghs"]);
+    EXPECT_TRUE (neighbor_views["dst_nghs"]);
+    // also deleted, it stays a vertexset
+    EXPECT_FALSE (neighbor_views["kept_nghs"]);
+}
+
 TEST_F(HighLevelScheduleTest, SimpleIntersectionWithOptional) {
     istringstream is(simple_intersection_opt_str_);
 
@@ -1483,6 +1575,182 @@ TEST_F(HighLevelScheduleTest, PRPushParallel) {
 
 }
 
+TEST_F(HighLevelScheduleTest, PREdgeCentricParallel) {
+    istringstream is (pr_str_);
+    fe_->parseStream(is, context_, errors_);
+    fir::high_level_schedule::ProgramScheduleNode::Ptr program
+            = std::make_shared<fir::high_level_schedule::ProgramScheduleNode>(context_);
+    program->configApplyDirection("l1:s1", "EdgeCentric")->configApplyParallelization("l1:s1", "dynamic-vertex-parallel");
+    //generate c++ code successfully
+    EXPECT_EQ (0, basicTestWithSchedule(program));
+
+    mir::FuncDecl::Ptr main_func_decl = mir_context_->getFunction("main");
+
+    // the edge centric apply is lowered into a push apply streaming the COO edges
+    mir::ForStmt::Ptr for_stmt = mir::to<mir::ForStmt>((*(main_func_decl->body->stmts))[0]);
+    mir::ExprStmt::Ptr expr_stmt = mir::to<mir::ExprStmt>((*(for_stmt->body->stmts))[0]);
+    EXPECT_EQ(true, mir::isa<mir::PushEdgeSetApplyExpr>(expr_stmt->expr));
+    EXPECT_EQ(true, mir::to<mir::PushEdgeSetApplyExpr>(expr_stmt->expr)->use_edge_centric_traversal);
+}
+
+TEST_F(HighLevelScheduleTest, PRPullFusedVertexApply) {
+    istringstream is (pr_contrib_str_);
+    fe_->parseStream(is, context_, errors_);
+    fir::high_level_schedule::ProgramScheduleNode::Ptr program
+            = std::make_shared<fir::high_level_schedule::ProgramScheduleNode>(context_);
+    program->configApplyDirection("l1:s1", "DensePull")->configApplyParallelization("l1:s1", "dynamic-vertex-parallel");
+    EXPECT_EQ (0, basicTestWithSchedule(program));
+
+    mir::FuncDecl::Ptr main_func_decl = mir_context_->getFunction("main");
+    mir::ForStmt::Ptr for_stmt = mir::to<mir::ForStmt>((*(main_func_decl->body->stmts))[0]);
+
+    // updateVertex is called from the pull edgeset apply and its own statement is removed
+    EXPECT_EQ(2, for_stmt->body->stmts->size());
+    mir::ExprStmt::Ptr expr_stmt = mir::to<mir::ExprStmt>((*(for_stmt->body->stmts))[1]);
+    EXPECT_EQ(true, mir::isa<mir::PullEdgeSetApplyExpr>(expr_stmt->expr));
+    EXPECT_EQ("updateVertex", mir::to<mir::PullEdgeSetApplyExpr>(expr_stmt->expr)->fused_vertex_apply_func);
+}
+
+TEST_F(HighLevelScheduleTest, PRPullDisabledVertexApplyFusion) {
+    istringstream is (pr_contrib_str_);
+    fe_->parseStream(is, context_, errors_);
+    fir::high_level_schedule::ProgramScheduleNode::Ptr program
+            = std::make_shared<fir::high_level_schedule::ProgramScheduleNode>(context_);
+    program->configApplyDirection("l1:s1", "DensePull")->configApplyParallelization("l1:s1", "dynamic-vertex-parallel")
+            ->configApplyFusion("l1:s1", "disable_apply_fusion");
+    EXPECT_EQ (0, basicTestWithSchedule(program));
+
+    mir::FuncDecl::Ptr main_func_decl = mir_context_->getFunction("main");
+    mir::ForStmt::Ptr for_stmt = mir::to<mir::ForStmt>((*(main_func_decl->body->stmts))[0]);
+
+    // the schedule turns the fusion off, updateVertex keeps its own statement
+    EXPECT_EQ(3, for_stmt->body->stmts->size());
+    mir::ExprStmt::Ptr expr_stmt = mir::to<mir::ExprStmt>((*(for_stmt->body->stmts))[1]);
+    EXPECT_EQ(true, mir::isa<mir::PullEdgeSetApplyExpr>(expr_stmt->expr));
+    EXPECT_EQ("", mir::to<mir::PullEdgeSetApplyExpr>(expr_stmt->expr)->fused_vertex_apply_func);
+}
+
+TEST_F(HighLevelScheduleTest, PRPullNoFusionOfScheduledVertexApply) {
+    istringstream is (pr_contrib_str_);
+    fe_->parseStream(is, context_, errors_);
+    fir::high_level_schedule::ProgramScheduleNode::Ptr program
+            = std::make_shared<fir::high_level_schedule::ProgramScheduleNode>(context_);
+    program->configApplyDirection("l1:s1", "DensePull")->configApplyParallelization("l1:s1", "dynamic-vertex-parallel")
+            ->configApplyParallelization("l1:s2", "serial");
+    EXPECT_EQ (0, basicTestWithSchedule(program));
+
+    mir::FuncDecl::Ptr main_func_decl = mir_context_->getFunction("main");
+    mir::ForStmt::Ptr for_stmt = mir::to<mir::ForStmt>((*(main_func_decl->body->stmts))[0]);
+
+    // fusing would drop the serial schedule of updateVertex, it keeps its own statement
+    EXPECT_EQ(3, for_stmt->body->stmts->size());
+    mir::ExprStmt::Ptr expr_stmt = mir::to<mir::ExprStmt>((*(for_stmt->body->stmts))[1]);
+    EXPECT_EQ("", mir::to<mir::PullEdgeSetApplyExpr>(expr_stmt->expr)->fused_vertex_apply_func);
+    mir::ExprStmt::Ptr vertex_stmt = mir::to<mir::ExprStmt>((*(for_stmt->body->stmts))[2]);
+    EXPECT_EQ(false, mir::to<mir::VertexSetApplyExpr>(vertex_stmt->expr)->is_parallel);
+}
+
+TEST_F(HighLevelScheduleTest, PRPullNoVertexApplyFusion) {
+    istringstream is (pr_str_);
+    fe_->parseStream(is, context_, errors_);
+    fir::high_level_schedule::ProgramScheduleNode::Ptr program
+            = std::make_shared<fir::high_level_schedule::ProgramScheduleNode>(context_);
+    program->configApplyDirection("l1:s1", "DensePull")->configApplyParallelization("l1:s1", "dynamic-vertex-parallel");
+    EXPECT_EQ (0, basicTestWithSchedule(program));
+
+    mir::FuncDecl::Ptr main_func_decl = mir_context_->getFunction("main");
+    mir::ForStmt::Ptr for_stmt = mir::to<mir::ForStmt>((*(main_func_decl->body->stmts))[0]);
+
+    // updateVertex writes old_rank, which other destinations read through their sources
+    mir::ExprStmt::Ptr expr_stmt = mir::to<mir::ExprStmt>((*(for_stmt->body->stmts))[0]);
+    EXPECT_EQ(true, mir::isa<mir::PullEdgeSetApplyExpr>(expr_stmt->expr));
+    EXPECT_EQ("", mir::to<mir::PullEdgeSetApplyExpr>(expr_stmt->expr)->fused_vertex_apply_func);
+    EXPECT_EQ(true, mir::isa<mir::VertexSetApplyExpr>(
+            mir::to<mir::ExprStmt>((*(for_stmt->body->stmts))[1])->expr));
+}
+
+TEST_F(HighLevelScheduleTest, CFPullNoVertexApplyFusion) {
+    istringstream is (cf_str_);
+    fe_->parseStream(is, context_, errors_);
+    fir::high_level_schedule::ProgramScheduleNode::Ptr program
+            = std::make_shared<fir::high_level_schedule::ProgramScheduleNode>(context_);
+    program->configApplyDirection("s1", "DensePull")->configApplyParallelization("s1", "dynamic-vertex-parallel");
+    EXPECT_EQ (0, basicTestWithSchedule(program));
+
+    mir::FuncDecl::Ptr main_func_decl = mir_context_->getFunction("main");
+    mir::ForStmt::Ptr for_stmt = mir::to<mir::ForStmt>((*(main_func_decl->body->stmts))[1]);
+
+    // updateVertex writes latent_vec, which the edge function reads through the source
+    mir::ExprStmt::Ptr expr_stmt = mir::to<mir::ExprStmt>((*(for_stmt->body->stmts))[0]);
+    EXPECT_EQ(true, mir::isa<mir::PullEdgeSetApplyExpr>(expr_stmt->expr));
+    EXPECT_EQ("", mir::to<mir::PullEdgeSetApplyExpr>(expr_stmt->expr)->fused_vertex_apply_func);
+    EXPECT_EQ(2, for_stmt->body->stmts->size());
+}
+
+TEST_F(HighLevelScheduleTest, CFPullSimdVectorLoops) {
+    istringstream is (cf_str_);
+    fe_->parseStream(is, context_, errors_);
+    fir::high_level_schedule::ProgramScheduleNode::Ptr program
+            = std::make_shared<fir::high_level_schedule::ProgramScheduleNode>(context_);
+    program->configApplyDirection("s1", "DensePull")->configApplyParallelization("s1", "dynamic-vertex-parallel");
+    EXPECT_EQ (0, basicTestWithSchedule(program));
+
+    // the dot product is a sum reduction into estimate, the update of error_vec only touches element i
+    mir::FuncDecl::Ptr update_edge = mir_context_->getFunction("updateEdge");
+    mir::ForStmt::Ptr dot_loop = mir::to<mir::ForStmt>((*(update_edge->body->stmts))[1]);
+    EXPECT_EQ(true, dot_loop->simd_vectorizable);
+    EXPECT_EQ(std::vector<std::string>({"estimate"}), dot_loop->simd_reduction_vars);
+    mir::ForStmt::Ptr axpy_loop = mir::to<mir::ForStmt>((*(update_edge->body->stmts))[3]);
+    EXPECT_EQ(true, axpy_loop->simd_vectorizable);
+    EXPECT_EQ(0, axpy_loop->simd_reduction_vars.size());
+
+    mir::FuncDecl::Ptr update_vertex = mir_context_->getFunction("updateVertex");
+    EXPECT_EQ(true, mir::to<mir::ForStmt>((*(update_vertex->body->stmts))[0])->simd_vectorizable);
+
+    // the outer loop in main applies functions to the edges and vertices
+    mir::FuncDecl::Ptr main_func_decl = mir_context_->getFunction("main");
+    EXPECT_EQ(false, mir::to<mir::ForStmt>((*(main_func_decl->body->stmts))[1])->simd_vectorizable);
+}
+
+TEST_F(HighLevelScheduleTest, NoSimdForDependentIterations) {
+    istringstream is ("element Vertex end\n"
+                      "element Edge end\n"
+                      "const edges : edgeset{Edge}(Vertex,Vertex) = load (argv[1]);\n"
+                      "const vertices : vertexset{Vertex} = edges.getVertices();\n"
+                      "const vec : vector{Vertex}(vector[16](float));\n"
+                      "func shiftVertex (v : Vertex)\n"
+                      "    for i in 1:16\n"
+                      "        vec[v][i] = vec[v][i-1];\n"
+                      "    end\n"
+                      "end\n"
+                      "func scaleVertex (v : Vertex)\n"
+                      "    for i in 0:16\n"
+                      "        vec[v][i] = vec[v][i] * 2;\n"
+                      "    end\n"
+                      "end\n"
+                      "func main()\n"
+                      "    vertices.apply(shiftVertex);\n"
+                      "    vertices.apply(scaleVertex);\n"
+                      "    var sum : float = 0;\n"
+                      "    for i in 0:edges.getVertices()\n"
+                      "        sum += vec[i][0];\n"
+                      "    end\n"
+                      "end");
+    fe_->parseStream(is, context_, errors_);
+    fir::high_level_schedule::ProgramScheduleNode::Ptr program
+            = std::make_shared<fir::high_level_schedule::ProgramScheduleNode>(context_);
+    EXPECT_EQ (0, basicTestWithSchedule(program));
+
+    // each iteration of the shift reads the element written by the previous one
+    mir::FuncDecl::Ptr shift_vertex = mir_context_->getFunction("shiftVertex");
+    EXPECT_EQ(false, mir::to<mir::ForStmt>((*(shift_vertex->body->stmts))[0])->simd_vectorizable);
+    mir::FuncDecl::Ptr scale_vertex = mir_context_->getFunction("scaleVertex");
+    EXPECT_EQ(true, mir::to<mir::ForStmt>((*(scale_vertex->body->stmts))[0])->simd_vectorizable);
+    // the trip count of the sum is only known at runtime
+    mir::FuncDecl::Ptr main_func_decl = mir_context_->getFunction("main");
+    EXPECT_EQ(false, mir::to<mir::ForStmt>((*(main_func_decl->body->stmts))[3])->simd_vectorizable);
+}
+
 
 TEST_F(HighLevelScheduleTest, SimpleHighLevelLoopFusion) {
     istringstream is("func main() "
@@ -1952,6 +2220,152 @@ TEST_F(HighLevelScheduleTest, CFPullParallelLoadBalanceWithGrainSize) {
     EXPECT_EQ (0, basicTestWithSchedule(program));
 }
 
+TEST_F(HighLevelScheduleTest, PRPullDegreeBucketedParallel) {
+    istringstream is (pr_str_);
+    fe_->parseStream(is, context_, errors_);
+    fir::high_level_schedule::ProgramScheduleNode::Ptr program
+            = std::make_shared<fir::high_level_schedule::ProgramScheduleNode>(context_);
+    program->configApplyDirection("l1:s1", "DensePull")
+            ->configApplyParallelization("l1:s1", "degree-bucketed-dynamic-vertex-parallel", 2048);
+    //generate c++ code successfully
+    EXPECT_EQ (0, basicTestWithSchedule(program));
+
+    mir::FuncDecl::Ptr main_func_decl = mir_context_->getFunction("main");
+    mir::ForStmt::Ptr for_stmt = mir::to<mir::ForStmt>((*(main_func_decl->body->stmts))[0]);
+    mir::ExprStmt::Ptr expr_stmt = mir::to<mir::ExprStmt>((*(for_stmt->body->stmts))[0]);
+    EXPECT_EQ(true, mir::isa<mir::PullEdgeSetApplyExpr>(expr_stmt->expr));
+    auto apply_expr = mir::to<mir::PullEdgeSetApplyExpr>(expr_stmt->expr);
+    EXPECT_EQ(true, apply_expr->use_pull_degree_bucketed_load_balance);
+    EXPECT_EQ(2048, apply_expr->pull_edge_based_load_balance_grain_size);
+
+    // the split in edges of a destination sum into a partial that is added to new_rank[dst] afterwards
+    EXPECT_EQ("updateEdge_split_ver", apply_expr->split_apply_func);
+    EXPECT_EQ("new_rank", apply_expr->split_reduce_target);
+    auto split_reduce = mir::to<mir::ReduceStmt>(
+            (*(mir_context_->getFunction("updateEdge_split_ver")->body->stmts))[0]);
+    EXPECT_EQ(true, mir::isa<mir::VarExpr>(split_reduce->lhs));
+    EXPECT_EQ("dst_partial", mir::to<mir::VarExpr>(split_reduce->lhs)->var.getName());
+    EXPECT_EQ(false, split_reduce->is_atomic_);
+}
+
+TEST_F(HighLevelScheduleTest, PullDegreeBucketedAtomicSplitForMin) {
+    istringstream is("element Vertex end\n"
+                             "element Edge end\n"
+                             "const edges : edgeset{Edge}(Vertex,Vertex) = load (\"test.el\");\n"
+                             "const IDs : vector{Vertex}(int) = 0;\n"
+                             "func updateEdge(src : Vertex, dst : Vertex)\n"
+                             "    IDs[dst] min= IDs[src];\n"
+                             "end\n"
+                             "func main()\n"
+                             "    #s1# edges.apply(updateEdge);\n"
+                             "end");
+    fe_->parseStream(is, context_, errors_);
+    fir::high_level_schedule::ProgramScheduleNode::Ptr program
+            = std::make_shared<fir::high_level_schedule::ProgramScheduleNode>(context_);
+    program->configApplyDirection("s1", "DensePull")
+            ->configApplyParallelization("s1", "degree-bucketed-dynamic-vertex-parallel", 2048);
+    //generate c++ code successfully
+    EXPECT_EQ (0, basicTestWithSchedule(program));
+
+    // min can't be summed into partials, the destination is only updated atomically in the split version
+    mir::FuncDecl::Ptr main_func_decl = mir_context_->getFunction("main");
+    mir::ExprStmt::Ptr expr_stmt = mir::to<mir::ExprStmt>((*(main_func_decl->body->stmts))[0]);
+    auto apply_expr = mir::to<mir::PullEdgeSetApplyExpr>(expr_stmt->expr);
+    EXPECT_EQ("updateEdge_split_ver", apply_expr->split_apply_func);
+    EXPECT_EQ("", apply_expr->split_reduce_target);
+    auto pull_reduce = mir::to<mir::ReduceStmt>(
+            (*(mir_context_->getFunction("updateEdge")->body->stmts))[0]);
+    auto split_reduce = mir::to<mir::ReduceStmt>(
+            (*(mir_context_->getFunction("updateEdge_split_ver")->body->stmts))[0]);
+    EXPECT_EQ(false, pull_reduce->is_atomic_);
+    EXPECT_EQ(true, split_reduce->is_atomic_);
+}
+
+TEST_F(HighLevelScheduleTest, CFPullDegreeBucketedNoSplitForVectorUpdates) {
+    istringstream is (cf_str_);
+    fe_->parseStream(is, context_, errors_);
+    fir::high_level_schedule::ProgramScheduleNode::Ptr program
+            = std::make_shared<fir::high_level_schedule::ProgramScheduleNode>(context_);
+    program->configApplyDirection("s1", "DensePull")->setApply("s1", "pull_degree_bucketed_load_balance")
+            ->configApplyParallelization("s1", "dynamic-vertex-parallel");
+    //generate c++ code successfully
+    EXPECT_EQ (0, basicTestWithSchedule(program));
+
+    // the vector property error_vec[dst] can't be updated atomically, high degree vertices are not split
+    mir::FuncDecl::Ptr main_func_decl = mir_context_->getFunction("main");
+    mir::ForStmt::Ptr for_stmt = mir::to<mir::ForStmt>((*(main_func_decl->body->stmts))[1]);
+    mir::ExprStmt::Ptr expr_stmt = mir::to<mir::ExprStmt>((*(for_stmt->body->stmts))[0]);
+    auto apply_expr = mir::to<mir::PullEdgeSetApplyExpr>(expr_stmt->expr);
+    EXPECT_EQ(true, apply_expr->use_pull_degree_bucketed_load_balance);
+    EXPECT_EQ("", apply_expr->split_apply_func);
+}
+
+TEST_F(HighLevelScheduleTest, TCPushDegreeBucketedSplitOutEdges) {
+    istringstream is("element Vertex end\n"
+                             "element Edge end\n"
+                             "const edges : edgeset{Edge}(Vertex,Vertex) = load (\"test.el\");\n"
+                             "const vertexArray : vector{Vertex}(uint) = 0;\n"
+                             "func count(src : Vertex, dst : Vertex)\n"
+                             "    var src_nghs : vertexset{Vertex} = edges.getNgh(src);\n"
+                             "    var dst_nghs : vertexset{Vertex} = edges.getNgh(dst);\n"
+                             "    if dst < src\n"
+                             "        vertexArray[src] += intersection(src_nghs, dst_nghs, 0, 0, dst);\n"
+                             "    end\n"
+                             "end\n"
+                             "func main()\n"
+                             "    #s1# edges.apply(count);\n"
+                             "end");
+    fe_->parseStream(is, context_, errors_);
+    fir::high_level_schedule::ProgramScheduleNode::Ptr program
+            = std::make_shared<fir::high_level_schedule::ProgramScheduleNode>(context_);
+    program->configApplyDirection("s1", "SparsePush")
+            ->configApplyParallelization("s1", "degree-bucketed-dynamic-vertex-parallel", 2);
+    //generate c++ code successfully
+    EXPECT_EQ (0, basicTestWithSchedule(program));
+
+    mir::FuncDecl::Ptr main_func_decl = mir_context_->getFunction("main");
+    mir::ExprStmt::Ptr expr_stmt = mir::to<mir::ExprStmt>((*(main_func_decl->body->stmts))[0]);
+    EXPECT_EQ(true, mir::isa<mir::PushEdgeSetApplyExpr>(expr_stmt->expr));
+    auto apply_expr = mir::to<mir::PushEdgeSetApplyExpr>(expr_stmt->expr);
+    EXPECT_EQ(true, apply_expr->use_push_degree_bucketed_load_balance);
+    EXPECT_EQ(false, apply_expr->use_pull_degree_bucketed_load_balance);
+    EXPECT_EQ(2, apply_expr->pull_edge_based_load_balance_grain_size);
+
+    // the split out edges of a source sum into a partial that is added to vertexArray[src] afterwards
+    EXPECT_EQ("count_split_ver", apply_expr->split_apply_func);
+    EXPECT_EQ("vertexArray", apply_expr->split_reduce_target);
+    EXPECT_EQ("src_partial", mir_context_->split_partial_args["count_split_ver"].getName());
+}
+
+TEST_F(HighLevelScheduleTest, PRPushDegreeBucketedNoSplitForDstUpdates) {
+    istringstream is (pr_str_);
+    fe_->parseStream(is, context_, errors_);
+    fir::high_level_schedule::ProgramScheduleNode::Ptr program
+            = std::make_shared<fir::high_level_schedule::ProgramScheduleNode>(context_);
+    program->configApplyDirection("l1:s1", "SparsePush")
+            ->configApplyParallelization("l1:s1", "degree-bucketed-dynamic-vertex-parallel", 2048);
+    //generate c++ code successfully
+    EXPECT_EQ (0, basicTestWithSchedule(program));
+
+    // new_rank[dst] is not a reduction on the source, high degree sources are not split
+    mir::FuncDecl::Ptr main_func_decl = mir_context_->getFunction("main");
+    mir::ForStmt::Ptr for_stmt = mir::to<mir::ForStmt>((*(main_func_decl->body->stmts))[0]);
+    mir::ExprStmt::Ptr expr_stmt = mir::to<mir::ExprStmt>((*(for_stmt->body->stmts))[0]);
+    auto apply_expr = mir::to<mir::PushEdgeSetApplyExpr>(expr_stmt->expr);
+    EXPECT_EQ(true, apply_expr->use_push_degree_bucketed_load_balance);
+    EXPECT_EQ("", apply_expr->split_apply_func);
+}
+
+TEST_F(HighLevelScheduleTest, CFEdgeCentricParallel) {
+    istringstream is (cf_str_);
+    fe_->parseStream(is, context_, errors_);
+    fir::high_level_schedule::ProgramScheduleNode::Ptr program
+            = std::make_shared<fir::high_level_schedule::ProgramScheduleNode>(context_);
+    program->configApplyDirection("s1", "EdgeCentric")->configApplyParallelization("s1", "dynamic-vertex-parallel");
+    //generate c++ code successfully
+    EXPECT_EQ (0, basicTestWithSchedule(program));
+}
+
 
 TEST_F(HighLevelScheduleTest, PageRankDeltaPullParallel) {
     istringstream is (prd_str_);
@@ -2182,6 +2596,105 @@ TEST_F(HighLevelScheduleTest, DeltaSteppingWithEagerPriorityUpdateWithMergeArgv)
     EXPECT_EQ (0, basicTestWithSchedule(program));
 }
 
+TEST_F(HighLevelScheduleTest, DeltaSteppingWithEagerPriorityUpdateAutoDelta) {
+    istringstream is (delta_stepping_str_);
+    fe_->parseStream(is, context_, errors_);
+    fir::high_level_schedule::ProgramScheduleNode::Ptr program
+            = std::make_shared<fir::high_level_schedule::ProgramScheduleNode>(context_);
+    program->configApplyPriorityUpdate("s1", "eager_priority_update");
+    program->configApplyPriorityUpdateDelta("s1", "auto");
+    EXPECT_EQ (0, basicTestWithSchedule(program));
+    EXPECT_EQ (0, mir_context_->delta_);
+}
+
+TEST_F(HighLevelScheduleTest, DeltaSteppingWithEagerPriorityUpdateSourceFilter) {
+    istringstream is ("element Vertex end\n"
+                      "element Edge end\n"
+                      "const edges : edgeset{Edge}(Vertex,Vertex, int) = load (\"argv[1]\");\n"
+                      "const vertices : vertexset{Vertex} = edges.getVertices();\n"
+                      "const dist : vector{Vertex}(int) = 2147483647; %should be INT_MAX\n"
+                      "const pq: priority_queue{Vertex}(int);"
+                      "func updateEdge(src : Vertex, dst : Vertex, weight : int) \n"
+                      "  var new_dist : int = dist[src] + weight; "
+                      "  pq.updatePriorityMin(dst, dist[dst], new_dist); "
+                      "end\n"
+                      "func isReached(v : Vertex) -> output : bool "
+                      "  output = dist[v] != 2147483647; "
+                      "end\n"
+                      "func main() "
+                      "  var start_vertex : int = atoi(argv[2]);"
+                      " dist[start_vertex] = 0;"
+                      "  pq = new priority_queue{Vertex}(int)(false, false, dist, 1, 2, false, start_vertex);"
+                      "  while (pq.finished() == false) "
+                      "    var frontier : vertexset{Vertex} = pq.dequeue_ready_set(); % dequeue_ready_set() \n"
+                      "    #s1# edges.from(frontier).applyUpdatePriority(updateEdge);  \n"
+                      "    delete frontier; "
+                      "  end\n"
+                      "end");
+    fe_->parseStream(is, context_, errors_);
+    fir::high_level_schedule::ProgramScheduleNode::Ptr program
+            = std::make_shared<fir::high_level_schedule::ProgramScheduleNode>(context_);
+    program->configApplyPriorityUpdate("s1", "eager_priority_update");
+    program->configApplySourceFilter("s1", "isReached");
+
+    graphit::Midend *me = new graphit::Midend(context_, program->getSchedule());
+    me->emitMIR(mir_context_);
+    graphit::Backend *be = new graphit::Backend(mir_context_);
+    std::ostringstream generated;
+    EXPECT_EQ (0, be->emitCPP(generated));
+    // the filter is passed to the operator in place of the default lambda
+    EXPECT_NE (std::string::npos, generated.str().find("updateEdge(), isReached(), "));
+    EXPECT_EQ (std::string::npos, generated.str().find("->get_current_priority();}"));
+}
+
+TEST_F(HighLevelScheduleTest, DeltaSteppingWithSparsePushAutoDelta) {
+    istringstream is (delta_stepping_str_);
+    fe_->parseStream(is, context_, errors_);
+    fir::high_level_schedule::ProgramScheduleNode::Ptr program
+            = std::make_shared<fir::high_level_schedule::ProgramScheduleNode>(context_);
+    program->configApplyDirection("s1", "SparsePush");
+    program->configApplyPriorityUpdateDelta("s1", "auto");
+    EXPECT_EQ (0, basicTestWithSchedule(program));
+    EXPECT_EQ (0, mir_context_->delta_);
+}
+
+TEST_F(HighLevelScheduleTest, DeltaSteppingWithRelaxedMultiQueue) {
+    istringstream is (delta_stepping_str_);
+    fe_->parseStream(is, context_, errors_);
+    fir::high_level_schedule::ProgramScheduleNode::Ptr program
+            = std::make_shared<fir::high_level_schedule::ProgramScheduleNode>(context_);
+    program->configApplyPriorityUpdate("s1", "relaxed_multiqueue");
+    program->configApplyPriorityUpdateDelta("s1", 2);
+    program->configRelaxationFactor("s1", 4);
+    EXPECT_EQ (0, basicTestWithSchedule(program));
+    EXPECT_EQ (mir::PriorityUpdateType::RelaxedMultiQueuePriorityUpdate, mir_context_->priority_update_type);
+    EXPECT_EQ (4, mir_context_->relaxation_factor_);
+}
+
+TEST_F(HighLevelScheduleTest, PPSPDeltaSteppingWithRelaxedMultiQueueArgv) {
+    istringstream is (ppsp_str_);
+    fe_->parseStream(is, context_, errors_);
+    fir::high_level_schedule::ProgramScheduleNode::Ptr program
+            = std::make_shared<fir::high_level_schedule::ProgramScheduleNode>(context_);
+    program->configApplyPriorityUpdate("s1", "relaxed_multiqueue");
+    program->configApplyPriorityUpdateDelta("s1", 2);
+    program->configRelaxationFactor("s1", "argv[4]");
+    EXPECT_EQ (0, basicTestWithSchedule(program));
+    EXPECT_EQ (-4, mir_context_->relaxation_factor_);
+}
+
+TEST_F(HighLevelScheduleTest, DeltaSteppingWithSparsePushRadixHeapBuckets) {
+    istringstream is (delta_stepping_str_);
+    fe_->parseStream(is, context_, errors_);
+    fir::high_level_schedule::ProgramScheduleNode::Ptr program
+            = std::make_shared<fir::high_level_schedule::ProgramScheduleNode>(context_);
+    program->configApplyDirection("s1", "SparsePush");
+    program->configApplyPriorityUpdateDelta("s1", 2);
+    program->configBucketBackend("s1", "radix_heap_buckets");
+    EXPECT_EQ (0, basicTestWithSchedule(program));
+    EXPECT_EQ (mir::BucketBackendType::RadixHeapBuckets, mir_context_->bucket_backend_type);
+}
+
 TEST_F(HighLevelScheduleTest, PPSPDeltaSteppingWithDefaultSchedule) {
     istringstream is (ppsp_str_);
     fe_->parseStream(is, context_, errors_);
@@ -2309,6 +2822,29 @@ TEST_F(HighLevelScheduleTest, KCoreSumReduceBeforeUpdate){
 }
 
 
+TEST_F(HighLevelScheduleTest, KCoreSumReduceBeforeUpdateTwoLevelBuckets){
+    istringstream is (kcore_str_);
+    fe_->parseStream(is, context_, errors_);
+    fir::high_level_schedule::ProgramScheduleNode::Ptr program
+            = std::make_shared<fir::high_level_schedule::ProgramScheduleNode>(context_);
+    program->configApplyPriorityUpdate("s1", "constant_sum_reduce_before_update");
+    program->configBucketBackend("s1", "two_level_buckets");
+    EXPECT_EQ (0, basicTestWithSchedule(program));
+    EXPECT_EQ (mir::BucketBackendType::TwoLevelBuckets, mir_context_->bucket_backend_type);
+}
+
+// the whole while loop becomes one operator on the GAPBS graph, the frontier is counted by the operator
+TEST_F(HighLevelScheduleTest, KCoreEagerSumReduceBeforeUpdate){
+    istringstream is (kcore_str_);
+    fe_->parseStream(is, context_, errors_);
+    fir::high_level_schedule::ProgramScheduleNode::Ptr program
+            = std::make_shared<fir::high_level_schedule::ProgramScheduleNode>(context_);
+    program->configApplyPriorityUpdate("s1", "eager_constant_sum_reduce_before_update");
+    EXPECT_EQ (0, basicTestWithSchedule(program));
+    EXPECT_EQ (mir::PriorityUpdateType::EagerConstSumReduceBeforePriorityUpdate, mir_context_->priority_update_type);
+    EXPECT_EQ (1000, mir_context_->bucket_merge_threshold_);
+}
+
 TEST_F(HighLevelScheduleTest, KCoreSparsePushSerial){
     istringstream is (kcore_str_);
     fe_->parseStream(is, context_, errors_);
@@ -2385,3 +2921,59 @@ EXPECT_EQ (0, basicTestWithSchedule(program));
 }
 
 
+
+TEST_F(HighLevelScheduleTest, RepeatedBFSSparseReset) {
+    istringstream is("element Vertex end\n"
+                             "element Edge end\n"
+                             "const edges : edgeset{Edge}(Vertex,Vertex) = load (\"test.el\");\n"
+                             "const vertices : vertexset{Vertex} = edges.getVertices();\n"
+                             "const parent : vector{Vertex}(int) = -1;\n"
+                             "func toFilter(v : Vertex) -> output : bool output = parent[v] == -1; end\n"
+                             "func updateEdge(src : Vertex, dst : Vertex) parent[dst] = src; end\n"
+                             "func resetParent(v : Vertex) parent[v] = -1; end\n"
+                             "func main()\n"
+                             "    for s in 0:10\n"
+                             "        #s2# vertices.apply(resetParent);\n"
+                             "        var frontier : vertexset{Vertex} = new vertexset{Vertex}(0);\n"
+                             "        frontier.addVertex(s);\n"
+                             "        parent[s] = s;\n"
+                             "        while (frontier.getVertexSetSize() != 0)\n"
+                             "            #s1# var output : vertexset{Vertex} = edges.from(frontier).to(toFilter).applyModified(updateEdge, parent, true);\n"
+                             "            delete frontier;\n"
+                             "            frontier = output;\n"
+                             "        end\n"
+                             "        delete frontier;\n"
+                             "    end\n"
+                             "end");
+
+    fe_->parseStream(is, context_, errors_);
+    fir::high_level_schedule::ProgramScheduleNode::Ptr program
+            = std::make_shared<fir::high_level_schedule::ProgramScheduleNode>(context_);
+    program->configApplyDirection("s1", "SparsePush-DensePull");
+    program->configApplySparseReset("s2", 0.1);
+    EXPECT_EQ (0, basicTestWithSchedule(program));
+    EXPECT_EQ (1, mir_context_->touched_vertices_sets.size());
+    EXPECT_FLOAT_EQ (0.1, mir_context_->touched_vertices_sets[0]->dense_fraction);
+}
+
+TEST_F(HighLevelScheduleTest, SparseResetFallsBackForWholeVectorWrites) {
+    istringstream is("element Vertex end\n"
+                             "element Edge end\n"
+                             "const edges : edgeset{Edge}(Vertex,Vertex) = load (\"test.el\");\n"
+                             "const vertices : vertexset{Vertex} = edges.getVertices();\n"
+                             "const parent : vector{Vertex}(int) = -1;\n"
+                             "const other_parent : vector{Vertex}(int) = -1;\n"
+                             "func resetParent(v : Vertex) parent[v] = -1; end\n"
+                             "func main()\n"
+                             "    #s2# vertices.apply(resetParent);\n"
+                             "    parent = other_parent;\n"
+                             "end");
+
+    fe_->parseStream(is, context_, errors_);
+    fir::high_level_schedule::ProgramScheduleNode::Ptr program
+            = std::make_shared<fir::high_level_schedule::ProgramScheduleNode>(context_);
+    program->configApplySparseReset("s2");
+    EXPECT_EQ (0, basicTestWithSchedule(program));
+    // the vector can change without naming the vertices, every vertex is reset
+    EXPECT_EQ (0, mir_context_->touched_vertices_sets.size());
+}
@@ -146,6 +146,46 @@ TEST_F(RuntimeLibTest, serialMSTTest2) {
     EXPECT_EQ (3 , parent_vector[4]);
 }
 
+TEST_F(RuntimeLibTest, parallelMSFTest) {
+    WGraph wg = builtin_loadWeightedEdgesFromFile("../../test/graphs/mst_special_case.wel");
+    for (MSFAlgorithm algorithm : {MSFAlgorithm::Boruvka, MSFAlgorithm::FilterKruskal}) {
+        NodeID* parent_vector = minimum_spanning_forest(wg, 1, algorithm);
+        EXPECT_EQ (1 , parent_vector[1]);
+        EXPECT_EQ (1 , parent_vector[2]);
+        EXPECT_EQ (2 , parent_vector[3]);
+        EXPECT_EQ (3 , parent_vector[4]);
+        EXPECT_EQ (4 , parent_vector[5]);
+        // vertex 0 has no edges, it is a tree of its own
+        EXPECT_EQ (0 , parent_vector[0]);
+        delete[] parent_vector;
+    }
+}
+
+// the edges are undirected, unlike the out edge walk of the serial version (see serialMSTTest2)
+TEST_F(RuntimeLibTest, parallelMSFTest2) {
+    WGraph wg = builtin_loadWeightedEdgesFromFile("../../test/graphs/test2.wel");
+    NodeID* parent_vector = minimum_spanning_forest(wg, 3);
+    EXPECT_EQ (3 , parent_vector[3]);
+    EXPECT_EQ (3 , parent_vector[4]);
+    EXPECT_EQ (4 , parent_vector[2]);
+    EXPECT_EQ (2 , parent_vector[1]);
+    EXPECT_EQ (2 , parent_vector[5]);
+    EXPECT_EQ (5 , parent_vector[6]);
+    delete[] parent_vector;
+}
+
+// both algorithms break ties by edge position, so they find the same forest
+TEST_F(RuntimeLibTest, parallelMSFAlgorithmsAgreeTest) {
+    WGraph wg = builtin_loadWeightedEdgesFromFile("../../test/graphs/monaco.bin");
+    NodeID* boruvka = minimum_spanning_forest(wg, 0, MSFAlgorithm::Boruvka);
+    NodeID* kruskal = minimum_spanning_forest(wg, 0, MSFAlgorithm::FilterKruskal);
+    for (NodeID v = 0; v < wg.num_nodes(); v++) {
+        EXPECT_EQ (boruvka[v], kruskal[v]);
+    }
+    delete[] boruvka;
+    delete[] kruskal;
+}
+
 TEST_F(RuntimeLibTest, SimpleLoadVerticesromEdges) {
     Graph g = builtin_loadEdgesFromFile("../../test/graphs/test.el");
     int num_vertices = builtin_getVertices(g);
@@ -161,6 +201,23 @@ TEST_F(RuntimeLibTest, GetOutDegrees) {
     //EXPECT_EQ (5 , out_degrees.size());
 }
 
+TEST_F(RuntimeLibTest, EdgeGridCOOTest) {
+    Graph g = builtin_loadEdgesFromFile("../../test/graphs/test.el");
+    g.SetUpEdgeGrid();
+    auto grid = g.get_edge_grid_();
+    EXPECT_EQ (g.num_edges_directed(), grid->numEdges);
+    EXPECT_EQ (grid->numEdges, grid->cellOffsets[grid->num_cells()]);
+    // every CSR edge shows up exactly once in the COO array
+    std::map<std::pair<NodeID, NodeID>, int> csr_edges;
+    for (NodeID s = 0; s < g.num_nodes(); s++)
+        for (NodeID d : g.out_neigh(s))
+            csr_edges[std::make_pair(s, d)]++;
+    for (int64_t e = 0; e < grid->numEdges; e++)
+        csr_edges[std::make_pair(grid->srcArray[e], grid->dstArray[e])]--;
+    for (auto edge : csr_edges)
+        EXPECT_EQ (0, edge.second);
+}
+
 TEST_F(RuntimeLibTest, TimerTest) {
 //    float start_time = getTime();
 //    sleep(1);
@@ -203,6 +260,42 @@ TEST_F(RuntimeLibTest, VertexSubsetSimpleTest) {
 
 }
 
+TEST_F(RuntimeLibTest, VertexSetFilterTest) {
+    // spans several blocks of the blocked predicate evaluation
+    int num_vertices = 10000;
+    auto is_multiple_of_three = [] (int v) -> bool { return v % 3 == 0; };
+    auto is_even = [] (int v) -> bool { return v % 2 == 0; };
+
+    VertexSubset<int> * dense_out = builtin_const_vertexset_filter(is_multiple_of_three, num_vertices);
+    EXPECT_EQ(true, dense_out->is_dense);
+    EXPECT_EQ(3334, builtin_getVertexSetSize(dense_out));
+    dense_out->toSparse();
+    for (int i = 0; i < dense_out->num_vertices_; i++)
+        EXPECT_EQ(3 * i, dense_out->dense_vertex_set_[i]);
+
+    // dense input
+    VertexSubset<int> * dense_filtered = builtin_vertexset_filter(dense_out, is_even);
+    EXPECT_EQ(1667, builtin_getVertexSetSize(dense_filtered));
+
+    // sparse input built with addVertex, the output stays sparse and keeps the input order
+    auto sparse_in = new VertexSubset<int>(num_vertices, 0);
+    for (int v = num_vertices - 1; v >= 0; v -= 5)
+        sparse_in->addVertex(v);
+    VertexSubset<int> * sparse_out = builtin_vertexset_filter(sparse_in, is_even);
+    EXPECT_EQ(false, sparse_out->is_dense);
+    EXPECT_EQ(1000, builtin_getVertexSetSize(sparse_out));
+    EXPECT_EQ(9994, sparse_out->dense_vertex_set_[0]);
+    EXPECT_EQ(4, sparse_out->dense_vertex_set_[999]);
+    sparse_out->toDense();
+    EXPECT_EQ(true, sparse_out->contains(9984));
+    EXPECT_EQ(false, sparse_out->contains(9989));
+
+    delete dense_out;
+    delete dense_filtered;
+    delete sparse_in;
+    delete sparse_out;
+}
+
 //test init of the eager priority queue based on GAPBS
 TEST_F(RuntimeLibTest, EagerPriorityQueueInit) {
 
@@ -243,7 +336,7 @@ TEST_F(RuntimeLibTest, SSSPOrderProcessingWithMergeTest){
     };
 
 
-    auto edge_update_func = [&](vector<vector<NodeID> >& local_bins, NodeID src, NodeID dst, WeightT wt) {
+    auto edge_update_func = [&](ThreadLocalBins& local_bins, NodeID src, NodeID dst, WeightT wt) {
         WeightT old_dist = dist_array[dst];
         WeightT new_dist = dist_array[src] + wt;
         updatePriorityMin<WeightT>()(&pq, local_bins, dst, old_dist, new_dist);
@@ -260,6 +353,57 @@ TEST_F(RuntimeLibTest, SSSPOrderProcessingWithMergeTest){
 }
 
 
+// only two bins are open in each thread, so most of the nodes go through the overflow bin
+TEST_F(RuntimeLibTest, SSSPOrderProcessingSmallBinWindowTest){
+
+    WGraph g = builtin_loadWeightedEdgesFromFile("../../test/graphs/4.wel");
+    WeightT* dist_array = new WeightT[g.num_nodes()];
+    for (int i = 0; i < g.num_nodes(); i++){
+        dist_array[i] = kDistInf;
+    }
+
+    NodeID source = 0;
+    dist_array[source] = 0;
+    EagerPriorityQueue<WeightT> pq = EagerPriorityQueue<WeightT>(dist_array, 1, false, 2);
+
+    auto while_cond_func = [&]()->bool{
+        return !pq.finished();
+    };
+
+    auto edge_update_func = [&](ThreadLocalBins& local_bins, NodeID src, NodeID dst, WeightT wt) {
+        WeightT old_dist = dist_array[dst];
+        WeightT new_dist = dist_array[src] + wt;
+        updatePriorityMin<WeightT>()(&pq, local_bins, dst, old_dist, new_dist);
+    };
+
+    OrderedProcessingOperatorNoMerge(&pq, g,  while_cond_func, edge_update_func,  source);
+
+    pvector<WeightT> dist = pvector<WeightT>(g.num_nodes());
+    for (int i = 0; i < g.num_nodes(); i++){
+        dist[i]= dist_array[i];
+    }
+
+    EXPECT_EQ(SSSPVerifier(g, source, dist), true);
+}
+
+TEST_F(RuntimeLibTest, ThreadLocalBinsOverflowTest){
+    WeightT priorities[4] = {0, 1, 5, 9};
+    EagerPriorityQueue<WeightT> pq = EagerPriorityQueue<WeightT>(priorities);
+    ThreadLocalBins local_bins(2);
+    local_bins.push(1, 1);
+    local_bins.push(5, 2);
+    local_bins.push(9, 3);
+    EXPECT_EQ(1, local_bins.next_bin());
+    local_bins.bin(1).resize(0);
+    EXPECT_EQ(5, local_bins.next_bin());
+    // node 3 got a better priority after it went to the overflow bin
+    priorities[3] = 6;
+    local_bins.advance(5, &pq);
+    EXPECT_EQ(5, local_bins.next_bin());
+    EXPECT_EQ(1, local_bins.bin(5).size());
+    EXPECT_EQ(1, local_bins.bin(6).size());
+}
+
 // test compilation of the C++ version of SSSP using eager priority queue
 TEST_F(RuntimeLibTest, SSSPOrderProcessingNoMergeTest){
 
@@ -279,7 +423,7 @@ TEST_F(RuntimeLibTest, SSSPOrderProcessingNoMergeTest){
     };
 
 
-    auto edge_update_func = [&](vector<vector<NodeID> >& local_bins, NodeID src, NodeID dst, WeightT wt) {
+    auto edge_update_func = [&](ThreadLocalBins& local_bins, NodeID src, NodeID dst, WeightT wt) {
         WeightT old_dist = dist_array[dst];
         WeightT new_dist = dist_array[src] + wt;
         updatePriorityMin<WeightT>()(&pq, local_bins, dst, old_dist, new_dist);
@@ -295,6 +439,135 @@ TEST_F(RuntimeLibTest, SSSPOrderProcessingNoMergeTest){
     EXPECT_EQ(SSSPVerifier(g, source, dist), true);
 }
 
+// unweighted graph, user supplied source filter and no source node (all the nodes with a priority start)
+TEST_F(RuntimeLibTest, MultiSourceBFSOrderProcessingUnweightedTest){
+
+    Graph g = builtin_loadEdgesFromFile("../../test/graphs/rmat10.el");
+    const int kUnreached = std::numeric_limits<int>::max();
+    int* dist_array = new int[g.num_nodes()];
+    for (int i = 0; i < g.num_nodes(); i++){
+        dist_array[i] = kUnreached;
+    }
+    dist_array[0] = 0;
+    dist_array[5] = 0;
+    EagerPriorityQueue<int> pq = EagerPriorityQueue<int>(dist_array, 1, false, 4);
+
+    auto edge_update_func = [&](ThreadLocalBins& local_bins, NodeID src, NodeID dst) {
+        updatePriorityMin<int>()(&pq, local_bins, dst, dist_array[dst], dist_array[src] + 1);
+    };
+    auto src_filter = [&](NodeID u)->bool{
+        return (size_t) dist_array[u] == pq.get_current_priority();
+    };
+
+    OrderedProcessingOperatorNoMerge(&pq, g, [&]()->bool{ return !pq.finished(); }, edge_update_func, src_filter, -1);
+
+    // level synchronous BFS from both sources
+    vector<int> expected(g.num_nodes(), kUnreached);
+    vector<NodeID> queue = {0, 5};
+    expected[0] = 0;
+    expected[5] = 0;
+    for (size_t i = 0; i < queue.size(); i++) {
+        NodeID u = queue[i];
+        for (NodeID v : g.out_neigh(u)) {
+            if (expected[v] == kUnreached) {
+                expected[v] = expected[u] + 1;
+                queue.push_back(v);
+            }
+        }
+    }
+    for (int i = 0; i < g.num_nodes(); i++){
+        EXPECT_EQ(expected[i], dist_array[i]);
+    }
+    delete[] dist_array;
+}
+
+// nodes initialized with the infinity of the queue are not in the first frontier
+TEST_F(RuntimeLibTest, SeedFrontierSkipsDistInfTest){
+
+    Graph g = builtin_loadEdgesFromFile("../../test/graphs/rmat10.el");
+    const int kDistInf = std::numeric_limits<int>::max()/2;
+    int* dist_array = new int[g.num_nodes()];
+    for (int i = 0; i < g.num_nodes(); i++){
+        dist_array[i] = kDistInf;
+    }
+    dist_array[0] = 0;
+    EagerPriorityQueue<int> pq = EagerPriorityQueue<int>(dist_array, 1, false, 4);
+    EXPECT_EQ(kDistInf, pq.kDistInf);
+
+    auto edge_update_func = [&](ThreadLocalBins& local_bins, NodeID src, NodeID dst) {
+        updatePriorityMin<int>()(&pq, local_bins, dst, dist_array[dst], dist_array[src] + 1);
+    };
+    std::atomic<int> num_processed_at_inf(0);
+    auto src_filter = [&](NodeID u)->bool{
+        if (dist_array[u] >= kDistInf)
+            num_processed_at_inf++;
+        return (size_t) dist_array[u] == pq.get_current_priority();
+    };
+
+    OrderedProcessingOperatorNoMerge(&pq, g, [&]()->bool{ return !pq.finished(); }, edge_update_func, src_filter, -1);
+
+    EXPECT_EQ(0, num_processed_at_inf.load());
+    EXPECT_EQ(0, dist_array[0]);
+    for (NodeID v : g.out_neigh(0)){
+        if (v != 0) {
+            EXPECT_EQ(1, dist_array[v]);
+        }
+    }
+    delete[] dist_array;
+}
+
+// relaxed multiqueue without a source node, the nodes with a priority below kDistInf start and the others
+// are only processed once they are reached
+TEST_F(RuntimeLibTest, RelaxedMultiQueueSkipsDistInfTest){
+
+    Graph g = builtin_loadEdgesFromFile("../../test/graphs/rmat10.el");
+    const int kDistInf = std::numeric_limits<int>::max()/2;
+    int* dist_array = new int[g.num_nodes()];
+    for (int i = 0; i < g.num_nodes(); i++){
+        dist_array[i] = kDistInf;
+    }
+    dist_array[0] = 0;
+    dist_array[5] = 0;
+    EagerPriorityQueue<int> pq = EagerPriorityQueue<int>(dist_array, 1, false, 4);
+
+    auto edge_update_func = [&](auto& local_bins, NodeID src, NodeID dst) {
+        updatePriorityMin<int>()(&pq, local_bins, dst, dist_array[dst], dist_array[src] + 1);
+    };
+    std::atomic<int> num_processed_at_inf(0);
+    auto src_filter = [&](NodeID u)->bool{
+        if (dist_array[u] >= kDistInf)
+            num_processed_at_inf++;
+        return (size_t) dist_array[u] == pq.get_current_priority();
+    };
+
+    OrderedProcessingOperatorRelaxedMultiQueue(&pq, g, [&]()->bool{ return !pq.finished(); }, edge_update_func,
+                                               src_filter, 2, -1);
+
+    EXPECT_EQ(0, num_processed_at_inf.load());
+    // level synchronous BFS from both sources
+    vector<int> expected(g.num_nodes(), kDistInf);
+    vector<NodeID> queue = {0, 5};
+    expected[0] = 0;
+    expected[5] = 0;
+    for (size_t i = 0; i < queue.size(); i++) {
+        NodeID u = queue[i];
+        for (NodeID v : g.out_neigh(u)) {
+            if (expected[v] == kDistInf) {
+                expected[v] = expected[u] + 1;
+                queue.push_back(v);
+            }
+        }
+    }
+    int num_unreached = 0;
+    for (int i = 0; i < g.num_nodes(); i++){
+        EXPECT_EQ(expected[i], dist_array[i]);
+        if (expected[i] == kDistInf)
+            num_unreached++;
+    }
+    EXPECT_LT(0, num_unreached);
+    delete[] dist_array;
+}
+
 // test compilation of the C++ version of PPSP using eager priority queue
 TEST_F(RuntimeLibTest, PPSPOrderProcessingNoMergeTest){
 
@@ -316,7 +589,7 @@ TEST_F(RuntimeLibTest, PPSPOrderProcessingNoMergeTest){
     };
 
 
-    auto edge_update_func = [&](vector<vector<NodeID> >& local_bins, NodeID src, NodeID dst, WeightT wt) {
+    auto edge_update_func = [&](ThreadLocalBins& local_bins, NodeID src, NodeID dst, WeightT wt) {
         WeightT old_dist = dist_array[dst];
         WeightT new_dist = dist_array[src] + wt;
         updatePriorityMin<WeightT>()(&pq, local_bins, dst, old_dist, new_dist);
@@ -356,7 +629,7 @@ TEST_F(RuntimeLibTest, PPSPOrderProcessingWithMergeTest){
     };
 
 
-    auto edge_update_func = [&](vector<vector<NodeID> >& local_bins, NodeID src, NodeID dst, WeightT wt) {
+    auto edge_update_func = [&](ThreadLocalBins& local_bins, NodeID src, NodeID dst, WeightT wt) {
         WeightT old_dist = dist_array[dst];
         WeightT new_dist = dist_array[src] + wt;
         updatePriorityMin<WeightT>()(&pq, local_bins, dst, old_dist, new_dist);
@@ -374,6 +647,188 @@ TEST_F(RuntimeLibTest, PPSPOrderProcessingWithMergeTest){
     EXPECT_EQ(PPSPVerifier(g, source, dest, dist), true);
 }
 
+// every pair of the directed test graphs, the backward search has to follow the in edges
+TEST_F(RuntimeLibTest, BidirectionalDeltaSteppingAllPairsTest){
+    const char* graphs[] = {"../../test/graphs/test.wel", "../../test/graphs/4.wel"};
+    for (const char* file_name : graphs) {
+        WGraph g = builtin_loadWeightedEdgesFromFile(file_name);
+        for (WeightT delta : {0, 1, 3}) {
+            for (NodeID source = 0; source < g.num_nodes(); source++) {
+                for (NodeID dest = 0; dest < g.num_nodes(); dest++) {
+                    pvector<WeightT> dist(g.num_nodes(), kDistInf);
+                    WeightT d = BidirectionalDeltaStepping(g, source, dest, delta);
+                    dist[dest] = (d == std::numeric_limits<WeightT>::max()) ? kDistInf : d;
+                    EXPECT_EQ(PPSPVerifier(g, source, dest, dist), true);
+                }
+            }
+        }
+    }
+}
+
+
+// more sources than fit in one batch, every source is compared with its own BFS
+TEST_F(RuntimeLibTest, MultiSourceBFSBatchesTest){
+    Graph g = builtin_loadEdgesFromFile("../../test/graphs/rmat10.el");
+    VertexSubset<NodeID>* sources = new VertexSubset<NodeID>(g.num_nodes(), 0);
+    for (NodeID s = 0; s < 100; s++)
+        sources->addVertex(s * 7 % g.num_nodes());
+    int* sums = new int[g.num_nodes()];
+    multiSourceBFSDistanceSums(g, sources, sums);
+
+    for (NodeID i = 0; i < 100; i++) {
+        NodeID s = i * 7 % g.num_nodes();
+        std::vector<int> depth(g.num_nodes(), -1);
+        std::queue<NodeID> queue;
+        depth[s] = 0;
+        queue.push(s);
+        int expected_sum = 0;
+        while (!queue.empty()) {
+            NodeID u = queue.front();
+            queue.pop();
+            expected_sum += depth[u];
+            for (NodeID v : g.out_neigh(u)) {
+                if (depth[v] == -1) {
+                    depth[v] = depth[u] + 1;
+                    queue.push(v);
+                }
+            }
+        }
+        EXPECT_EQ(expected_sum, sums[s]);
+    }
+    delete sources;
+    delete[] sums;
+}
+
+TEST_F(RuntimeLibTest, MultiSourceSSSPTest){
+    WGraph g = builtin_loadWeightedEdgesFromFile("../../test/graphs/4.wel");
+    std::vector<NodeID> sources;
+    for (NodeID s = 0; s < g.num_nodes(); s++)
+        sources.push_back(s);
+    WeightT* dist = new WeightT[g.num_nodes() * sources.size()];
+    MultiSourceSSSP(g, sources.data(), sources.size(), dist);
+
+    for (NodeID s : sources) {
+        pvector<WeightT> dist_from_s(g.num_nodes());
+        for (NodeID v = 0; v < g.num_nodes(); v++)
+            dist_from_s[v] = dist[v * sources.size() + s];
+        EXPECT_EQ(SSSPVerifier(g, s, dist_from_s), true);
+    }
+    delete[] dist;
+}
+
+
+// the ALT bound can never exceed the distance, and a saved table gives the same bounds once loaded
+TEST_F(RuntimeLibTest, LandmarkLowerBoundTest){
+    WGraph g = builtin_loadWeightedEdgesFromFile("../../test/graphs/4.wel");
+    LandmarkTable landmarks;
+    landmarks.build(g, 3);
+    EXPECT_EQ(3, landmarks.num_landmarks());
+
+    std::vector<NodeID> sources;
+    for (NodeID s = 0; s < g.num_nodes(); s++)
+        sources.push_back(s);
+    WeightT* dist = new WeightT[g.num_nodes() * sources.size()];
+    MultiSourceSSSP(g, sources.data(), sources.size(), dist);
+
+    const char* file_name = "landmark_lower_bound_test.alt";
+    EXPECT_EQ(true, landmarks.save(file_name));
+    LandmarkTable loaded;
+    EXPECT_EQ(true, loaded.load(g, file_name));
+    EXPECT_EQ(landmarks.landmarks(), loaded.landmarks());
+    for (NodeID s : sources) {
+        for (NodeID t = 0; t < g.num_nodes(); t++) {
+            WeightT d = dist[t * sources.size() + s];
+            if (d != kDistInf) {
+                EXPECT_LE(landmarks.lower_bound(s, t), d);
+            }
+            EXPECT_EQ(landmarks.lower_bound(s, t), loaded.lower_bound(s, t));
+        }
+    }
+    // the landmarks of a graph with another number of nodes are rejected
+    WGraph other = builtin_loadWeightedEdgesFromFile("../../test/graphs/test.wel");
+    EXPECT_EQ(false, loaded.load(other, file_name));
+    EXPECT_EQ(0, loaded.num_landmarks());
+    std::remove(file_name);
+    delete[] dist;
+}
+
+
+TEST_F(RuntimeLibTest, TouchedVerticesResetTest){
+    int values[100];
+    TouchedVertices touched(100, 0.05);
+    std::fill(values, values + 100, 0);
+    for (NodeID v : {3, 7, 3}) {
+        values[v] = 1;
+        touched.touch(v);
+    }
+    EXPECT_EQ(2, touched.size());
+    EXPECT_EQ(false, touched.dense());
+    touched.reset(values, 0);
+    touched.clear();
+    EXPECT_EQ(0, std::count(values, values + 100, 1));
+    EXPECT_EQ(false, touched.touched(3));
+
+    // past 5 touched vertices the whole array is reset
+    for (NodeID v = 0; v < 10; v++) {
+        values[v] = 1;
+        touched.touch(v);
+    }
+    EXPECT_EQ(true, touched.dense());
+    touched.reset(values, 0);
+    touched.clear();
+    EXPECT_EQ(0, std::count(values, values + 100, 1));
+    EXPECT_EQ(0, touched.size());
+}
+
+// a set that starts with every vertex touched resets all of them once, then only the touched ones
+TEST_F(RuntimeLibTest, TouchedVerticesAllTouchedTest){
+    int values[100];
+    TouchedVertices touched(100, 0.05, true);
+    std::fill(values, values + 100, 1);
+    EXPECT_EQ(false, touched.touch(3));
+    EXPECT_EQ(true, touched.dense());
+    touched.reset(values, 0);
+    touched.clear();
+    EXPECT_EQ(0, std::count(values, values + 100, 1));
+
+    EXPECT_EQ(true, touched.touch(3));
+    EXPECT_EQ(false, touched.dense());
+    int visited = 0;
+    touched.for_each([&](NodeID) { visited++; });
+    EXPECT_EQ(1, visited);
+}
+
+// the engine only resets what the previous query touched, so every query depends on the previous ones
+TEST_F(RuntimeLibTest, ShortestPathQueryEngineTest){
+    WGraph g = builtin_loadWeightedEdgesFromFile("../../test/graphs/4.wel");
+    ShortestPathQueryEngine<WGraph> engine(g, 2);
+    for (NodeID source = 0; source < g.num_nodes(); source++) {
+        for (NodeID dest = 0; dest < g.num_nodes(); dest++) {
+            pvector<WeightT> dist(g.num_nodes(), kDistInf);
+            WeightT d = engine.query(source, dest);
+            dist[dest] = (d == std::numeric_limits<WeightT>::max()) ? kDistInf : d;
+            EXPECT_EQ(PPSPVerifier(g, source, dest, dist), true);
+        }
+        const WeightT* sssp_dist = engine.query(source);
+        pvector<WeightT> dist(g.num_nodes());
+        for (NodeID v = 0; v < g.num_nodes(); v++)
+            dist[v] = sssp_dist[v];
+        EXPECT_EQ(SSSPVerifier(g, source, dist), true);
+    }
+
+    std::vector<std::pair<NodeID, NodeID> > queries = {{0, 4}, {2, 1}, {4, 4}};
+    std::vector<WeightT> answers;
+    engine.query_batch(queries, answers);
+    EXPECT_EQ(3, answers.size());
+    EXPECT_EQ(0, answers[2]);
+
+    std::istringstream in("0 4\n0 4\nnot a query\n");
+    std::ostringstream out;
+    engine.serve(in, out);
+    EXPECT_EQ("8\n8\nerror\n", out.str());
+}
+
+
 TEST_F(RuntimeLibTest, AStar_load_graph){
     WGraph g = builtin_loadWeightedEdgesFromFile("../../test/graphs/monaco.bin");
     WeightT* dist_array = new WeightT[g.num_nodes()];
@@ -381,6 +836,213 @@ TEST_F(RuntimeLibTest, AStar_load_graph){
 
 }
 
+// pops all the buckets of a priority queue with the bucketing structure B, checks that the buckets come in order
+// and that each identifier is returned once, from the bucket of its priority
+template <class B>
+void checkBucketOrder(julienne::bucket_order order, size_t num_buckets) {
+    const size_t n = 5000;
+    julienne::uintE* priority = new julienne::uintE[n];
+    for (size_t i = 0; i < n; i++) {
+        // a few ids without a bucket, the rest spread over sparse priorities
+        priority[i] = (i % 10 == 0) ? UINT_E_MAX : (julienne::uintE) ((i * 7919) % 100003);
+    }
+    auto pq = new julienne::PriorityQueue<julienne::uintE, B>(n, priority, order,
+                                                              julienne::strictly_decreasing, num_buckets);
+    std::vector<int> seen(n, 0);
+    size_t num_popped = 0;
+    julienne::uintE prev = (order == julienne::increasing) ? 0 : UINT_E_MAX;
+    while (true) {
+        auto bkt = pq->next_bucket();
+        if (pq->finished()) break;
+        if (order == julienne::increasing) {
+            EXPECT_LE(prev, bkt.id);
+        } else {
+            EXPECT_GE(prev, bkt.id);
+        }
+        prev = bkt.id;
+        for (long i = 0; i < bkt.identifiers.size(); i++) {
+            julienne::uintE v = bkt.identifiers.vtx(i);
+            EXPECT_EQ(priority[v], bkt.id);
+            seen[v]++;
+            num_popped++;
+        }
+        bkt.identifiers.del();
+    }
+    EXPECT_EQ(n - n/10, num_popped);
+    for (size_t i = 0; i < n; i++) {
+        EXPECT_EQ((i % 10 == 0) ? 0 : 1, seen[i]);
+    }
+    delete pq;
+    delete[] priority;
+}
+
+// max core number of the graph, with the bucketing structure B
+template <class B>
+julienne::uintE kCoreMaxCore(julienne::graph<julienne::symmetricVertex>& GA) {
+    const size_t n = GA.n;
+    julienne::uintE* updated_degree = new julienne::uintE[n];
+    parallel_for(size_t i = 0; i < n; i++) updated_degree[i] = GA.V[i].getOutDegree();
+    auto pq = new julienne::PriorityQueue<julienne::uintE, B>(n, updated_degree, julienne::increasing,
+                                                              julienne::strictly_decreasing, 16);
+    auto apply_function = [&] (const tuple<julienne::uintE, julienne::uintE>& p) {
+        julienne::uintE v = std::get<0>(p), edgesRemoved = std::get<1>(p);
+        julienne::uintE deg = updated_degree[v];
+        julienne::uintE k = pq->get_current_priority();
+        if (deg > k) {
+            julienne::uintE new_deg = std::max(deg - edgesRemoved, k);
+            updated_degree[v] = new_deg;
+            julienne::uintE bkt = pq->get_bucket_no_overflow_insertion(new_deg);
+            return julienne::wrap(v, bkt);
+        }
+        return julienne::Maybe<std::tuple<julienne::uintE, julienne::uintE> >();
+    };
+    auto em = julienne::EdgeMap<julienne::uintE, julienne::symmetricVertex>(GA, std::make_tuple(UINT_E_MAX, 0), (size_t)GA.m/5);
+    size_t finished = 0;
+    while (finished != n) {
+        auto active = pq->next_bucket().identifiers;
+        finished += active.size();
+        julienne::vertexSubsetData<julienne::uintE> moved = em.edgeMapCount<julienne::uintE>(active, apply_function);
+        pq->update_buckets(moved.get_fn_repr(), moved.size());
+        moved.del();
+        active.del();
+    }
+    delete pq;
+    julienne::uintE mc = 0;
+    for (size_t i = 0; i < n; i++) {
+        mc = std::max(mc, updated_degree[i]);
+    }
+    delete[] updated_degree;
+    return mc;
+}
+
+TEST_F(RuntimeLibTest, RadixHeapBucketsOrderTest){
+    checkBucketOrder<julienne::radix_heap_buckets<julienne::uintE> >(julienne::increasing, 128);
+    checkBucketOrder<julienne::radix_heap_buckets<julienne::uintE> >(julienne::decreasing, 128);
+}
+
+TEST_F(RuntimeLibTest, TwoLevelBucketsOrderTest){
+    checkBucketOrder<julienne::two_level_buckets<julienne::uintE> >(julienne::increasing, 16);
+    checkBucketOrder<julienne::two_level_buckets<julienne::uintE> >(julienne::decreasing, 16);
+}
+
+// pops all the buckets of an approximate priority queue, checks that the buckets come in order and that each
+// identifier is returned once, from the geometric bucket of its priority
+void checkApproximateBucketOrder(julienne::bucket_order order, double eps) {
+    const size_t n = 5000;
+    julienne::uintE* priority = new julienne::uintE[n];
+    for (size_t i = 0; i < n; i++) {
+        priority[i] = (i % 10 == 0) ? UINT_E_MAX : (julienne::uintE) ((i * 7919) % 100003);
+    }
+    auto pq = new julienne::PriorityQueue<julienne::uintE>(n, priority, order, julienne::strictly_decreasing, 16, 1, eps);
+    std::vector<int> seen(n, 0);
+    size_t num_popped = 0;
+    size_t num_buckets = 0;
+    julienne::uintE prev = (order == julienne::increasing) ? 0 : UINT_E_MAX;
+    while (true) {
+        auto bkt = pq->next_bucket();
+        if (pq->finished()) break;
+        num_buckets++;
+        // the id is the smallest priority of the bucket
+        if (order == julienne::increasing) {
+            EXPECT_LT(prev, bkt.id);
+        } else {
+            EXPECT_GT(prev, bkt.id);
+        }
+        prev = bkt.id;
+        for (long i = 0; i < bkt.identifiers.size(); i++) {
+            julienne::uintE v = bkt.identifiers.vtx(i);
+            EXPECT_LE(bkt.id, priority[v]);
+            EXPECT_LT(priority[v], (bkt.id + 1) * (1 + eps));
+            seen[v]++;
+            num_popped++;
+        }
+        bkt.identifiers.del();
+    }
+    EXPECT_EQ(n - n/10, num_popped);
+    // log_1.1(100003) buckets instead of one per priority
+    EXPECT_GT(130, num_buckets);
+    for (size_t i = 0; i < n; i++) {
+        EXPECT_EQ((i % 10 == 0) ? 0 : 1, seen[i]);
+    }
+    delete pq;
+    delete[] priority;
+}
+
+TEST_F(RuntimeLibTest, ApproximateBucketsOrderTest){
+    checkApproximateBucketOrder(julienne::increasing, 0.1);
+    checkApproximateBucketOrder(julienne::decreasing, 0.1);
+}
+
+TEST_F(RuntimeLibTest, ApproximateBucketsLazyTest){
+    const size_t n = 1000;
+    julienne::uintE* priority = new julienne::uintE[n];
+    for (size_t i = 0; i < n; i++) priority[i] = 1000;
+    auto pq = new julienne::PriorityQueue<julienne::uintE>(n, priority, julienne::decreasing,
+                                                           julienne::strictly_decreasing, 16, 1, 0.1);
+    // lowers half of the priorities without moving the identifiers, they are re-bucketed when bucket 1000 is popped
+    for (size_t i = 0; i < n; i += 2) priority[i] = 10 + i;
+    std::vector<int> seen(n, 0);
+    julienne::uintE prev = UINT_E_MAX;
+    while (true) {
+        auto bkt = pq->next_bucket();
+        if (pq->finished()) break;
+        EXPECT_GT(prev, bkt.id);
+        prev = bkt.id;
+        for (long i = 0; i < bkt.identifiers.size(); i++) {
+            julienne::uintE v = bkt.identifiers.vtx(i);
+            EXPECT_EQ(pq->buckets_->priority_to_bucket(bkt.id), pq->buckets_->priority_to_bucket(priority[v]));
+            seen[v]++;
+        }
+        bkt.identifiers.del();
+    }
+    for (size_t i = 0; i < n; i++) {
+        EXPECT_EQ(1, seen[i]);
+    }
+    delete pq;
+    delete[] priority;
+}
+
+TEST_F(RuntimeLibTest, ApproximateBucketsLazyAndMovedTest){
+    const size_t n = 1000;
+    julienne::uintE* priority = new julienne::uintE[n];
+    for (size_t i = 0; i < n; i++) priority[i] = 1000;
+    auto pq = new julienne::PriorityQueue<julienne::uintE>(n, priority, julienne::decreasing,
+                                                           julienne::strictly_decreasing, 16, 1, 0.1);
+    // lowers all the priorities, the even ids are moved by the caller and the odd ids are left to the lazy
+    // re-bucketing, the stale entries of the moved ids in bucket 1000 must not be re-bucketed again
+    for (size_t i = 0; i < n; i++) priority[i] = 10 + i;
+    auto move_even = [&] (size_t i) -> julienne::Maybe<std::tuple<julienne::uintE, julienne::uintE> > {
+        julienne::uintE v = 2 * i;
+        return julienne::Maybe<std::tuple<julienne::uintE, julienne::uintE> >(
+                std::make_tuple(v, pq->get_bucket_no_overflow_insertion(priority[v])));
+    };
+    pq->update_buckets(move_even, n / 2);
+    std::vector<int> seen(n, 0);
+    while (true) {
+        auto bkt = pq->next_bucket();
+        if (pq->finished()) break;
+        for (long i = 0; i < bkt.identifiers.size(); i++) {
+            julienne::uintE v = bkt.identifiers.vtx(i);
+            EXPECT_EQ(pq->buckets_->priority_to_bucket(bkt.id), pq->buckets_->priority_to_bucket(priority[v]));
+            seen[v]++;
+        }
+        bkt.identifiers.del();
+    }
+    for (size_t i = 0; i < n; i++) {
+        EXPECT_EQ(1, seen[i]);
+    }
+    delete pq;
+    delete[] priority;
+}
+
+TEST_F(RuntimeLibTest, KCoreBucketBackendsTest){
+    char iFile[] = "../../test/graphs/rMatGraph_J_5_100";
+    julienne::graph<julienne::symmetricVertex> G = julienne::readGraph<julienne::symmetricVertex>(iFile, false, true, false, false);
+    EXPECT_EQ(4, kCoreMaxCore<julienne::radix_heap_buckets<julienne::uintE> >(G));
+    EXPECT_EQ(4, kCoreMaxCore<julienne::two_level_buckets<julienne::uintE> >(G));
+    G.del();
+}
+
 // test compilation of the C++ version of KCore using buffered priority queue
 TEST_F(RuntimeLibTest, KCore_test){
     char iFile[] = "../../test/graphs/rMatGraph_J_5_100";
@@ -440,6 +1102,69 @@ TEST_F(RuntimeLibTest, KCore_test){
 
 
 
+// core numbers with the constant sum ordered processing operator on the GAPBS graph
+static std::vector<int> kCoreConstSum(Graph& g, int bin_size_threshold) {
+    std::vector<int> degree(g.num_nodes());
+    for (NodeID v = 0; v < g.num_nodes(); v++) degree[v] = g.out_degree(v);
+    EagerPriorityQueue<int> pq(degree.data());
+    size_t finished = 0;
+    auto priority_func = [&](NodeID v, int count)->int {
+        int k = pq.get_current_priority();
+        return std::max(degree[v] - count, k);
+    };
+    OrderedProcessingOperatorConstSum(&pq, g, [&]()->bool{ return finished != (size_t) g.num_nodes(); },
+                                      priority_func, [&](size_t frontier_size){ finished += frontier_size; },
+                                      bin_size_threshold);
+    EXPECT_EQ(g.num_nodes(), finished);
+    return degree;
+}
+
+// serial peeling, removes a node of the smallest remaining degree at a time
+static std::vector<int> kCoreSerial(Graph& g) {
+    std::vector<int> degree(g.num_nodes());
+    std::vector<bool> removed(g.num_nodes(), false);
+    std::vector<int> core(g.num_nodes());
+    std::set<std::pair<int, NodeID> > queue;
+    for (NodeID v = 0; v < g.num_nodes(); v++) {
+        degree[v] = g.out_degree(v);
+        queue.insert(std::make_pair(degree[v], v));
+    }
+    int k = 0;
+    while (!queue.empty()) {
+        NodeID u = queue.begin()->second;
+        k = std::max(k, queue.begin()->first);
+        queue.erase(queue.begin());
+        removed[u] = true;
+        core[u] = k;
+        for (NodeID v : g.out_neigh(u)) {
+            if (removed[v]) continue;
+            queue.erase(std::make_pair(degree[v], v));
+            degree[v]--;
+            queue.insert(std::make_pair(degree[v], v));
+        }
+    }
+    return core;
+}
+
+TEST_F(RuntimeLibTest, KCoreConstSumOrderedProcessingTest){
+    Graph g = builtin_loadEdgesFromFile("../../test/graphs/rMatGraph_J_5_100.el");
+    std::vector<int> expected = kCoreSerial(g);
+    // 0 only uses the histogram steps, 1000 finishes the small bins in one thread
+    for (int bin_size_threshold : {0, 1000}) {
+        std::vector<int> core = kCoreConstSum(g, bin_size_threshold);
+        EXPECT_EQ(expected, core);
+        EXPECT_EQ(4, *std::max_element(core.begin(), core.end()));
+    }
+}
+
+TEST_F(RuntimeLibTest, KCoreConstSumOrderedProcessingRmatTest){
+    Graph g = builtin_loadEdgesFromFile("../../test/graphs/rmat10.el");
+    std::vector<int> expected = kCoreSerial(g);
+    std::vector<int> core = kCoreConstSum(g, 16);
+    EXPECT_EQ(expected, core);
+    EXPECT_EQ(38, *std::max_element(core.begin(), core.end()));
+}
+
 TEST_F(RuntimeLibTest, SetCover_test) {
     char iFile[] = "../../test/graphs/rMatGraph_J_5_100";
     bool symmetric = true;
@@ -1002,6 +1727,184 @@ TEST_F(RuntimeLibTest, GetRandomInNeighborTest) {
 
 }
 
+TEST_F(RuntimeLibTest, CounterRNGTest) {
+    CounterRNG rng(42);
+    EXPECT_EQ (rng(3, 7) , CounterRNG(42)(3, 7));
+    EXPECT_NE (rng(3, 7) , rng(4, 7));
+    EXPECT_NE (rng(3, 7) , rng(3, 8));
+    EXPECT_NE (rng(3, 7) , CounterRNG(43)(3, 7));
+    for (uint64_t c = 0; c < 1000; c++) {
+        EXPECT_LT (CounterRNG::Bounded(rng(0, c), 10) , 10);
+        EXPECT_LT (CounterRNG::Unit(rng(0, c)) , 1.0f);
+    }
+}
+
+TEST_F(RuntimeLibTest, RandomNeighborSeedTest) {
+    Graph g = builtin_loadEdgesFromFile("../../test/graphs/test.el");
+    std::vector<NodeID> first, second;
+    SetGlobalRandomSeed(5);
+    for (int i = 0; i < 20; i++) first.push_back(g.get_random_out_neigh(1));
+    SetGlobalRandomSeed(5);
+    for (int i = 0; i < 20; i++) second.push_back(g.get_random_out_neigh(1));
+    EXPECT_EQ (first , second);
+    SetGlobalRandomSeed(0);
+}
+
+TEST_F(RuntimeLibTest, RandomWalkEngineTest) {
+    Graph g = builtin_loadEdgesFromFile("../../test/graphs/test.el");
+    const int num_walkers = 100, length = 6;
+    std::vector<NodeID> starts(num_walkers, 1);
+    std::vector<NodeID> walks(num_walkers * (length + 1)), again(num_walkers * (length + 1));
+    RandomWalkEngine<Graph> engine(g, 11);
+    engine.walk(starts.data(), num_walkers, length, walks.data());
+    engine.walk(starts.data(), num_walkers, length, again.data());
+    EXPECT_EQ (walks , again);
+    for (int w = 0; w < num_walkers; w++) {
+        EXPECT_EQ (walks[w * (length + 1)] , 1);
+        for (int s = 1; s <= length; s++) {
+            NodeID u = walks[w * (length + 1) + s - 1], v = walks[w * (length + 1) + s];
+            if (u < 0 || g.out_degree(u) == 0) {
+                // the walk stopped
+                EXPECT_EQ (v , -1);
+                continue;
+            }
+            bool is_edge = false;
+            for (NodeID ngh : g.out_neigh(u)) is_edge |= ngh == v;
+            EXPECT_TRUE (is_edge);
+        }
+    }
+}
+
+TEST_F(RuntimeLibTest, WeightedRandomWalkTest) {
+    WGraph g = builtin_loadWeightedEdgesFromFile("../../test/graphs/test.wel");
+    // vertex 1 has edges to 2, 3 and 4 with weights 3, 4 and 5
+    const int num_walkers = 120000;
+    std::vector<NodeID> starts(num_walkers, 1);
+    std::vector<NodeID> walks(num_walkers * 2);
+    RandomWalkEngine<WGraph> engine(g, 3);
+    engine.walk(starts.data(), num_walkers, 1, walks.data());
+    std::vector<int> counts(5, 0);
+    for (int w = 0; w < num_walkers; w++) counts[walks[w * 2 + 1]]++;
+    EXPECT_EQ (counts[2] + counts[3] + counts[4] , num_walkers);
+    EXPECT_NEAR (counts[2] , 30000, 1000);
+    EXPECT_NEAR (counts[3] , 40000, 1000);
+    EXPECT_NEAR (counts[4] , 50000, 1000);
+}
+
+TEST_F(RuntimeLibTest, OrientByDegreeTest) {
+    Graph g = builtin_loadEdgesFromFile("../../test/graphs/4_sym.el");
+    Graph dag = builtin_orient(g, "degree");
+    EXPECT_TRUE (dag.directed());
+    // the file holds both directions of every edge
+    EXPECT_EQ (2 * dag.num_edges() , g.num_edges());
+    int64_t triangles = 0, oriented_triangles = 0;
+    for (NodeID u = 0; u < g.num_nodes(); u++) {
+        for (NodeID v : g.out_neigh(u)) {
+            // every edge is kept in exactly one direction, towards the higher degree
+            int forward = 0, backward = 0;
+            for (NodeID w : dag.out_neigh(u)) forward += w == v;
+            for (NodeID w : dag.out_neigh(v)) backward += w == u;
+            EXPECT_EQ (forward + backward , 1);
+            if (forward == 1) {
+                EXPECT_LE (g.out_degree(u) , g.out_degree(v));
+            }
+            if (v < u)
+                triangles += intersectSortedNodeSetNaive(g.out_neigh(u).begin(), g.out_neigh(v).begin(),
+                                                         g.out_degree(u), g.out_degree(v), v);
+        }
+        for (NodeID v : dag.out_neigh(u)) {
+            oriented_triangles += intersectSortedNodeSetNaive(dag.out_neigh(u).begin(), dag.out_neigh(v).begin(),
+                                                              dag.out_degree(u), dag.out_degree(v));
+            // the inverse holds the same edges
+            int in_edge = 0;
+            for (NodeID w : dag.in_neigh(v)) in_edge += w == u;
+            EXPECT_EQ (in_edge , 1);
+        }
+    }
+    EXPECT_EQ (oriented_triangles , triangles);
+}
+
+TEST_F(RuntimeLibTest, SIMDIntersectionTest) {
+    std::mt19937 rng(1);
+    for (int trial = 0; trial < 2000; trial++) {
+        int range = 1 + rng() % 600;
+        std::vector<NodeID> A, B;
+        for (int i = 0; i < (int) (rng() % 200); i++) A.push_back(rng() % range);
+        for (int i = 0; i < (int) (rng() % 200); i++) B.push_back(rng() % range);
+        for (std::vector<NodeID>* set : {&A, &B}) {
+            std::sort(set->begin(), set->end());
+            set->erase(std::unique(set->begin(), set->end()), set->end());
+        }
+        NodeID dest = trial % 3 == 0 ? (NodeID) INT32_MAX : (NodeID) (rng() % range);
+        size_t expected = intersectSortedNodeSetNaive(A.data(), B.data(), A.size(), B.size(), dest);
+        EXPECT_EQ (expected, intersectSortedNodeSetSIMD(A.data(), B.data(), A.size(), B.size(), dest));
+#if defined(GRAPHIT_X86_INTERSECTIONS)
+        // each kernel that the machine can run
+        if (__builtin_cpu_supports("avx2")) {
+            EXPECT_EQ (expected, intersectSortedNodeSetAVX2(A.data(), B.data(), A.size(), B.size(), dest));
+        }
+        if (__builtin_cpu_supports("avx512f")) {
+            EXPECT_EQ (expected, intersectSortedNodeSetAVX512(A.data(), B.data(), A.size(), B.size(), dest));
+        }
+#endif
+    }
+}
+
+TEST_F(RuntimeLibTest, NeighborViewIntersectionTest) {
+    Graph g = builtin_loadEdgesFromFile("../../test/graphs/4_sym.el");
+    for (NodeID u = 0; u < g.num_nodes(); u++) {
+        for (NodeID v : g.out_neigh(u)) {
+            NeighborView u_view = builtin_getNghView(g, u);
+            NeighborView v_view = builtin_getNghView(g, v);
+            EXPECT_EQ (u_view.size , g.out_degree(u));
+            VertexSubset<NodeID>* v_set = builtin_getNgh(g, v);
+            EXPECT_EQ (hiroshiVertexIntersection(u_view, v_view, u_view.size, v_view.size, v),
+                       hiroshiVertexIntersection(u_view, v_set, u_view.size, v_view.size, v));
+            EXPECT_EQ (naiveVertexIntersection(u_view, v_view, u_view.size, v_view.size, v),
+                       hiroshiVertexIntersection(u_view, v_view, u_view.size, v_view.size, v));
+        }
+    }
+}
+
+TEST_F(RuntimeLibTest, HubBitmapIntersectionTest) {
+    Graph g = builtin_loadEdgesFromFile("../../test/graphs/4_sym.el");
+    int64_t bitmap_bytes = (g.num_nodes() + 63) / 64 * sizeof(uint64_t);
+    // the bitmap lookup of every vertex is part of the budget
+    int64_t lookup_bytes = g.num_nodes() * sizeof(const Bitmap*);
+    g.SetUpHubBitmaps(lookup_bytes + 3 * bitmap_bytes);
+    HubBitmaps<NodeID>* hubs = g.get_hub_bitmaps_();
+    EXPECT_EQ (3, hubs->numHubs);
+    int64_t num_hubs = 0;
+    for (NodeID u = 0; u < g.num_nodes(); u++) {
+        if (hubs->bitmap(u) == nullptr)
+            continue;
+        num_hubs++;
+        // nothing outside of the hubs has a higher degree
+        for (NodeID v = 0; v < g.num_nodes(); v++) {
+            if (hubs->bitmap(v) == nullptr) {
+                EXPECT_LE (g.out_degree(v), g.out_degree(u));
+            }
+        }
+    }
+    EXPECT_EQ (3, num_hubs);
+
+    size_t hub_intersections = 0;
+    for (NodeID u = 0; u < g.num_nodes(); u++) {
+        for (NodeID v : g.out_neigh(u)) {
+            NeighborView u_view = builtin_getNghView(g, u);
+            NeighborView v_view = builtin_getNghView(g, v);
+            EXPECT_EQ (u_view.hub, hubs->bitmap(u));
+            if (u_view.hub != nullptr || v_view.hub != nullptr)
+                hub_intersections++;
+            EXPECT_EQ (naiveVertexIntersection(u_view, v_view, u_view.size, v_view.size),
+                       hubBitmapVertexIntersection(u_view, v_view, u_view.size, v_view.size));
+            EXPECT_EQ (naiveVertexIntersection(u_view, v_view, u_view.size, v_view.size, v),
+                       hubBitmapVertexIntersection(u_view, v_view, u_view.size, v_view.size, v, 2, 0.5));
+        }
+    }
+    EXPECT_GT (hub_intersections, 0);
+}
+
 TEST_F(RuntimeLibTest, SweepCutTest) {
     Graph g = builtin_loadEdgesFromFile("../../test/graphs/test.el");
     auto vertexSubset = new VertexSubset<int>(g.num_nodes(), g.num_nodes());
@@ -1018,6 +1921,39 @@ TEST_F(RuntimeLibTest, SweepCutTest) {
     EXPECT_EQ (vset_cut->size() , 2);
 }
 
+TEST_F(RuntimeLibTest, ParallelSweepCutTest) {
+    Graph g = builtin_loadEdgesFromFile("../../test/graphs/test.el");
+    auto vertexSubset = new VertexSubset<int>(g.num_nodes(), g.num_nodes());
+    double * val_array = new double[g.num_nodes()];
+    for (int i = 0; i < g.num_nodes(); i++){
+        val_array[i] = i;
+    }
+    VertexSubset<int>* vset_cut = parallelSweepCut(g, vertexSubset, val_array);
+
+    EXPECT_EQ (vset_cut->size() , 2);
+    // the cut is the prefix of the vertices sorted by decreasing value
+    EXPECT_EQ (vset_cut->dense_vertex_set_[0] , g.num_nodes() - 1);
+    EXPECT_EQ (vset_cut->dense_vertex_set_[1] , g.num_nodes() - 2);
+}
+
+TEST_F(RuntimeLibTest, ParallelSweepCutMatchesSerialTest) {
+    Graph g = builtin_loadEdgesFromFile("../../test/graphs/rmat10.el");
+    auto vertexSubset = new VertexSubset<int>(g.num_nodes(), g.num_nodes());
+    auto serialVertexSubset = new VertexSubset<int>(g.num_nodes(), g.num_nodes());
+    double * val_array = new double[g.num_nodes()];
+    for (int i = 0; i < g.num_nodes(); i++){
+        // distinct values, so that the order is the same in both versions
+        val_array[i] = (i * 389) % g.num_nodes();
+    }
+    VertexSubset<int>* parallel_cut = parallelSweepCut(g, vertexSubset, val_array);
+    VertexSubset<int>* serial_cut = serialSweepCut(g, serialVertexSubset, val_array);
+    EXPECT_EQ (parallel_cut->size() , serial_cut->size());
+    // serialSweepCut sorts its input set in place
+    for (int i = 0; i < parallel_cut->size(); i++){
+        EXPECT_EQ (parallel_cut->dense_vertex_set_[i] , serialVertexSubset->dense_vertex_set_[i]);
+    }
+}
+
 
 TEST_F(RuntimeLibTest, UpdateAndGetGraphItVertexSubsetFromJulienneBucketsTest){
 
@@ -216,6 +216,59 @@ class TestGraphitCompiler(unittest.TestCase):
     def test_astar_distance_loader(self):
         self.expect_output_val("astar_distance_loader.gt", 203845, [self.root_test_input_dir + "astar_distance_loader.cpp"], [GRAPHIT_SOURCE_DIRECTORY + "/test/graphs/monaco.bin"])
 
+    def test_bidirectional_ppsp(self):
+        self.expect_output_val("bidirectional_ppsp.gt", 8, [], [GRAPHIT_SOURCE_DIRECTORY + "/test/graphs/4.wel", "0", "4"])
+
+    def test_bidirectional_ppsp_directed(self):
+        # 3 -> 4 -> 2, there is no edge from 2 back to 3
+        self.expect_output_val("bidirectional_ppsp.gt", 3, [], [GRAPHIT_SOURCE_DIRECTORY + "/test/graphs/test.wel", "3", "2"])
+
+    def test_multi_source_closeness_unweighted(self):
+        # 100 sources take two batches
+        self.expect_output_val("multi_source_closeness_unweighted.gt", 206003, [], [GRAPHIT_SOURCE_DIRECTORY + "/test/graphs/rmat10.el", "100"])
+
+    def test_multi_source_closeness_weighted(self):
+        self.expect_output_val("multi_source_closeness_weighted.gt", 5873, [], [GRAPHIT_SOURCE_DIRECTORY + "/test/graphs/4.wel", "14"])
+
+    def test_astar_landmarks(self):
+        landmark_file = "astar_landmarks_test.alt"
+        if os.path.exists(landmark_file):
+            os.remove(landmark_file)
+        # the first run builds and saves the landmarks, the second one loads them
+        for run in range(2):
+            self.expect_output_val("astar_landmarks.gt", 8, [], [GRAPHIT_SOURCE_DIRECTORY + "/test/graphs/4.wel", "0", "4", landmark_file])
+            self.assertTrue(os.path.exists(landmark_file))
+        os.remove(landmark_file)
+
+    def test_ppsp_query_server(self):
+        self.basic_compile_test("ppsp_query_server.gt")
+        proc = subprocess.Popen(["./" + self.executable_file_name, GRAPHIT_SOURCE_DIRECTORY + "/test/graphs/4.wel"],
+                                stdin=subprocess.PIPE, stdout=subprocess.PIPE)
+        output = proc.communicate(input=b"0 4\n0 2\n3 3\n0 4\n")[0].decode()
+        self.assertEqual(proc.returncode, 0)
+        self.assertEqual(output.split(), ["8", "5", "0", "8"])
+
+    def test_random_walks(self):
+        walks_file = "random_walks_test.txt"
+        corpora = []
+        # the second run with the same seed has to write the same walks
+        for run in range(2):
+            self.expect_output_val("random_walks.gt", 12, [], [GRAPHIT_SOURCE_DIRECTORY + "/test/graphs/test.el", "7", walks_file])
+            with open(walks_file) as f:
+                corpora.append(f.read())
+            os.remove(walks_file)
+        self.assertEqual(corpora[0], corpora[1])
+        edges = set()
+        with open(GRAPHIT_SOURCE_DIRECTORY + "/test/graphs/test.el") as f:
+            for line in f:
+                edges.add(tuple(line.split()))
+        walks = corpora[0].split("\n")[:-1]
+        self.assertEqual(len(walks), 12)
+        for walk in walks:
+            vertices = walk.split()
+            for i in range(1, len(vertices)):
+                self.assertTrue((vertices[i - 1], vertices[i]) in edges)
+
     def test_outdegree_sum(self):
         self.basic_compile_exec_test("outdegree_sum.gt")
 
@@ -352,9 +352,10 @@ class TestGraphitCompiler(unittest.TestCase):
         self.assertEqual(test_flag, True)
         os.chdir("bin")
 
-    def pr_verified_test(self, input_file_name, use_separate_algo_file=False, use_segment_argv=False):
+    def pr_verified_test(self, input_file_name, use_separate_algo_file=False, use_segment_argv=False,
+                         algo_file_name="pagerank_with_filename_arg.gt"):
         if use_separate_algo_file:
-            self.basic_compile_test_with_separate_algo_schedule_files("pagerank_with_filename_arg.gt", input_file_name)
+            self.basic_compile_test_with_separate_algo_schedule_files(algo_file_name, input_file_name)
         else:
             self.basic_compile_test(input_file_name)
 
@@ -474,9 +475,9 @@ class TestGraphitCompiler(unittest.TestCase):
                 break
         self.assertEqual(test_flag, True)
 
-    def tc_verified_test(self, input_file_name, use_separate_algo_file=False):
+    def tc_verified_test(self, input_file_name, use_separate_algo_file=False, algo_file_name="tc.gt"):
         if use_separate_algo_file:
-            self.basic_compile_test_with_separate_algo_schedule_files("tc.gt", input_file_name)
+            self.basic_compile_test_with_separate_algo_schedule_files(algo_file_name, input_file_name)
         else:
             self.basic_compile_test(input_file_name)
         os.chdir("..")
@@ -533,6 +534,9 @@ class TestGraphitCompiler(unittest.TestCase):
     def test_bfs_pull_edge_aware_parallel_verified(self):
         self.bfs_verified_test("bfs_pull_edge_aware_parallel.gt", True)
 
+    def test_bfs_pull_degree_bucketed_parallel_verified(self):
+        self.bfs_verified_test("bfs_pull_degree_bucketed_parallel.gt", True)
+
     def test_bfs_pull_parallel_segment_verified(self):
         self.bfs_verified_test("bfs_pull_parallel_segment.gt", True)
 
@@ -555,6 +559,9 @@ class TestGraphitCompiler(unittest.TestCase):
     def test_cc_push_parallel_cas_verified(self):
         self.cc_verified_test("cc_push_parallel_cas.gt", True)
 
+    def test_cc_edge_centric_parallel_cas_verified(self):
+        self.cc_verified_test("cc_edge_centric_parallel_cas.gt", True)
+
     def test_cc_pull_parallel_verified(self):
         self.cc_verified_test("cc_pull_parallel.gt", True)
 
@@ -583,15 +590,30 @@ class TestGraphitCompiler(unittest.TestCase):
     def test_pagerank_parallel_pull_expect(self):
         self.pr_verified_test("pagerank_pull_parallel.gt", True)
 
+    def test_pagerank_contrib_parallel_pull_fused_vertex_apply_expect(self):
+        self.pr_verified_test("pagerank_pull_parallel.gt", True, algo_file_name="pagerank_contrib_with_filename_arg.gt")
+
+    def test_pagerank_contrib_parallel_pull_load_balance_fused_vertex_apply_expect(self):
+        self.pr_verified_test("pagerank_pull_parallel_load_balance.gt", True, algo_file_name="pagerank_contrib_with_filename_arg.gt")
+
     def test_pagerank_parallel_hybrid_dense_expect(self):
         self.pr_verified_test("pagerank_hybrid_dense.gt", True)
 
     def test_pagerank_parallel_push_expect(self):
         self.pr_verified_test("pagerank_push_parallel.gt", True)
 
+    def test_pagerank_parallel_edge_centric_expect(self):
+        self.pr_verified_test("pagerank_edge_centric_parallel.gt", True)
+
     def test_pagerank_parallel_pull_load_balance_expect(self):
         self.pr_verified_test("pagerank_pull_parallel_load_balance.gt", True)
 
+    def test_pagerank_parallel_pull_degree_bucketed_expect(self):
+        self.pr_verified_test("pagerank_pull_parallel_degree_bucketed.gt", True)
+
+    def test_pagerank_contrib_parallel_pull_degree_bucketed_fused_vertex_apply_expect(self):
+        self.pr_verified_test("pagerank_pull_parallel_degree_bucketed.gt", True, algo_file_name="pagerank_contrib_with_filename_arg.gt")
+
     def test_pagerank_parallel_pull_segment_expect(self):
         self.pr_verified_test("pagerank_pull_parallel_segment.gt", True)
 
@@ -695,6 +717,12 @@ class TestGraphitCompiler(unittest.TestCase):
     def test_delta_stepping_SparsePush_delta2_schedule(self):
         self.sssp_verified_test("SparsePush_VertexParallel_Delta2.gt", True, True)
 
+    def test_delta_stepping_SparsePush_delta2_radix_heap_schedule(self):
+        self.sssp_verified_test("SparsePush_VertexParallel_Delta2_RadixHeap.gt", True, True)
+
+    def test_delta_stepping_SparsePush_delta2_two_level_buckets_schedule(self):
+        self.sssp_verified_test("SparsePush_VertexParallel_Delta2_TwoLevel.gt", True, True)
+
     def test_delta_stepping_eager_no_merge(self):
         self.sssp_verified_test("priority_update_eager_no_merge.gt", True, True);
 
@@ -704,9 +732,30 @@ class TestGraphitCompiler(unittest.TestCase):
     def test_delta_stepping_eager_with_merge(self):
         self.sssp_verified_test("priority_update_eager_with_merge.gt", True, True);
 
+    def test_delta_stepping_eager_no_merge_open_buckets(self):
+        self.sssp_verified_test("priority_update_eager_no_merge_open_buckets.gt", True, True);
+
+    def test_delta_stepping_eager_no_merge_auto_delta(self):
+        self.sssp_verified_test("priority_update_eager_no_merge_auto_delta.gt", True, True);
+
+    def test_delta_stepping_eager_with_merge_auto_delta(self):
+        self.sssp_verified_test("priority_update_eager_with_merge_auto_delta.gt", True, True);
+
+    def test_delta_stepping_SparsePush_auto_delta_schedule(self):
+        self.sssp_verified_test("SparsePush_VertexParallel_Delta_auto.gt", True, True)
+
     def test_ppsp_delta_stepping_eager_no_merge(self):
         self.ppsp_verified_test("priority_update_eager_no_merge.gt", True);
 
+    def test_ppsp_delta_stepping_eager_no_merge_auto_delta(self):
+        self.ppsp_verified_test("priority_update_eager_no_merge_auto_delta.gt", True);
+
+    def test_delta_stepping_relaxed_multiqueue(self):
+        self.sssp_verified_test("priority_update_relaxed_multiqueue.gt", True, True);
+
+    def test_ppsp_delta_stepping_relaxed_multiqueue(self):
+        self.ppsp_verified_test("priority_update_relaxed_multiqueue.gt", True);
+
     def test_ppsp_delta_stepping_SparsePush_parallel(self):
         self.ppsp_verified_test("SparsePushDensePull_VertexParallel.gt", True);
 
@@ -722,6 +771,27 @@ class TestGraphitCompiler(unittest.TestCase):
     def test_tc_naive(self):
         self.tc_verified_test("tc_naive.gt", True);
 
+    def test_tc_simd(self):
+        self.tc_verified_test("tc_simd.gt", True);
+
+    def test_tc_hub_bitmap(self):
+        self.tc_verified_test("tc_hub_bitmap.gt", True);
+
+    def test_tc_oriented_hub_bitmap(self):
+        self.tc_verified_test("tc_hub_bitmap.gt", True, "tc_oriented.gt");
+
+    def test_tc_oriented_hiroshi(self):
+        self.tc_verified_test("tc_hiroshi.gt", True, "tc_oriented.gt");
+
+    def test_tc_oriented_simd(self):
+        self.tc_verified_test("tc_simd.gt", True, "tc_oriented.gt");
+
+    def test_tc_degree_bucketed(self):
+        self.tc_verified_test("tc_degree_bucketed.gt", True);
+
+    def test_tc_oriented_degree_bucketed(self):
+        self.tc_verified_test("tc_degree_bucketed.gt", True, "tc_oriented.gt");
+
     def test_tc_empty(self):
         self.tc_verified_test("tc_empty.gt", True);
 
@@ -759,6 +829,27 @@ class TestGraphitCompiler(unittest.TestCase):
     def test_k_core_const_sum_reduce(self):
         self.expect_output_val_with_separate_schedule("k_core.gt", "k_core_const_sum_reduce.gt", 4, [], [GRAPHIT_SOURCE_DIRECTORY + "/test/graphs/rMatGraph_J_5_100"])
 
+    def test_unweighted_delta_stepping_eager_no_merge(self):
+        self.expect_output_val_with_separate_schedule("unweighted_delta_stepping.gt", "priority_update_eager_no_merge.gt", 2661, [], [GRAPHIT_SOURCE_DIRECTORY + "/test/graphs/rmat10.el"])
+
+    def test_unweighted_delta_stepping_eager_with_merge(self):
+        self.expect_output_val_with_separate_schedule("unweighted_delta_stepping.gt", "priority_update_eager_with_merge.gt", 2661, [], [GRAPHIT_SOURCE_DIRECTORY + "/test/graphs/rmat10.el"])
+
+    def test_multi_source_delta_stepping_eager_no_merge(self):
+        self.expect_output_val_with_separate_schedule("multi_source_delta_stepping.gt", "priority_update_eager_no_merge.gt", 196, [], [GRAPHIT_SOURCE_DIRECTORY + "/test/graphs/4.wel"])
+
+    def test_repeated_sssp_sparse_reset(self):
+        self.expect_output_val_with_separate_schedule("repeated_sssp_reset.gt", "priority_update_eager_no_merge_sparse_reset.gt", 5873, [], [GRAPHIT_SOURCE_DIRECTORY + "/test/graphs/4.wel"])
+
+    def test_multi_source_delta_stepping_relaxed_multiqueue(self):
+        self.expect_output_val_with_separate_schedule("multi_source_delta_stepping.gt", "priority_update_relaxed_multiqueue.gt", 196, [], [GRAPHIT_SOURCE_DIRECTORY + "/test/graphs/4.wel"])
+
+    def test_k_core_const_sum_reduce_radix_heap(self):
+        self.expect_output_val_with_separate_schedule("k_core.gt", "k_core_const_sum_reduce_radix_heap.gt", 4, [], [GRAPHIT_SOURCE_DIRECTORY + "/test/graphs/rMatGraph_J_5_100"])
+
+    def test_k_core_uint_const_sum_reduce_two_level_buckets(self):
+        self.expect_output_val_with_separate_schedule("k_core_uint.gt", "k_core_const_sum_reduce_two_level.gt", 4, [], [GRAPHIT_SOURCE_DIRECTORY + "/test/graphs/rMatGraph_J_5_100"])
+
     def test_k_core_sparsepush(self):
         self.expect_output_val_with_separate_schedule("k_core.gt", "SparsePush_VertexParallel.gt", 4, [], [GRAPHIT_SOURCE_DIRECTORY + "/test/graphs/rMatGraph_J_5_100.el"])
 
@@ -772,6 +863,15 @@ class TestGraphitCompiler(unittest.TestCase):
         self.expect_output_val_with_separate_schedule("k_core_uint.gt", "KCore_SparsePush_VertexParallel_16_Open.gt", 38, [], [GRAPHIT_SOURCE_DIRECTORY + "/test/graphs/rmat10.el"])
 
 
+    def test_k_core_eager_const_sum_reduce(self):
+        self.expect_output_val_with_separate_schedule("k_core.gt", "k_core_eager_const_sum_reduce.gt", 4, [], [GRAPHIT_SOURCE_DIRECTORY + "/test/graphs/rMatGraph_J_5_100.el"])
+
+    def test_k_core_uint_eager_const_sum_reduce_rmat10(self):
+        self.expect_output_val_with_separate_schedule("k_core_uint.gt", "k_core_eager_const_sum_reduce.gt", 38, [], [GRAPHIT_SOURCE_DIRECTORY + "/test/graphs/rmat10.el"])
+
+    def test_k_core_eager_const_sum_reduce_no_merge_rmat10(self):
+        self.expect_output_val_with_separate_schedule("k_core.gt", "k_core_eager_const_sum_reduce_no_merge.gt", 38, [], [GRAPHIT_SOURCE_DIRECTORY + "/test/graphs/rmat10.el"])
+
     def test_k_core_sparsepush_densepull(self):
         self.expect_output_val_with_separate_schedule("k_core.gt", "SparsePushDensePull_VertexParallel.gt", 4, [], [GRAPHIT_SOURCE_DIRECTORY + "/test/graphs/rMatGraph_J_5_100.el"])
 
@@ -781,6 +881,12 @@ class TestGraphitCompiler(unittest.TestCase):
     def test_set_cover(self):
         self.expect_output_val("set_cover.gt", 33, [GRAPHIT_SOURCE_DIRECTORY+"/test/input_with_schedules/set_cover_extern.cpp"], [GRAPHIT_SOURCE_DIRECTORY + "/test/graphs/rMatGraph_J_5_100"]) 
 
+    def test_set_cover_exact_buckets(self):
+        self.expect_output_val_with_separate_schedule("set_cover_degree.gt", "set_cover_exact_buckets.gt", 33, [GRAPHIT_SOURCE_DIRECTORY+"/test/input_with_schedules/set_cover_degree_extern.cpp"], [GRAPHIT_SOURCE_DIRECTORY + "/test/graphs/rMatGraph_J_5_100"])
+
+    def test_set_cover_approximate_buckets(self):
+        self.expect_output_val_with_separate_schedule("set_cover_degree.gt", "set_cover_approximate_buckets.gt", 33, [GRAPHIT_SOURCE_DIRECTORY+"/test/input_with_schedules/set_cover_degree_extern.cpp"], [GRAPHIT_SOURCE_DIRECTORY + "/test/graphs/rMatGraph_J_5_100"])
+
     def test_basic_library(self):
         self.basic_library_compile_exec_test("export_simple_edgeset_apply.gt");
 